@@ -21,3 +21,7 @@ ConfigCompilerFlags=$DebugCompilerFlags
 
 clang++ -save-temps=obj -DPLATFORM_CODE -o $BinOutDir/linux_pong $CommonDefines $IncludeDirs $CommonCompilerFlags $ConfigCompilerFlags src/platform/SDLLinuxPlatform.cpp $PlatformLinkerFlags
 clang++ -save-temps=obj -o $BinOutDir/pong.so $CommonDefines $IncludeDirs $CommonCompilerFlags $ConfigCompilerFlags src/GameEntry.cpp -shared  $GameLinkerFlags
+
+# Tools
+clang++ -DPLATFORM_CODE -o $BinOutDir/gl_replay $CommonDefines $IncludeDirs $CommonCompilerFlags $ReleaseCompilerFlags src/tools/GLReplay.cpp $PlatformLinkerFlags
+clang++ -DPLATFORM_CODE -o $BinOutDir/render_bench $CommonDefines $IncludeDirs $CommonCompilerFlags $ReleaseCompilerFlags src/tools/RenderBench.cpp $PlatformLinkerFlags
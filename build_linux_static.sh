@@ -0,0 +1,22 @@
+#!/bin/bash
+
+##########################################
+# Release build for linux using clang    #
+# Game is linked into the executable     #
+##########################################
+
+ObjOutDir=build/obj/
+BinOutDir=build/
+
+mkdir -p $BinOutDir
+mkdir -p $ObjOutDir
+
+CommonDefines="-Iext/SDL2-2.0.12/include -D_CRT_SECURE_NO_WARNINGS -DPLATFORM_LINUX"
+CommonCompilerFlags="-std=c++17 -ffast-math -fno-rtti -fno-exceptions -static-libgcc -static-libstdc++ -fno-strict-aliasing -Werror -Wno-switch"
+ReleaseCompilerFlags="-O2 -finline-functions -g"
+LinkerFlags="-Lbuild -lSDL2 -ldl -pthread"
+
+# NOTE: Shaders are built into the executable
+./gen_embedded_shaders.sh
+
+clang++ -save-temps=obj -DPLATFORM_CODE -o $BinOutDir/linux_pong_static $CommonDefines $CommonCompilerFlags $ReleaseCompilerFlags src/platform/SDLLinuxStatic.cpp $LinkerFlags
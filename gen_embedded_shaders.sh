@@ -0,0 +1,27 @@
+#!/bin/bash
+
+##########################################
+# Generates src/EmbeddedShaders.h        #
+# Run after editing src/shaders          #
+##########################################
+
+Output=src/EmbeddedShaders.h
+Shaders=$(ls src/shaders/*.vert | xargs -n 1 basename | sed -E "s/\.vert$//" | sort)
+
+{
+    echo "#pragma once"
+    echo ""
+    echo "// NOTE: Generated by gen_embedded_shaders.sh. Do not edit"
+    echo "// Sources of src/shaders built into the game. Used when the files can not be read"
+    echo "static const EmbeddedShader EmbeddedShaders[] = {"
+    for Shader in $Shaders; do
+        echo "    { \"$Shader\","
+        echo "R\"GLSL($(cat src/shaders/$Shader.vert)"
+        echo ")GLSL\","
+        echo "R\"GLSL($(cat src/shaders/$Shader.frag)"
+        echo ")GLSL\" },"
+    done
+    echo "};"
+} > $Output
+
+echo "$(echo $Shaders | wc -w) shaders written to $Output"
@@ -0,0 +1,26 @@
+#!/bin/bash
+
+##########################################
+# Generates src/platform/OpenGLUsed.h    #
+# Run after adding OpenGL functions      #
+##########################################
+
+Output=src/platform/OpenGLUsed.h
+
+# NOTE: Game calls OpenGL through gl_function macros in GameEntry.cpp, platform calls it through the function table
+Functions=$( (grep -ohE "^#define gl[A-Za-z0-9]+ gl_function" src/GameEntry.cpp | sed -E "s/#define (gl[A-Za-z0-9]+) .*/\1/"; \
+              grep -ohE "functions\.fn\.gl[A-Za-z0-9]+\(" src/platform/*.cpp | sed -E "s/functions\.fn\.(gl[A-Za-z0-9]+)\(/\1/") | sort -u)
+
+{
+    echo "#pragma once"
+    echo ""
+    echo "// NOTE: Generated by gen_opengl_used.sh. Do not edit"
+    echo "// OpenGL functions referenced by the code. They are resolved at startup, the rest are resolved on the first call"
+    echo "#define OPENGL_USED_FUNCTIONS(X) \\"
+    for Function in $Functions; do
+        echo "    X($Function) \\"
+    done
+    echo ""
+} > $Output
+
+echo "$(echo $Functions | wc -w) functions written to $Output"
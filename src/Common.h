@@ -6,6 +6,8 @@
 #include <float.h>
 #include <stdarg.h>
 #include <math.h>
+#include <string.h>
+#include <stddef.h>
 
 #if defined(_MSC_VER)
 #define COMPILER_MSVC
@@ -15,6 +17,21 @@
 #error Unsupported compiler
 #endif
 
+// NOTE: SIMD paths are selected at compile time. SSE2 is always available on x64,
+// AVX2 is used only if the compiler was asked to target it (-mavx2, /arch:AVX2)
+#if defined(__AVX2__)
+#define SIMD_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#define SIMD_SSE2
+#endif
+#if defined(SIMD_SSE2)
+#include <immintrin.h>
+#endif
+#if defined(COMPILER_MSVC)
+#include <intrin.h>
+#endif
+
 #if defined(PLATFORM_WINDOWS)
 #define debug_break() __debugbreak()
 #elif defined(PLATFORM_LINUX)
@@ -70,6 +87,10 @@ namespace I32 {
     constexpr i32 Min = INT32_MIN;
 }
 
+namespace U16 {
+    constexpr u32 Max = 0xffff;
+}
+
 namespace U32 {
     constexpr u32 Max = 0xffffffff;
 }
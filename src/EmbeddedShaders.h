@@ -0,0 +1,173 @@
+#pragma once
+
+// NOTE: Generated by gen_embedded_shaders.sh. Do not edit
+// Sources of src/shaders built into the game. Used when the files can not be read
+static const EmbeddedShader EmbeddedShaders[] = {
+    { "CompositeShader",
+R"GLSL(#version 330 core
+
+// NOTE: Draws a layer texture as a fullscreen triangle at the given depth. Pixels which
+// were not covered by anything in the layer are discarded
+
+out vec2 UV;
+
+uniform float Depth;
+
+void main() {
+    vec2 position = vec2(float((gl_VertexID & 1) << 2), float((gl_VertexID & 2) << 1)) - 1.0f;
+    UV = position * 0.5f + 0.5f;
+    gl_Position = vec4(position, Depth * 2.0f - 1.0f, 1.0f);
+    // View clip planes are enabled for all programs
+    gl_ClipDistance[0] = 1.0f;
+    gl_ClipDistance[1] = 1.0f;
+    gl_ClipDistance[2] = 1.0f;
+    gl_ClipDistance[3] = 1.0f;
+}
+)GLSL",
+R"GLSL(#version 330 core
+
+out vec4 FragmentColor;
+
+in vec2 UV;
+
+uniform sampler2D Layer;
+
+void main() {
+    vec4 color = texture(Layer, UV);
+    if (color.a == 0.0f) {
+        discard;
+    }
+    FragmentColor = color;
+}
+)GLSL" },
+    { "UberShader",
+R"GLSL(#version 330 core
+
+// NOTE: Uber-shader for all instanced primitives. Every instance is a quad drawn as a
+// triangle strip with 4 vertices, corners are derived from gl_VertexID
+
+// Must match Canvas::MaxViews
+#define MAX_VIEWS 8
+
+layout (location = 0) in vec4 Shape;
+layout (location = 1) in vec4 Params;
+layout (location = 2) in vec4 Color;
+layout (location = 3) in uint Kind;
+layout (location = 4) in uint ViewIndex;
+layout (location = 5) in uint Page;
+layout (location = 6) in vec4 UV;
+
+out vec4 VertexColor;
+// Sprite texture coordinates, z is the atlas page. Negative page means no texture
+out vec3 TexCoord;
+// Shape space position, half size and corner radius for the distance function
+out vec2 LocalPosition;
+flat out vec2 HalfSize;
+flat out float Radius;
+
+layout (std140) uniform FrameUniforms {
+    mat4 ViewProjections[MAX_VIEWS];
+    vec4 ViewClips[MAX_VIEWS];
+    vec2 ViewportSize;
+};
+
+const uint KindRect = 0u;
+const uint KindLine = 1u;
+const uint KindRoundedRect = 2u;
+const uint KindCapsule = 3u;
+const uint KindSprite = 4u;
+
+void main() {
+    // 0 - (0, 0), 1 - (1, 0), 2 - (0, 1), 3 - (1, 1)
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    mat4 MVP = ViewProjections[ViewIndex];
+
+    // Solid primitives are fully inside of their distance function
+    LocalPosition = vec2(0.0f);
+    HalfSize = vec2(1.0f);
+    Radius = 0.0f;
+    TexCoord = vec3(0.0f, 0.0f, -1.0f);
+
+    if (Kind == KindRoundedRect || Kind == KindCapsule) {
+        // NOTE: Quad gets one pixel of margin for anti-aliasing
+        vec2 pixel = 2.0f / (ViewportSize * vec2(length(MVP[0].xy), length(MVP[1].xy)));
+        vec2 center = (Shape.xy + Shape.zw) * 0.5f;
+        vec2 axis = vec2(1.0f, 0.0f);
+        if (Kind == KindCapsule) {
+            // Capsule is a rounded rect rotated along the segment
+            vec2 dir = Shape.zw - Shape.xy;
+            float len = length(dir);
+            axis = len > 0.0f ? dir / len : axis;
+            HalfSize = vec2(len * 0.5f + Params.z, Params.z);
+            Radius = Params.z;
+        } else {
+            HalfSize = abs(Shape.zw - Shape.xy) * 0.5f;
+            Radius = min(Params.z, min(HalfSize.x, HalfSize.y));
+        }
+        vec2 normal = vec2(-axis.y, axis.x);
+        LocalPosition = (corner * 2.0f - 1.0f) * (HalfSize + max(pixel.x, pixel.y));
+        vec2 position = center + axis * LocalPosition.x + normal * LocalPosition.y;
+        gl_Position = MVP * vec4(position, Params.x, 1.0f);
+    } else if (Kind == KindLine) {
+        // Line is extruded in screen space, so thickness is in pixels
+        vec4 begin = MVP * vec4(Shape.xy, Params.x, 1.0f);
+        vec4 end = MVP * vec4(Shape.zw, Params.y, 1.0f);
+        vec2 dir = (end.xy / end.w - begin.xy / begin.w) * ViewportSize;
+        float len = length(dir);
+        dir = len > 0.0f ? dir / len : vec2(1.0f, 0.0f);
+        vec2 normal = vec2(-dir.y, dir.x);
+        vec2 offset = normal * Params.z * (corner.y - 0.5f) * 2.0f / ViewportSize;
+        vec4 p = mix(begin, end, corner.x);
+        gl_Position = vec4(p.xy + offset * p.w, p.zw);
+    } else {
+        vec2 position = mix(Shape.xy, Shape.zw, corner);
+        gl_Position = MVP * vec4(position, Params.x, 1.0f);
+        if (Kind == KindSprite) {
+            TexCoord = vec3(mix(UV.xy, UV.zw, corner), float(Page));
+        }
+    }
+
+    // Clipping to the view rect, distances are positive inside
+    vec4 clip = ViewClips[ViewIndex];
+    gl_ClipDistance[0] = gl_Position.x - clip.x * gl_Position.w;
+    gl_ClipDistance[1] = gl_Position.y - clip.y * gl_Position.w;
+    gl_ClipDistance[2] = clip.z * gl_Position.w - gl_Position.x;
+    gl_ClipDistance[3] = clip.w * gl_Position.w - gl_Position.y;
+
+    // Only shapes and sprites are blended
+    VertexColor = vec4(Color.rgb, (Kind == KindRoundedRect || Kind == KindCapsule || Kind == KindSprite) ? Color.a : 1.0f);
+}
+)GLSL",
+R"GLSL(#version 330 core
+
+out vec4 FragmentColor;
+
+in vec4 VertexColor;
+in vec3 TexCoord;
+in vec2 LocalPosition;
+flat in vec2 HalfSize;
+flat in float Radius;
+
+uniform sampler2DArray Atlas;
+
+void main() {
+    // Signed distance to the rounded rect. Coverage is computed over one pixel around the edge
+    vec2 q = abs(LocalPosition) - HalfSize + Radius;
+    float dist = length(max(q, 0.0f)) + min(max(q.x, q.y), 0.0f) - Radius;
+    float width = max(fwidth(dist), 1e-5f);
+    float coverage = clamp(0.5f - dist / width, 0.0f, 1.0f);
+    if (coverage <= 0.0f) {
+        discard;
+    }
+    vec4 color = vec4(VertexColor.rgb, VertexColor.a * coverage);
+    if (TexCoord.z >= 0.0f) {
+        color *= texture(Atlas, TexCoord);
+        // NOTE: Transparent texels must not write depth
+        if (color.a <= 0.0f) {
+            discard;
+        }
+    }
+    FragmentColor = color;
+}
+)GLSL" },
+};
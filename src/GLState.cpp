@@ -0,0 +1,200 @@
+#include "GLState.h"
+
+// Returns bit index for capabilities which are tracked, -1 otherwise
+i32 GLStateCapBit(GLenum cap) {
+    switch (cap) {
+    case GL_DEPTH_TEST: { return 0; }
+    case GL_CULL_FACE: { return 1; }
+    case GL_BLEND: { return 2; }
+    case GL_SCISSOR_TEST: { return 3; }
+    case GL_STENCIL_TEST: { return 4; }
+    case GL_MULTISAMPLE: { return 5; }
+    case GL_FRAMEBUFFER_SRGB: { return 6; }
+    case GL_CLIP_DISTANCE0: { return 7; }
+    case GL_CLIP_DISTANCE1: { return 8; }
+    case GL_CLIP_DISTANCE2: { return 9; }
+    case GL_CLIP_DISTANCE3: { return 10; }
+    default: { return -1; }
+    }
+}
+
+void GLStateInit(GLStateCache* cache) {
+    *cache = {};
+    cache->program = GLStateCache::Unknown;
+    cache->arrayBuffer = GLStateCache::Unknown;
+    cache->uniformBuffer = GLStateCache::Unknown;
+    cache->vertexArray = GLStateCache::Unknown;
+    cache->elementArrayBuffer = GLStateCache::Unknown;
+}
+
+void GLStateBeginFrame(GLStateCache* cache) {
+    cache->callsIssued = 0;
+    cache->callsElided = 0;
+}
+
+void GLStateUseProgram(GLStateCache* cache, GLuint program) {
+    if (cache->program != program) {
+        glUseProgram(program);
+        cache->program = program;
+        cache->callsIssued++;
+    } else {
+        cache->callsElided++;
+    }
+}
+
+void GLStateBindBuffer(GLStateCache* cache, GLenum target, GLuint buffer) {
+    GLuint* binding = nullptr;
+    switch (target) {
+    case GL_ARRAY_BUFFER: { binding = &cache->arrayBuffer; } break;
+    case GL_ELEMENT_ARRAY_BUFFER: { binding = &cache->elementArrayBuffer; } break;
+    case GL_UNIFORM_BUFFER: { binding = &cache->uniformBuffer; } break;
+    default: {} break;
+    }
+
+    if (!binding || *binding != buffer) {
+        glBindBuffer(target, buffer);
+        if (binding) {
+            *binding = buffer;
+        }
+        cache->callsIssued++;
+    } else {
+        cache->callsElided++;
+    }
+}
+
+void GLStateBindBufferBase(GLStateCache* cache, GLenum target, GLuint index, GLuint buffer) {
+    // NOTE(swarzzy): Indexed bindings are not tracked, but binding to an index
+    // also binds the buffer to the generic binding point
+    glBindBufferBase(target, index, buffer);
+    if (target == GL_UNIFORM_BUFFER) {
+        cache->uniformBuffer = buffer;
+    }
+    cache->callsIssued++;
+}
+
+void GLStateBindVertexArray(GLStateCache* cache, GLuint vertexArray) {
+    if (cache->vertexArray != vertexArray) {
+        glBindVertexArray(vertexArray);
+        cache->vertexArray = vertexArray;
+        cache->elementArrayBuffer = GLStateCache::Unknown;
+        cache->knownAttribs = 0;
+        cache->knownDivisors = 0;
+        cache->enabledAttribs = 0;
+        cache->callsIssued++;
+    } else {
+        cache->callsElided++;
+    }
+}
+
+void GLStateSetCap(GLStateCache* cache, GLenum cap, b32 enabled) {
+    i32 bit = GLStateCapBit(cap);
+    if (bit != -1) {
+        u32 mask = 1u << bit;
+        if ((cache->knownCaps & mask) && (((cache->enabledCaps & mask) != 0) == (enabled != 0))) {
+            cache->callsElided++;
+            return;
+        }
+        cache->knownCaps |= mask;
+        if (enabled) {
+            cache->enabledCaps |= mask;
+        } else {
+            cache->enabledCaps &= ~mask;
+        }
+    }
+
+    if (enabled) {
+        glEnable(cap);
+    } else {
+        glDisable(cap);
+    }
+    cache->callsIssued++;
+}
+
+void GLStateEnable(GLStateCache* cache, GLenum cap) {
+    GLStateSetCap(cache, cap, true);
+}
+
+void GLStateDisable(GLStateCache* cache, GLenum cap) {
+    GLStateSetCap(cache, cap, false);
+}
+
+void GLStateEnableVertexAttribArray(GLStateCache* cache, GLuint index) {
+    assert(index < GLStateCache::MaxVertexAttribs);
+    u32 mask = 1u << index;
+    if (!(cache->enabledAttribs & mask)) {
+        glEnableVertexAttribArray(index);
+        cache->enabledAttribs |= mask;
+        cache->callsIssued++;
+    } else {
+        cache->callsElided++;
+    }
+}
+
+void GLStateDisableVertexAttribArray(GLStateCache* cache, GLuint index) {
+    assert(index < GLStateCache::MaxVertexAttribs);
+    u32 mask = 1u << index;
+    // NOTE(swarzzy): Attributes start as disabled in a fresh VAO, so only enabled ones are tracked
+    if (cache->enabledAttribs & mask) {
+        glDisableVertexAttribArray(index);
+        cache->enabledAttribs &= ~mask;
+        cache->callsIssued++;
+    } else {
+        cache->callsElided++;
+    }
+}
+
+void GLStateSetAttribFormat(GLStateCache* cache, GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer, b32 integer) {
+    assert(index < GLStateCache::MaxVertexAttribs);
+    u32 mask = 1u << index;
+    GLVertexAttribFormat* format = cache->attribFormats + index;
+    // NOTE(swarzzy): Attribute pointer captures the buffer bound to GL_ARRAY_BUFFER
+    // so it is a part of the format
+    if ((cache->knownAttribs & mask) &&
+        cache->arrayBuffer != GLStateCache::Unknown &&
+        format->buffer == cache->arrayBuffer &&
+        format->size == size &&
+        format->type == type &&
+        format->normalized == normalized &&
+        format->stride == stride &&
+        format->pointer == pointer &&
+        format->integer == integer) {
+        cache->callsElided++;
+    } else {
+        if (integer) {
+            glVertexAttribIPointer(index, size, type, stride, pointer);
+        } else {
+            glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+        }
+        format->buffer = cache->arrayBuffer;
+        format->size = size;
+        format->type = type;
+        format->normalized = normalized;
+        format->stride = stride;
+        format->pointer = pointer;
+        format->integer = integer;
+        cache->knownAttribs |= mask;
+        cache->callsIssued++;
+    }
+}
+
+void GLStateVertexAttribPointer(GLStateCache* cache, GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer) {
+    GLStateSetAttribFormat(cache, index, size, type, normalized, stride, pointer, false);
+}
+
+void GLStateVertexAttribIPointer(GLStateCache* cache, GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer) {
+    GLStateSetAttribFormat(cache, index, size, type, GL_FALSE, stride, pointer, true);
+}
+
+void GLStateVertexAttribDivisor(GLStateCache* cache, GLuint index, GLuint divisor) {
+    assert(index < GLStateCache::MaxVertexAttribs);
+    u32 mask = 1u << index;
+    GLVertexAttribFormat* format = cache->attribFormats + index;
+    if ((cache->knownDivisors & mask) && format->divisor == divisor) {
+        cache->callsElided++;
+    } else {
+        glVertexAttribDivisor(index, divisor);
+        format->divisor = divisor;
+        cache->knownDivisors |= mask;
+        cache->callsIssued++;
+    }
+}
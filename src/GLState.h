@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Common.h"
+
+// NOTE: Thin state tracking layer on top of OpenGL. Remembers bound objects and enabled
+// state and skips calls which would not change anything. All state starts as unknown,
+// so the first call always goes to the driver.
+
+struct GLVertexAttribFormat {
+    GLuint buffer;
+    GLint size;
+    GLenum type;
+    GLboolean normalized;
+    GLsizei stride;
+    const void* pointer;
+    b32 integer;
+    GLuint divisor;
+};
+
+struct GLStateCache {
+    static const u32 MaxVertexAttribs = 16;
+    static const GLuint Unknown = 0xffffffff;
+
+    GLuint program;
+    GLuint arrayBuffer;
+    GLuint uniformBuffer;
+    GLuint vertexArray;
+
+    // NOTE: Element buffer and attribute state belongs to the bound VAO and gets
+    // forgotten when VAO changes
+    GLuint elementArrayBuffer;
+    u32 knownAttribs;
+    u32 knownDivisors;
+    u32 enabledAttribs;
+    GLVertexAttribFormat attribFormats[MaxVertexAttribs];
+
+    u32 knownCaps;
+    u32 enabledCaps;
+
+    u32 callsIssued;
+    u32 callsElided;
+};
+
+void GLStateInit(GLStateCache* cache);
+// Resets per frame call counters
+void GLStateBeginFrame(GLStateCache* cache);
+
+void GLStateUseProgram(GLStateCache* cache, GLuint program);
+void GLStateBindBuffer(GLStateCache* cache, GLenum target, GLuint buffer);
+void GLStateBindBufferBase(GLStateCache* cache, GLenum target, GLuint index, GLuint buffer);
+void GLStateBindVertexArray(GLStateCache* cache, GLuint vertexArray);
+void GLStateEnable(GLStateCache* cache, GLenum cap);
+void GLStateDisable(GLStateCache* cache, GLenum cap);
+void GLStateEnableVertexAttribArray(GLStateCache* cache, GLuint index);
+void GLStateDisableVertexAttribArray(GLStateCache* cache, GLuint index);
+void GLStateVertexAttribPointer(GLStateCache* cache, GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+void GLStateVertexAttribIPointer(GLStateCache* cache, GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer);
+void GLStateVertexAttribDivisor(GLStateCache* cache, GLuint index, GLuint divisor);
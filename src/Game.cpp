@@ -1,15 +1,53 @@
 #include "Game.h"
 
+// Geometry which does not change from frame to frame
+void GameDrawStaticGeometry(RenderQueue* queue) {
+    DrawQuad(queue, V2(1.5f), V2(3.0f), 0.1f, V4(1.0f, 1.0f, 1.0f, 1.0f));
+    DrawQuad(queue, V2(0.0f), V2(2.0f), 0.2f, V4(1.0f, 1.0f, 0.0f, 1.0f));
+    DrawQuad(queue, V2(2.0f), V2(4.0f), 1.0f, V4(0.0f, 0.0f, 1.0f, 1.0f));
+}
+
 void GameInit() {
     GameContext* context = GetContext();
+    const PlatformState* platform = GetPlatform();
 
     Renderer* renderer = &context->renderer;
 
-    RendererInit(&context->renderer);
     RenderQueueInit(&context->renderQueue, 1024);
+    RenderQueueShardsInit(&context->renderQueueShards, platform->threadCount, 1024);
 
+    // NOTE: Only the canvas of the renderer is used in software mode
     renderer->canvas.clearColor = V4(1.0f, 0.4f, 0.0f, 1.0f);
-    renderer->canvas.projection = OrthoGLRH(-10.0f, 10.0f, -10.0f, 10.0f, 0.0f, 1.0f);
+    CanvasSetView(&renderer->canvas, 0, OrthoGLRH(-10.0f, 10.0f, -10.0f, 10.0f, 0.0f, 1.0f));
+
+    if (!platform->gl) {
+        log_print("[Game] No OpenGL, drawing with the software renderer\n");
+        context->softwareRendering = true;
+        SoftwareRendererInit(&context->softwareRenderer, platform->windowWidth, platform->windowHeight);
+        return;
+    }
+
+    RendererInit(&context->renderer);
+
+    // NOTE: Checkerboard image for sprite demonstration
+    u32 checker[16 * 16];
+    for (u32 y = 0; y < 16; y++) {
+        for (u32 x = 0; x < 16; x++) {
+            checker[y * 16 + x] = ((x / 4 + y / 4) % 2) ? 0xffffffff : 0xff404040;
+        }
+    }
+    context->checkerSprite = RendererAddImage(renderer, checker, 16, 16);
+
+    TextCacheInit(&context->text, renderer);
+    PerfOverlayInit(&context->perfOverlay);
+
+    // NOTE: Static geometry is recorded once through the regular queue and uploaded to the batch
+    RenderQueue* queue = &context->renderQueue;
+    GameDrawStaticGeometry(queue);
+    RectMergeStats merge = RenderQueueMergeRects(queue);
+    log_print("[Game] Static batch: merged %u rects into %u\n", merge.rectsBefore, merge.rectsAfter);
+    RenderBatchBuild(renderer, &context->staticBatch, queue, GL_STATIC_DRAW);
+    RenderQueueReset(queue);
 
 #if 0
     // DEMO CODE!!!
@@ -29,6 +67,22 @@ void GameReload() {
 }
 
 void GameUpdate() {
+    if (KeyPressed(Key::F3)) {
+        GameContext* context = GetContext();
+        context->perfOverlay.visible = !context->perfOverlay.visible;
+    }
+
+    if (KeyPressed(Key::F4)) {
+        GameContext* context = GetContext();
+        RenderCaptureBegin(&context->renderCapture, RenderCapture::DefaultFilename, RenderCapture::DefaultFrameCount);
+    }
+
+    // NOTE: Null and counting backends draw nothing, so the window keeps showing whatever was there
+    if (KeyPressed(Key::F5) && !GetContext()->softwareRendering) {
+        Renderer* renderer = &GetContext()->renderer;
+        RendererSetBackend(renderer, (RenderBackendKind)(((u32)renderer->backendKind + 1) % (u32)RenderBackendKind::Count));
+    }
+
 #if 0
     // This code is just demonstration and does not do anything reasonable
     if (KeyDown(Key::Space)) {
@@ -46,12 +100,40 @@ void GameRender() {
     Renderer* renderer = &context->renderer;
     RenderQueue* queue = &context->renderQueue;
 
-    DrawQuad(queue, V2(1.5f), V2(3.0f), 0.1f, V4(1.0f, 1.0f, 1.0f, 1.0f));
-    DrawQuad(queue, V2(0.0f), V2(2.0f), 0.2f, V4(1.0f, 1.0f, 0.0f, 1.0f));
-    DrawQuad(queue, V2(2.0f), V2(4.0f), 1.0f, V4(0.0f, 0.0f, 1.0f, 1.0f));
+    DrawCircle(queue, V2(-4.0f, -4.0f), 1.0f, 0.3f, V4(1.0f, 1.0f, 1.0f, 1.0f));
+    DrawCapsule(queue, V2(-8.0f, -3.0f), V2(-8.0f, 3.0f), 0.5f, 0.3f, V4(0.0f, 1.0f, 1.0f, 1.0f));
+
+    if (context->softwareRendering) {
+        // NOTE: There is no batch, so the static geometry goes through the queue every frame
+        const PlatformState* platform = GetPlatform();
+        SoftwareRenderer* software = &context->softwareRenderer;
+        GameDrawStaticGeometry(queue);
+        RenderQueueMergeShards(queue, &context->renderQueueShards);
+        RenderCaptureFrame(&context->renderCapture, &renderer->canvas, queue);
+        SoftwareRendererResize(software, platform->windowWidth, platform->windowHeight);
+        SoftwareRendererDraw(software, &renderer->canvas, queue);
+        PlatformPresentSoftwareFrame(software->color, software->width, software->height);
+        RenderQueueReset(queue);
+        return;
+    }
+
+    if (context->checkerSprite.valid) {
+        DrawSprite(queue, V2(4.0f, -6.0f), V2(8.0f, -2.0f), 0.3f, &context->checkerSprite, V4(1.0f, 1.0f, 1.0f, 1.0f));
+    }
+
+    char fps[32];
+    snprintf(fps, array_count(fps), "FPS: %d", GetPlatform()->fps);
+    DrawString(queue, &context->text, fps, V2(-9.5f, 9.5f), 0.5f, 0.05f, V4(1.0f, 1.0f, 1.0f, 1.0f));
+
+    RenderQueueMergeShards(queue, &context->renderQueueShards);
+
+    PerfOverlayUpdate(&context->perfOverlay, renderer);
 
     RendererBeginFrame(renderer);
+    RendererDrawBatch(renderer, &context->staticBatch);
+    RenderCaptureFrame(&context->renderCapture, &renderer->canvas, queue);
     RendererDraw(renderer, queue);
+    PerfOverlayDraw(&context->perfOverlay, renderer, &context->text);
     RendererEndFrame(renderer);
 
     RenderQueueReset(queue);
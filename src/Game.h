@@ -5,11 +5,28 @@
 
 #include "RenderQueue.h"
 #include "Render.h"
+#include "Text.h"
+#include "PerfOverlay.h"
+#include "RenderCapture.h"
+#include "SoftwareRenderer.h"
 
 // NOTE: All global game stuff lives here
 struct GameContext {
     RenderQueue renderQueue;
+    // Per-thread queues for jobs which emit draws
+    RenderQueueShards renderQueueShards;
     Renderer renderer;
+    // Geometry which does not change from frame to frame
+    RenderBatch staticBatch;
+    AtlasRegion checkerSprite;
+    TextCache text;
+    // Toggled with F3
+    PerfOverlay perfOverlay;
+    // Started with F4
+    RenderCapture renderCapture;
+    // NOTE: Used when the platform has no OpenGL. Text, sprites and the perf overlay are not drawn then
+    b32 softwareRendering;
+    SoftwareRenderer softwareRenderer;
     // Dummy stuff for demonstration how everything works
     void* someData;
     v4 color1;
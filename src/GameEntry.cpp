@@ -3,7 +3,8 @@
 #include "Math.h"
 #include "platform/OpenGL.h"
 
-// NOTE: Logger and assert handler implementation
+// NOTE: Logger and assert handler implementation. In the static build the platform provides them
+#if !defined(GAME_STATIC_LINK)
 // TODO: Logger
 void Logger(void* data, const char* fmt, va_list* args) {
     vprintf(fmt, *args);
@@ -22,12 +23,18 @@ LoggerFn* GlobalLogger = Logger;
 void* GlobalLoggerData = nullptr;
 AssertHandlerFn* GlobalAssertHandler = AssertHandler;
 void* GlobalAssertHandlerData = nullptr;
+#endif
 
 // Global variables for the game. They should be set every time after game code reloading
 static PlatformState* _GlobalPlatformState;
 
 // Shortcuts for OpenGL functions
+#if defined(GAME_STATIC_LINK)
+// NOTE: Game is compiled into the platform executable and reads the platform function table directly
+#define gl_function(func) SDLGlobalOpenGL.functions.fn. func
+#else
 #define gl_function(func) _GlobalPlatformState->gl->functions.fn. func
+#endif
 
 #define glClear gl_function(glClear)
 #define glClearColor gl_function(glClearColor)
@@ -63,10 +70,66 @@ static PlatformState* _GlobalPlatformState;
 #define glUniformMatrix4fv gl_function(glUniformMatrix4fv)
 #define glClearDepth gl_function(glClearDepth)
 #define glDrawArrays gl_function(glDrawArrays)
-#define glLineWidth gl_function(glLineWidth)
+#define glDrawArraysInstanced gl_function(glDrawArraysInstanced)
+#define glVertexAttribIPointer gl_function(glVertexAttribIPointer)
+#define glVertexAttribDivisor gl_function(glVertexAttribDivisor)
+#define glBufferSubData gl_function(glBufferSubData)
+#define glDeleteBuffers gl_function(glDeleteBuffers)
+#define glMapBufferRange gl_function(glMapBufferRange)
+#define glBindBufferBase gl_function(glBindBufferBase)
+#define glGetUniformBlockIndex gl_function(glGetUniformBlockIndex)
+#define glUniformBlockBinding gl_function(glUniformBlockBinding)
+#define glDisableVertexAttribArray gl_function(glDisableVertexAttribArray)
+#define glGenFramebuffers gl_function(glGenFramebuffers)
+#define glBindFramebuffer gl_function(glBindFramebuffer)
+#define glFramebufferTexture2D gl_function(glFramebufferTexture2D)
+#define glCheckFramebufferStatus gl_function(glCheckFramebufferStatus)
+#define glGenRenderbuffers gl_function(glGenRenderbuffers)
+#define glBindRenderbuffer gl_function(glBindRenderbuffer)
+#define glRenderbufferStorage gl_function(glRenderbufferStorage)
+#define glFramebufferRenderbuffer gl_function(glFramebufferRenderbuffer)
+#define glGenTextures gl_function(glGenTextures)
+#define glBindTexture gl_function(glBindTexture)
+#define glActiveTexture gl_function(glActiveTexture)
+#define glTexImage2D gl_function(glTexImage2D)
+#define glTexImage3D gl_function(glTexImage3D)
+#define glTexSubImage2D gl_function(glTexSubImage2D)
+#define glTexSubImage3D gl_function(glTexSubImage3D)
+#define glFenceSync gl_function(glFenceSync)
+#define glClientWaitSync gl_function(glClientWaitSync)
+#define glDeleteSync gl_function(glDeleteSync)
+#define glTexParameteri gl_function(glTexParameteri)
+#define glUniform1i gl_function(glUniform1i)
+#define glUniform1f gl_function(glUniform1f)
+#define glBlendFunc gl_function(glBlendFunc)
+#define glBlendFuncSeparate gl_function(glBlendFuncSeparate)
+#define glGetString gl_function(glGetString)
+#define glDeleteProgram gl_function(glDeleteProgram)
+#define glFinish gl_function(glFinish)
+#define glGenQueries gl_function(glGenQueries)
+#define glDeleteQueries gl_function(glDeleteQueries)
+#define glBeginQuery gl_function(glBeginQuery)
+#define glEndQuery gl_function(glEndQuery)
+#define glGetQueryObjectui64v gl_function(glGetQueryObjectui64v)
+// Optional functions. Check the extension flag before use
+#define glGetProgramBinary gl_function(glGetProgramBinary)
+#define glProgramBinary gl_function(glProgramBinary)
+#define glProgramParameteri gl_function(glProgramParameteri)
+#define glMaxShaderCompilerThreadsKHR gl_function(glMaxShaderCompilerThreadsKHR)
+
+#if defined(GAME_STATIC_LINK)
+#define gl_extension(ext) SDLGlobalOpenGL.extensions. ext
+#else
+#define gl_extension(ext) _GlobalPlatformState->gl->extensions. ext
+#endif
 // Shortcuts for platform functions
 // For declarations see Platform.h
+#if defined(GAME_STATIC_LINK)
+// NOTE: Platform functions have the same names as the PlatformCalls members, so they are called directly
+#define platform_call(func) func
+#else
 #define platform_call(func) _GlobalPlatformState->functions. func
+#endif
 
 #define PlatformDebugGetFileSize platform_call(DebugGetFileSize)
 #define PlatformDebugReadFile platform_call(DebugReadFile)
@@ -76,6 +139,14 @@ static PlatformState* _GlobalPlatformState;
 #define PlatformDebugCloseFile platform_call(DebugCloseFile)
 #define PlatformDebugCopyFile platform_call(DebugCopyFile)
 #define PlatformDebugWriteToOpenedFile platform_call(DebugWriteToOpenedFile)
+#define PlatformDebugGetFileWriteTime platform_call(DebugGetFileWriteTime)
+
+#define PlatformPushWork platform_call(PushWork)
+#define PlatformCompleteAllWork platform_call(CompleteAllWork)
+#define PlatformPushGLWork platform_call(PushGLWork)
+#define PlatformPresentSoftwareFrame platform_call(PresentSoftwareFrame)
+
+#define PlatformGetTimeStamp platform_call(GetTimeStamp)
 
 // Allocator declaraions are in Common.h
 #define PlatformAllocate platform_call(Allocate)
@@ -119,5 +190,15 @@ extern "C" GAME_CODE_ENTRY void __cdecl GameUpdateAndRender(PlatformState* platf
 
 // NOTE(swarzzy): All game .cpp files should be included here
 #include "Game.cpp"
+#include "GLState.cpp"
+#include "ShaderCache.cpp"
+#include "ShaderReload.cpp"
+#include "TextureStream.cpp"
+#include "TextureAtlas.cpp"
 #include "RenderQueue.cpp"
 #include "Render.cpp"
+#include "RenderBackend.cpp"
+#include "Text.cpp"
+#include "PerfOverlay.cpp"
+#include "RenderCapture.cpp"
+#include "SoftwareRenderer.cpp"
@@ -17,6 +17,114 @@ constexpr bool IsPowerOfTwo(u32 n) {
     return result;
 }
 
+// Index of the least significant set bit. Value should be non-zero
+inline u32 FindFirstSetBit(u32 value) {
+#if defined(COMPILER_MSVC)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return (u32)index;
+#else
+    return (u32)__builtin_ctz(value);
+#endif
+}
+
+// NOTE: Atomics for values shared between threads. Loads acquire, stores release and
+// read-modify-write operations are full barriers
+inline u32 AtomicLoad(volatile u32* value) {
+#if defined(COMPILER_MSVC)
+    u32 result = *value;
+    _ReadWriteBarrier();
+    return result;
+#else
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+inline void AtomicStore(volatile u32* value, u32 desired) {
+#if defined(COMPILER_MSVC)
+    _ReadWriteBarrier();
+    *value = desired;
+#else
+    __atomic_store_n(value, desired, __ATOMIC_RELEASE);
+#endif
+}
+
+// Returns the previous value
+inline u32 AtomicExchange(volatile u32* value, u32 desired) {
+#if defined(COMPILER_MSVC)
+    return (u32)_InterlockedExchange((volatile long*)value, (long)desired);
+#else
+    return __atomic_exchange_n(value, desired, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Returns the previous value. The exchange happened if it is equal to expected
+inline u32 AtomicCompareExchange(volatile u32* value, u32 expected, u32 desired) {
+#if defined(COMPILER_MSVC)
+    return (u32)_InterlockedCompareExchange((volatile long*)value, (long)desired, (long)expected);
+#else
+    __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return expected;
+#endif
+}
+
+// Returns the previous value
+inline u32 AtomicAdd(volatile u32* value, u32 addend) {
+#if defined(COMPILER_MSVC)
+    return (u32)_InterlockedExchangeAdd((volatile long*)value, (long)addend);
+#else
+    return __atomic_fetch_add(value, addend, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// NOTE: CPU timestamp counter. Cheap enough to read around every call. Only differences are meaningful
+// and the frequency is not known, so it has to be measured against a timer
+inline u64 ReadCycleCounter() {
+#if defined(COMPILER_MSVC)
+    return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    u64 value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+#error Unsupported architecture
+#endif
+}
+
+// Tells the CPU that the thread is spinning on a condition
+inline void CpuRelax() {
+#if defined(COMPILER_MSVC) || defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// NOTE: Fast non-cryptographic hash. Consumes 8 bytes per step
+inline u64 HashBytes(const void* data, usize size, u64 seed) {
+    const u64 multiplier = 0x9e3779b97f4a7c15ull;
+    u64 hash = seed ^ (size * multiplier);
+    const u8* at = (const u8*)data;
+    while (size >= 8) {
+        u64 word;
+        memcpy(&word, at, sizeof(u64));
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 32;
+        at += 8;
+        size -= 8;
+    }
+    if (size) {
+        u64 word = 0;
+        memcpy(&word, at, size);
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 32;
+    }
+    hash ^= hash >> 29;
+    return hash;
+}
+
 f32 Pow(f32 base, f32 exp) {
     return powf(base, exp);
 }
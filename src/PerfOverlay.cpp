@@ -0,0 +1,133 @@
+#include "PerfOverlay.h"
+
+void PerfOverlayInit(PerfOverlay* overlay) {
+    *overlay = {};
+    RenderQueueInit(&overlay->queue, 1024);
+    overlay->allocationCount = GetPlatform()->allocationCount;
+}
+
+void PerfOverlayUpdate(PerfOverlay* overlay, const Renderer* renderer) {
+    const PlatformState* platform = GetPlatform();
+
+    overlay->frameTimes[overlay->historyAt] = platform->frameTime * 1000.0f;
+    overlay->historyAt = (overlay->historyAt + 1) % PerfOverlay::HistorySize;
+    overlay->historyCount = Min(overlay->historyCount + 1, PerfOverlay::HistorySize);
+
+    overlay->stats = renderer->stats;
+    overlay->frameAllocations = (u32)(platform->allocationCount - overlay->allocationCount);
+    overlay->allocationCount = platform->allocationCount;
+}
+
+// NOTE: Maps overlay pixels to the world space of the first view. Pixels go from the top left corner of the window
+struct PerfOverlayMapping {
+    v2 origin;
+    v2 pixel;
+};
+
+inline v2 PerfOverlayPoint(const PerfOverlayMapping* mapping, f32 x, f32 y) {
+    return V2(mapping->origin.x + x * mapping->pixel.x, mapping->origin.y + y * mapping->pixel.y);
+}
+
+void PerfOverlayRect(RenderQueue* queue, const PerfOverlayMapping* mapping, f32 x0, f32 y0, f32 x1, f32 y1, f32 z, v4 color) {
+    v2 a = PerfOverlayPoint(mapping, x0, y0);
+    v2 b = PerfOverlayPoint(mapping, x1, y1);
+    DrawQuad(queue, V2(Min(a.x, b.x), Min(a.y, b.y)), V2(Max(a.x, b.x), Max(a.y, b.y)), z, color);
+}
+
+void PerfOverlayText(RenderQueue* queue, TextCache* text, const PerfOverlayMapping* mapping, u32 line, const char* string) {
+    f32 y = (f32)(PerfOverlay::Margin * 2 + PerfOverlay::GraphHeight + line * (PerfOverlay::GlyphSize + 2));
+    v2 position = PerfOverlayPoint(mapping, (f32)(PerfOverlay::Margin * 2), y);
+    DrawString(queue, text, string, position, PerfOverlay::GlyphSize * Abs(mapping->pixel.y), 0.0f, V4(1.0f, 1.0f, 1.0f, 1.0f));
+}
+
+void PerfOverlayDraw(PerfOverlay* overlay, Renderer* renderer, TextCache* text) {
+    if (!overlay->visible) {
+        return;
+    }
+
+    const PlatformState* platform = GetPlatform();
+    f64 startTime = PlatformGetTimeStamp();
+
+    // NOTE(swarzzy): The first view is expected to be an orthographic 2D one
+    m4x4 invView = Inverse(renderer->canvas.views[0]);
+    v4 topLeft = invView * V4(-1.0f, 1.0f, 0.0f, 1.0f);
+    v4 bottomRight = invView * V4(1.0f, -1.0f, 0.0f, 1.0f);
+    PerfOverlayMapping mapping;
+    mapping.origin = V2(topLeft.x / topLeft.w, topLeft.y / topLeft.w);
+    mapping.pixel = V2((bottomRight.x / bottomRight.w - mapping.origin.x) / (f32)Max(platform->windowWidth, 1u),
+                       (bottomRight.y / bottomRight.w - mapping.origin.y) / (f32)Max(platform->windowHeight, 1u));
+
+    RenderQueue* queue = &overlay->queue;
+    const f32 margin = (f32)PerfOverlay::Margin;
+    const f32 graphHeight = (f32)PerfOverlay::GraphHeight;
+    const f32 width = (f32)PerfOverlay::HistorySize;
+    // Graph tops out at 30 fps
+    const f32 graphMax = 1000.0f / 30.0f;
+    const f32 target = 1000.0f / 60.0f;
+
+    // Panel is blended, so it goes behind everything else of the overlay
+    f32 panelHeight = margin * 3 + graphHeight + PerfOverlay::LineCount * (PerfOverlay::GlyphSize + 2);
+    v2 panelA = PerfOverlayPoint(&mapping, margin, margin);
+    v2 panelB = PerfOverlayPoint(&mapping, margin * 3 + width, panelHeight);
+    DrawRoundedRect(queue, V2(Min(panelA.x, panelB.x), Min(panelA.y, panelB.y)), V2(Max(panelA.x, panelB.x), Max(panelA.y, panelB.y)), 4.0f * Abs(mapping.pixel.y), 0.0005f, V4(0.0f, 0.0f, 0.0f, 0.75f));
+
+    // Sorted copy for percentiles. Insertion sort is fine for a few hundred samples
+    f32 sorted[PerfOverlay::HistorySize];
+    u32 count = overlay->historyCount;
+    for (u32 i = 0; i < count; i++) {
+        // Oldest sample goes first
+        u32 index = (overlay->historyAt + PerfOverlay::HistorySize - count + i) % PerfOverlay::HistorySize;
+        f32 time = overlay->frameTimes[index];
+
+        f32 height = Clamp(time / graphMax, 0.0f, 1.0f) * graphHeight;
+        v4 color = time <= target ? V4(0.2f, 0.8f, 0.2f, 1.0f) : (time <= graphMax ? V4(0.9f, 0.8f, 0.1f, 1.0f) : V4(0.9f, 0.2f, 0.1f, 1.0f));
+        f32 x = margin * 2 + (width - count + i);
+        PerfOverlayRect(queue, &mapping, x, margin * 2 + graphHeight - height, x + 1.0f, margin * 2 + graphHeight, 0.0f, color);
+
+        u32 at = i;
+        while (at && sorted[at - 1] > time) {
+            sorted[at] = sorted[at - 1];
+            at--;
+        }
+        sorted[at] = time;
+    }
+
+    f32 targetY = margin * 2 + graphHeight * (1.0f - target / graphMax);
+    v2 targetBegin = PerfOverlayPoint(&mapping, margin * 2, targetY);
+    v2 targetEnd = PerfOverlayPoint(&mapping, margin * 2 + width, targetY);
+    DrawLine(queue, V3(targetBegin, 0.0f), V3(targetEnd, 0.0f), V4(1.0f, 1.0f, 1.0f, 1.0f), 1.0f);
+
+    f32 p50 = count ? sorted[(count - 1) / 2] : 0.0f;
+    f32 p95 = count ? sorted[(u32)((count - 1) * 0.95f)] : 0.0f;
+    f32 p99 = count ? sorted[(u32)((count - 1) * 0.99f)] : 0.0f;
+    f32 max = count ? sorted[count - 1] : 0.0f;
+
+    const RendererStats* stats = &overlay->stats;
+    char line[64];
+    snprintf(line, array_count(line), "frame %.2f ms  fps %d", platform->frameTime * 1000.0f, platform->fps);
+    PerfOverlayText(queue, text, &mapping, 0, line);
+    snprintf(line, array_count(line), "p50 %.1f p95 %.1f p99 %.1f max %.1f", p50, p95, p99, max);
+    PerfOverlayText(queue, text, &mapping, 1, line);
+    snprintf(line, array_count(line), "rects %u lines %u shapes %u", stats->rectsSubmitted, stats->linesSubmitted, stats->shapesSubmitted);
+    PerfOverlayText(queue, text, &mapping, 2, line);
+    snprintf(line, array_count(line), "draws %u  uploaded %.1f KB", stats->drawCalls, stats->bytesUploaded / 1024.0f);
+    PerfOverlayText(queue, text, &mapping, 3, line);
+    snprintf(line, array_count(line), "allocations %u  reloads %u", overlay->frameAllocations, platform->hotReloadCount);
+    PerfOverlayText(queue, text, &mapping, 4, line);
+    snprintf(line, array_count(line), "overlay %.3f ms", overlay->drawTime);
+    PerfOverlayText(queue, text, &mapping, 5, line);
+    const OpenGLFrameStats* glStats = platform->glStats;
+    if (glStats) {
+        f64 glTime = glStats->cyclesPerSecond > 0.0 ? (f64)glStats->cycleCount * 1000.0 / glStats->cyclesPerSecond : 0.0;
+        snprintf(line, array_count(line), "gl %u calls %u draws %u state %.2f ms", glStats->callCount, glStats->drawCount, glStats->stateChangeCount, glTime);
+    } else {
+        snprintf(line, array_count(line), "gl stats off");
+    }
+    PerfOverlayText(queue, text, &mapping, 6, line);
+
+    RenderBatchBuild(renderer, &overlay->batch, queue, GL_STREAM_DRAW);
+    RendererDrawBatch(renderer, &overlay->batch);
+    RenderQueueReset(queue);
+
+    overlay->drawTime = (f32)((PlatformGetTimeStamp() - startTime) * 1000.0);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Common.h"
+#include "RenderQueue.h"
+#include "Render.h"
+#include "Text.h"
+
+// NOTE: Frame time graph and per-frame counters drawn on top of the first view in a single extra batch
+struct PerfOverlay {
+    static const u32 HistorySize = 240;
+    // Sizes are in pixels
+    static const u32 Margin = 8;
+    static const u32 GraphHeight = 64;
+    static const u32 GlyphSize = 8;
+    static const u32 LineCount = 7;
+
+    b32 visible;
+
+    // Frame times in milliseconds. Once the history is full the oldest one is at historyAt
+    u32 historyAt;
+    u32 historyCount;
+    f32 frameTimes[HistorySize];
+
+    // Counters of the previous frame
+    RendererStats stats;
+    u64 allocationCount;
+    u32 frameAllocations;
+    // Time the overlay took itself in milliseconds
+    f32 drawTime;
+
+    RenderQueue queue;
+    RenderBatch batch;
+};
+
+void PerfOverlayInit(PerfOverlay* overlay);
+// Records the previous frame. Must be called before RendererBeginFrame which resets the stats
+void PerfOverlayUpdate(PerfOverlay* overlay, const Renderer* renderer);
+// Builds and draws the overlay batch if the overlay is visible. Must go after RendererDraw
+void PerfOverlayDraw(PerfOverlay* overlay, Renderer* renderer, TextCache* text);
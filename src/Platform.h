@@ -10,6 +10,7 @@
 #include "Math.h"
 
 struct OpenGL;
+struct OpenGLFrameStats;
 
 #if defined(PLATFORM_WINDOWS)
 #define GAME_CODE_ENTRY __declspec(dllexport)
@@ -49,6 +50,27 @@ typedef b32(DebugCopyFileFn)(const char* source, const char* dest, b32 overwrite
 typedef FileHandle(DebugOpenFileFn)(const char* filename);
 typedef b32(DebugCloseFileFn)(FileHandle handle);
 typedef u32(DebugWriteToOpenedFileFn)(FileHandle handle, void* data, u32 size);
+// Last modification time in platform units. Only comparisons are meaningful. Zero if the file does not exist
+typedef u64(DebugGetFileWriteTimeFn)(const char* filename);
+
+// NOTE: Work queue. Jobs pushed by the main thread are executed by platform worker threads.
+// threadIndex is unique for every thread in [0, PlatformState::threadCount). Main thread
+// has index 0 and also executes jobs while it waits in CompleteAllWork
+typedef void(WorkFn)(void* data, u32 threadIndex);
+typedef void(PushWorkFn)(WorkFn* fn, void* data);
+typedef void(CompleteAllWorkFn)();
+// NOTE: Runs the job on a dedicated thread with an OpenGL context which shares objects with the main one.
+// Jobs are executed in order. There is no way to wait for them, so results are published by jobs themselves.
+// If the platform failed to create the shared context jobs are executed right away on the calling thread.
+// GL jobs get threadIndex equal to PlatformState::threadCount, so it does not clash with work queue threads
+typedef void(PushGLWorkFn)(WorkFn* fn, void* data);
+
+// NOTE: Shows RGBA8 pixels with the bottom left origin in the window. Used by the software renderer when
+// PlatformState::gl is null. Pixels outside of the window are cropped
+typedef void(PresentSoftwareFrameFn)(const u32* pixels, u32 width, u32 height);
+
+// Seconds from some arbitrary moment. Only differences are meaningful
+typedef f64(GetTimeStampFn)();
 
 // NOTE: Functions that platform passes to the game
 struct PlatformCalls
@@ -61,6 +83,15 @@ struct PlatformCalls
     DebugCloseFileFn* DebugCloseFile;
     DebugCopyFileFn* DebugCopyFile;
     DebugWriteToOpenedFileFn* DebugWriteToOpenedFile;
+    DebugGetFileWriteTimeFn* DebugGetFileWriteTime;
+
+    PushWorkFn* PushWork;
+    CompleteAllWorkFn* CompleteAllWork;
+    PushGLWorkFn* PushGLWork;
+
+    PresentSoftwareFrameFn* PresentSoftwareFrame;
+
+    GetTimeStampFn* GetTimeStamp;
 
     // Default allocator
     AllocateFn* Allocate;
@@ -232,16 +263,32 @@ struct InputState
 struct PlatformState
 {
     PlatformCalls functions;
+    // Null if OpenGL is not available
     OpenGL* gl;
+    // Null unless GL statistics are enabled
+    const OpenGLFrameStats* glStats;
     InputState input;
     u64 tickCount;
+    // Number of threads which may execute jobs (including the main thread)
+    u32 threadCount;
     i32 fps;
     i32 ups;
+    // Clamped frame time used for simulation
     f32 deltaTime;
+    // Actual duration of the last frame in seconds
+    f32 frameTime;
+    // Running totals of calls to the default allocator and game code reloads
+    u64 allocationCount;
+    u32 hotReloadCount;
     u32 windowWidth;
     u32 windowHeight;
 };
 
+#if defined(GAME_STATIC_LINK)
+// NOTE: Game entry point is linked into the platform executable
+extern "C" void __cdecl GameUpdateAndRender(PlatformState* platform, GameInvoke invoke, void** data);
+#endif
+
 inline const char* ToString(Key keycode) {
     switch (keycode) {
     case Key::Backspace: { return "Backspace";  }
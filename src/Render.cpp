@@ -1,296 +1,1146 @@
 #include "Render.h"
 
-const char* ColorRectOpaqueShaderVertex = R"(
-#version 330 core
+void CanvasSetView(Canvas* canvas, u32 index, m4x4 viewProjection) {
+    assert(index < Canvas::MaxViews);
+    canvas->views[index] = viewProjection;
+    canvas->viewClips[index] = V4(-1.0f, -1.0f, 1.0f, 1.0f);
+    canvas->viewCount = Max(canvas->viewCount, index + 1);
+}
 
-layout (location = 0) in vec4 Position;
-layout (location = 1) in vec4 Color;
+void CanvasSetViewClip(Canvas* canvas, u32 index, v2 clipMin, v2 clipMax) {
+    assert(index < canvas->viewCount);
+    canvas->viewClips[index] = V4(clipMin.x, clipMin.y, clipMax.x, clipMax.y);
+}
 
-out vec4 VertexColor;
+AtlasRegion RendererAddImage(Renderer* renderer, const void* rgba, u32 width, u32 height) {
+    AtlasRegion region = TextureAtlasAdd(&renderer->atlas, rgba, width, height);
+    if (!region.valid) {
+        log_print("[Renderer] Failed to add %ux%u image to the atlas\n", width, height);
+    }
+    return region;
+}
 
-uniform mat4 MVP;
+// Sets uniforms which never change. Called every time the program is rebuilt
+void RendererSetupUberShader(Renderer* renderer) {
+    // NOTE(swarzzy): Atlas stays bound to its own unit
+    GLint atlasLocation = glGetUniformLocation(renderer->uberShader, "Atlas");
+    assert(atlasLocation != -1);
+    GLStateUseProgram(&renderer->glState, renderer->uberShader);
+    glUniform1i(atlasLocation, Renderer::AtlasTextureUnit);
+
+    GLuint frameUniformsIndex = glGetUniformBlockIndex(renderer->uberShader, "FrameUniforms");
+    assert(frameUniformsIndex != GL_INVALID_INDEX);
+    glUniformBlockBinding(renderer->uberShader, frameUniformsIndex, Renderer::FrameUniformsBinding);
+}
 
-void main() {
-    gl_Position = MVP * vec4(Position.xyz, 1.0f);
-    VertexColor = Color;
-})";
+void RendererSetupCompositeShader(Renderer* renderer) {
+    renderer->compositeDepthLocation = glGetUniformLocation(renderer->compositeShader, "Depth");
+    assert(renderer->compositeDepthLocation != -1);
+    renderer->compositeTextureLocation = glGetUniformLocation(renderer->compositeShader, "Layer");
+    assert(renderer->compositeTextureLocation != -1);
+}
 
-const char* ColorRectOpaqueShaderFragment = R"(
-#version 330 core
+// Swaps in programs rebuilt from changed shader files
+void RendererReloadShaders(Renderer* renderer) {
+    if (--renderer->shaderWatchCountdown == 0) {
+        renderer->shaderWatchCountdown = Renderer::ShaderWatchInterval;
+        ShaderSourceWatch(&renderer->uberShaderSource);
+        ShaderSourceWatch(&renderer->compositeShaderSource);
+    }
 
-out vec4 FragmentColor;
+    GLuint uberShader = ShaderSourceTakeProgram(&renderer->uberShaderSource);
+    if (uberShader) {
+        // NOTE(swarzzy): Deleted program name may be reused, so the cached binding can't be trusted anymore
+        GLStateUseProgram(&renderer->glState, 0);
+        glDeleteProgram(renderer->uberShader);
+        renderer->uberShader = uberShader;
+        RendererSetupUberShader(renderer);
+        log_print("[Renderer] Program (%s) was reloaded\n", renderer->uberShaderSource.name);
+    }
 
-in vec4 VertexColor;
+    GLuint compositeShader = ShaderSourceTakeProgram(&renderer->compositeShaderSource);
+    if (compositeShader) {
+        GLStateUseProgram(&renderer->glState, 0);
+        glDeleteProgram(renderer->compositeShader);
+        renderer->compositeShader = compositeShader;
+        RendererSetupCompositeShader(renderer);
+        log_print("[Renderer] Program (%s) was reloaded\n", renderer->compositeShaderSource.name);
+    }
+}
 
-void main() {
-    FragmentColor = vec4(VertexColor.xyz, 1.0f);
-})";
+// NOTE(swarzzy): Shader files are read from the source tree, so the game falls back to sources built into it
+// when it runs somewhere else. Files are still watched and replace built in sources once they appear.
+// Static build does not depend on the source tree at all and uses built in sources only
+void RendererLoadShaderSource(ShaderSource* source) {
+#if defined(GAME_STATIC_LINK)
+    b32 loaded = ShaderSourceLoadEmbedded(source);
+    assert(loaded);
+#else
+    if (!ShaderSourceLoad(source)) {
+        log_print("[Renderer] Using built in sources of program (%s)\n", source->name);
+        if (!ShaderSourceLoadEmbedded(source)) {
+            panic("[Renderer] There are no built in sources of program (%s)", source->name);
+        }
+    }
+#endif
+}
 
-const char* LineShaderVertex = R"(
-#version 330 core
+// Creates GL objects. Called by RendererInit whichever backend is going to be used
+void RenderBackendGLInit(Renderer* renderer) {
+    GLStateCache* state = &renderer->glState;
+    GLStateInit(state);
 
-layout (location = 0) in vec4 Position;
-layout (location = 1) in vec4 Color;
+    GLuint globalVAO;
+    glGenVertexArrays(1, &globalVAO);
+    GLStateBindVertexArray(state, globalVAO);
+
+    GLStateEnable(state, GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL);
+    GLStateEnable(state, GL_CULL_FACE);
+    glCullFace(GL_BACK);
+    glFrontFace(GL_CCW);
+    // View clip rect planes
+    for (u32 i = 0; i < 4; i++) {
+        GLStateEnable(state, GL_CLIP_DISTANCE0 + i);
+    }
+    // TODO(swarzzy): Multisampling
+    //glEnable(GL_MULTISAMPLE);
 
-out vec4 VertexColor;
+    glClearDepth(1.0f);
 
-uniform mat4 MVP;
+    glGenBuffers(1, &renderer->instanceBuffer);
+    assert(renderer->instanceBuffer);
 
-void main() {
-    gl_Position = MVP * vec4(Position.xyz, 1.0f);
-    VertexColor = Color;
-})";
+    // NOTE(swarzzy): Every attribute advances once per instance
+    for (u32 i = 0; i < Renderer::InstanceAttribCount; i++) {
+        GLStateVertexAttribDivisor(state, i, 1);
+    }
 
-const char* LineShaderFragment = R"(
-#version 330 core
+    // NOTE(swarzzy): Both programs are started before waiting for any of them, so the driver may compile them in parallel
+    f64 shaderStartTime = PlatformGetTimeStamp();
+    ShaderCacheInit(&renderer->shaderCache);
+    ShaderSourceInit(&renderer->uberShaderSource, &renderer->shaderCache, Renderer::ShaderDirectory, "UberShader");
+    ShaderSourceInit(&renderer->compositeShaderSource, &renderer->shaderCache, Renderer::ShaderDirectory, "CompositeShader");
+    RendererLoadShaderSource(&renderer->uberShaderSource);
+    RendererLoadShaderSource(&renderer->compositeShaderSource);
+    ShaderBuild uberShaderBuild;
+    ShaderBuild compositeShaderBuild;
+    ShaderBuildBegin(&renderer->shaderCache, &uberShaderBuild, "UberShader", renderer->uberShaderSource.vertex, renderer->uberShaderSource.fragment);
+    ShaderBuildBegin(&renderer->shaderCache, &compositeShaderBuild, "CompositeShader", renderer->compositeShaderSource.vertex, renderer->compositeShaderSource.fragment);
+
+    // NOTE(swarzzy): Rest of the objects are created while the driver compiles
+    TextureStreamInit(&renderer->textureStream, TextureStream::DefaultFrameBudget);
+    TextureAtlasInit(&renderer->atlas, &renderer->textureStream);
+
+    glGenBuffers(1, &renderer->layerInstanceBuffer);
+    assert(renderer->layerInstanceBuffer);
+
+    glGenBuffers(1, &renderer->frameUniformBuffer);
+    assert(renderer->frameUniformBuffer);
+    GLStateBindBufferBase(state, GL_UNIFORM_BUFFER, Renderer::FrameUniformsBinding, renderer->frameUniformBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_DYNAMIC_DRAW);
+
+    renderer->uberShader = ShaderBuildEnd(&renderer->shaderCache, &uberShaderBuild);
+    assert(renderer->uberShader);
+    renderer->compositeShader = ShaderBuildEnd(&renderer->shaderCache, &compositeShaderBuild);
+    assert(renderer->compositeShader);
+    ShaderSourceFree(&renderer->uberShaderSource);
+    ShaderSourceFree(&renderer->compositeShaderSource);
+    renderer->shaderWatchCountdown = Renderer::ShaderWatchInterval;
+    log_print("[Renderer] Shaders are ready in %.2f ms. %u loaded from the cache, %u compiled\n",
+              (PlatformGetTimeStamp() - shaderStartTime) * 1000.0, renderer->shaderCache.hits, renderer->shaderCache.misses);
+
+    static_assert(offsetof(FrameUniforms, viewClips) == sizeof(m4x4) * Canvas::MaxViews);
+    static_assert(offsetof(FrameUniforms, viewportSize) == (sizeof(m4x4) + sizeof(v4)) * Canvas::MaxViews);
+    RendererSetupUberShader(renderer);
+    RendererSetupCompositeShader(renderer);
+}
 
-out vec4 FragmentColor;
+void RenderBackendGLBeginFrame(Renderer* renderer) {
+    glClearColor(renderer->canvas.clearColor.r, renderer->canvas.clearColor.g, renderer->canvas.clearColor.b, renderer->canvas.clearColor.a);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-in vec4 VertexColor;
+    GLStateBeginFrame(&renderer->glState);
+#if !defined(GAME_STATIC_LINK)
+    RendererReloadShaders(renderer);
+#endif
 
-void main() {
-    FragmentColor = vec4(VertexColor.xyz, 1.0f);
-})";
+    const PlatformState* platform = GetPlatform();
+    glViewport(0, 0, platform->windowWidth, platform->windowHeight);
 
-struct Vertex {
-    v4 position;
-    v4 color;
-};
+    // NOTE(swarzzy): Uploading all views once per frame. The buffer stays bound to the uniform
+    // block binding, so every program sees it without any per-draw uniform calls
+    const Canvas* canvas = &renderer->canvas;
+    FrameUniforms uniforms {};
+    for (u32 view = 0; view < canvas->viewCount; view++) {
+        uniforms.viewProjections[view] = canvas->views[view];
+        uniforms.viewClips[view] = canvas->viewClips[view];
+    }
+    uniforms.viewportSize = V2((f32)platform->windowWidth, (f32)platform->windowHeight);
+    GLStateBindBuffer(&renderer->glState, GL_UNIFORM_BUFFER, renderer->frameUniformBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &uniforms);
 
-struct LineVertex {
-    v4 position;
-    v4 color;
-};
+    // NOTE(swarzzy): Texture copies go before the draws of this frame, so sprites see everything uploaded so far
+    TextureStreamUpdate(&renderer->textureStream);
 
-GLuint CompileGLSL(const char* name, const char* vertexSource, const char* fragmentSource);
+    renderer->stats.textureBytesStreamed = renderer->textureStream.frameBytesUploaded;
+    renderer->stats.bytesUploaded = sizeof(FrameUniforms) + renderer->textureStream.frameBytesUploaded;
+    renderer->stats.textureUploadsPending = renderer->textureStream.pendingCount;
+}
 
 void RendererInit(Renderer* renderer) {
-    GLuint globalVAO;
-    glGenVertexArrays(1, &globalVAO);
-    glBindVertexArray(globalVAO);
+    for (u32 kind = 0; kind < (u32)RenderBackendKind::Count; kind++) {
+        RenderBackendGet((RenderBackendKind)kind)->Init(renderer);
+    }
+    RendererSetBackend(renderer, RenderBackendKind::GL);
+}
 
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LEQUAL);
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_BACK);
-    glFrontFace(GL_CCW);
-    // TODO(swarzzy): Multisampling
-    //glEnable(GL_MULTISAMPLE);
+void RendererSetBackend(Renderer* renderer, RenderBackendKind kind) {
+    renderer->backendKind = kind;
+    log_print("[Renderer] Backend: %s\n", RenderBackendGet(kind)->name);
+}
 
-    glLineWidth(3.0f);
+void RendererBeginFrame(Renderer* renderer) {
+    renderer->stats = {};
 
-    glClearDepth(1.0f);
+    const PlatformState* platform = GetPlatform();
+    const Canvas* canvas = &renderer->canvas;
+    assert(canvas->viewCount && canvas->viewCount <= Canvas::MaxViews);
+
+    // NOTE(swarzzy): Unprojecting corners of the clip volume of every view to get world space
+    // view bounds. Commands are culled against the union of all views
+    renderer->viewMin = V2(F32::Max);
+    renderer->viewMax = V2(-F32::Max);
+    renderer->worldPerPixel = V2(0.0f);
+    for (u32 view = 0; view < canvas->viewCount; view++) {
+        m4x4 invProjection = Inverse(canvas->views[view]);
+        v2 viewMin = V2(F32::Max);
+        v2 viewMax = V2(-F32::Max);
+        for (u32 i = 0; i < 8; i++) {
+            v4 corner = V4((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+            v4 p = invProjection * corner;
+            v2 world = V2(p.x / p.w, p.y / p.w);
+            viewMin = V2(Min(viewMin.x, world.x), Min(viewMin.y, world.y));
+            viewMax = V2(Max(viewMax.x, world.x), Max(viewMax.y, world.y));
+        }
+        renderer->viewMin = V2(Min(renderer->viewMin.x, viewMin.x), Min(renderer->viewMin.y, viewMin.y));
+        renderer->viewMax = V2(Max(renderer->viewMax.x, viewMax.x), Max(renderer->viewMax.y, viewMax.y));
+        v2 worldPerPixel = V2((viewMax.x - viewMin.x) / (f32)Max(platform->windowWidth, 1u), (viewMax.y - viewMin.y) / (f32)Max(platform->windowHeight, 1u));
+        renderer->worldPerPixel = V2(Max(renderer->worldPerPixel.x, worldPerPixel.x), Max(renderer->worldPerPixel.y, worldPerPixel.y));
+    }
 
-    glGenBuffers(1, &renderer->vertexBuffer);
-    assert(renderer->vertexBuffer);
+    // NOTE(swarzzy): Occlusion culling works in window pixels, so finding views which map rects to screen
+    // aligned rects with constant depth. Row N of the matrix gives N-th clip space coordinate
+    f32 halfWidth = platform->windowWidth * 0.5f;
+    f32 halfHeight = platform->windowHeight * 0.5f;
+    for (u32 view = 0; view < canvas->viewCount; view++) {
+        const m4x4* m = canvas->views + view;
+        ViewScreenMapping* mapping = renderer->screenMappings + view;
+        *mapping = {};
+        mapping->valid = m->_12 == 0.0f && m->_21 == 0.0f && m->_31 == 0.0f && m->_32 == 0.0f &&
+            m->_41 == 0.0f && m->_42 == 0.0f && m->_43 == 0.0f && m->_44 == 1.0f;
+        if (mapping->valid) {
+            mapping->scale = V2(m->_11 * halfWidth, m->_22 * halfHeight);
+            mapping->zShift = V2(m->_13 * halfWidth, m->_23 * halfHeight);
+            mapping->offset = V2(m->_14 * halfWidth + halfWidth, m->_24 * halfHeight + halfHeight);
+            mapping->depthScale = m->_33 * 0.5f;
+            mapping->depthOffset = m->_34 * 0.5f + 0.5f;
+            v4 clip = canvas->viewClips[view];
+            mapping->clipMin = V2(Max(clip.x, -1.0f) * halfWidth + halfWidth, Max(clip.y, -1.0f) * halfHeight + halfHeight);
+            mapping->clipMax = V2(Min(clip.z, 1.0f) * halfWidth + halfWidth, Min(clip.w, 1.0f) * halfHeight + halfHeight);
+        }
+    }
 
-    glGenBuffers(1, &renderer->indexBuffer);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderer->indexBuffer);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(u16) * Renderer::MaxBufferCapacity, nullptr, GL_STATIC_DRAW);
-    u16* indexData = (u16*)glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY);
+    RenderBackendGet(renderer->backendKind)->BeginFrame(renderer);
+}
 
-    static_assert((Renderer::MaxBufferCapacity % 6) == 0);
+// Finds commands which bounding boxes intersect the view bounds and writes their indices to
+// survivors in ascending order. Bounding box of a command is formed by two points located at
+// offsetA and offsetB inside the command. Returns the number of survivors.
+u32 RendererCullCommands(const RenderCommand* commands, u32 count, v2 viewMin, v2 viewMax, uptr offsetA, uptr offsetB, u32* survivors) {
+    u32 at = 0;
+    u32 i = 0;
+
+#define cull_field(index, offset, component) (((const f32*)((const u8*)(commands + (index)) + (offset)))[component])
+
+#if defined(SIMD_AVX2)
+    {
+        const int stride = (int)sizeof(RenderCommand);
+        __m256i offsets = _mm256_setr_epi32(0, stride, stride * 2, stride * 3, stride * 4, stride * 5, stride * 6, stride * 7);
+        __m256 minX = _mm256_set1_ps(viewMin.x);
+        __m256 minY = _mm256_set1_ps(viewMin.y);
+        __m256 maxX = _mm256_set1_ps(viewMax.x);
+        __m256 maxY = _mm256_set1_ps(viewMax.y);
+        for (; i + 8 <= count; i += 8) {
+            __m256 ax = _mm256_i32gather_ps(&cull_field(i, offsetA, 0), offsets, 1);
+            __m256 ay = _mm256_i32gather_ps(&cull_field(i, offsetA, 1), offsets, 1);
+            __m256 bx = _mm256_i32gather_ps(&cull_field(i, offsetB, 0), offsets, 1);
+            __m256 by = _mm256_i32gather_ps(&cull_field(i, offsetB, 1), offsets, 1);
+            __m256 visible = _mm256_and_ps(_mm256_cmp_ps(_mm256_max_ps(ax, bx), minX, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_min_ps(ax, bx), maxX, _CMP_LE_OQ));
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_max_ps(ay, by), minY, _CMP_GE_OQ));
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_min_ps(ay, by), maxY, _CMP_LE_OQ));
+            u32 mask = (u32)_mm256_movemask_ps(visible);
+            while (mask) {
+                survivors[at++] = i + FindFirstSetBit(mask);
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+
+#if defined(SIMD_SSE2)
+    {
+        __m128 minX = _mm_set1_ps(viewMin.x);
+        __m128 minY = _mm_set1_ps(viewMin.y);
+        __m128 maxX = _mm_set1_ps(viewMax.x);
+        __m128 maxY = _mm_set1_ps(viewMax.y);
+        for (; i + 4 <= count; i += 4) {
+            __m128 ax = _mm_setr_ps(cull_field(i, offsetA, 0), cull_field(i + 1, offsetA, 0), cull_field(i + 2, offsetA, 0), cull_field(i + 3, offsetA, 0));
+            __m128 ay = _mm_setr_ps(cull_field(i, offsetA, 1), cull_field(i + 1, offsetA, 1), cull_field(i + 2, offsetA, 1), cull_field(i + 3, offsetA, 1));
+            __m128 bx = _mm_setr_ps(cull_field(i, offsetB, 0), cull_field(i + 1, offsetB, 0), cull_field(i + 2, offsetB, 0), cull_field(i + 3, offsetB, 0));
+            __m128 by = _mm_setr_ps(cull_field(i, offsetB, 1), cull_field(i + 1, offsetB, 1), cull_field(i + 2, offsetB, 1), cull_field(i + 3, offsetB, 1));
+            __m128 visible = _mm_and_ps(_mm_cmpge_ps(_mm_max_ps(ax, bx), minX), _mm_cmple_ps(_mm_min_ps(ax, bx), maxX));
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_max_ps(ay, by), minY));
+            visible = _mm_and_ps(visible, _mm_cmple_ps(_mm_min_ps(ay, by), maxY));
+            u32 mask = (u32)_mm_movemask_ps(visible);
+            while (mask) {
+                survivors[at++] = i + FindFirstSetBit(mask);
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        f32 ax = cull_field(i, offsetA, 0);
+        f32 ay = cull_field(i, offsetA, 1);
+        f32 bx = cull_field(i, offsetB, 0);
+        f32 by = cull_field(i, offsetB, 1);
+        if (Max(ax, bx) >= viewMin.x && Min(ax, bx) <= viewMax.x && Max(ay, by) >= viewMin.y && Min(ay, by) <= viewMax.y) {
+            survivors[at++] = i;
+        }
+    }
 
-    usize k = 0;
-    for (usize i = 0; i < Renderer::MaxBufferCapacity; i+= 6) {
-        indexData[i + 0] = k;
-        indexData[i + 1] = k + 1;
-        indexData[i + 2] = k + 2;
-        indexData[i + 3] = k + 2;
-        indexData[i + 4] = k + 3;
-        indexData[i + 5] = k;
-        k += 4;
+#undef cull_field
+
+    return at;
+}
+
+// Places arrays of the stream at the start of the memory block. Stream is freed by deallocating ax
+void InstanceStreamSetMemory(InstanceStream* instances, f32* memory, u32 capacity) {
+    instances->capacity = capacity;
+    instances->ax = memory + capacity * 0;
+    instances->ay = memory + capacity * 1;
+    instances->bx = memory + capacity * 2;
+    instances->by = memory + capacity * 3;
+    instances->z0 = memory + capacity * 4;
+    instances->z1 = memory + capacity * 5;
+    instances->param = memory + capacity * 6;
+    instances->r = memory + capacity * 7;
+    instances->g = memory + capacity * 8;
+    instances->b = memory + capacity * 9;
+    instances->a = memory + capacity * 10;
+    instances->kind = (u32*)(memory + capacity * 11);
+    instances->view = (u32*)(memory + capacity * 12);
+    instances->uvMin = (u32*)(memory + capacity * 13);
+    instances->uvMax = (u32*)(memory + capacity * 14);
+}
+
+void RendererReserveVisible(Renderer* renderer, u32 count) {
+    InstanceStream* instances = &renderer->visible;
+    if (count > instances->capacity) {
+        if (instances->capacity) {
+            PlatformDeallocate(instances->ax, nullptr);
+        }
+
+        u32 capacity = (count + 7) & ~7u;
+        // NOTE(swarzzy): 11 arrays for instance fields, kinds, views, texture coordinates, visible
+        // indices and two arrays of sort entries in a single block
+        static_assert(sizeof(RenderSortEntry) == sizeof(f32) * 2);
+        f32* memory = (f32*)PlatformAllocate(sizeof(f32) * capacity * 20, 32, nullptr);
+        assert(memory);
+
+        InstanceStreamSetMemory(instances, memory, capacity);
+        renderer->visibleIndices = (u32*)(memory + capacity * 15);
+        renderer->shapeEntries = (RenderSortEntry*)(memory + capacity * 16);
+        renderer->shapeTempEntries = (RenderSortEntry*)(memory + capacity * 18);
     }
+}
 
-    glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+// Copies instances of the source replacing contents of the destination
+void InstanceStreamCopy(InstanceStream* dest, const InstanceStream* source) {
+    if (source->count > dest->capacity) {
+        if (dest->capacity) {
+            PlatformDeallocate(dest->ax, nullptr);
+        }
+        u32 capacity = (source->count + 7) & ~7u;
+        f32* memory = (f32*)PlatformAllocate(sizeof(f32) * capacity * 15, 32, nullptr);
+        assert(memory);
+        InstanceStreamSetMemory(dest, memory, capacity);
+    }
 
-    renderer->rectColorOpaqueShader = CompileGLSL("RectColorOpaque", ColorRectOpaqueShaderVertex, ColorRectOpaqueShaderFragment);
-    assert(renderer->rectColorOpaqueShader);
-    renderer->mvpLocation = glGetUniformLocation(renderer->rectColorOpaqueShader, "MVP");
-    assert(renderer->mvpLocation != -1);
+    usize size = sizeof(f32) * source->count;
+    memcpy(dest->ax, source->ax, size);
+    memcpy(dest->ay, source->ay, size);
+    memcpy(dest->bx, source->bx, size);
+    memcpy(dest->by, source->by, size);
+    memcpy(dest->z0, source->z0, size);
+    memcpy(dest->z1, source->z1, size);
+    memcpy(dest->param, source->param, size);
+    memcpy(dest->r, source->r, size);
+    memcpy(dest->g, source->g, size);
+    memcpy(dest->b, source->b, size);
+    memcpy(dest->a, source->a, size);
+    memcpy(dest->kind, source->kind, size);
+    memcpy(dest->view, source->view, size);
+    memcpy(dest->uvMin, source->uvMin, size);
+    memcpy(dest->uvMax, source->uvMax, size);
+    dest->count = source->count;
+    dest->opaqueCount = source->opaqueCount;
+}
 
-    renderer->lineShader = CompileGLSL("LineShader", LineShaderVertex, LineShaderFragment);
-    assert(renderer->lineShader);
-    renderer->mvpLocationLine = glGetUniformLocation(renderer->lineShader, "MVP");
-    assert(renderer->mvpLocationLine != -1);
+// Packs a pair of texture coordinates to normalized 16 bit integers
+inline u32 RendererPackUV(v2 uv) {
+    u32 u = (u32)(Saturate(uv.x) * 65535.0f + 0.5f);
+    u32 v = (u32)(Saturate(uv.y) * 65535.0f + 0.5f);
+    return u | (v << 16);
 }
 
-void RendererBeginFrame(Renderer* renderer) {
-    glClearColor(renderer->canvas.clearColor.r, renderer->canvas.clearColor.g, renderer->canvas.clearColor.b, renderer->canvas.clearColor.a);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+// Converts the command to the instance with index at in the stream
+void RendererGatherInstance(InstanceStream* instances, u32 at, const RenderCommand* command) {
+    // TODO(swarzzy): Only opaque commands supported for now. Shapes are blended only on edges
+    assert(command->transparent == false);
+    assert(command->viewIndex <= U16::Max);
+
+    u32 page = 0;
+    instances->uvMin[at] = 0;
+    instances->uvMax[at] = 0;
+
+    switch (command->type) {
+    case RenderCommandType::RectColor: {
+        instances->ax[at] = command->rectColor.min.x;
+        instances->ay[at] = command->rectColor.min.y;
+        instances->bx[at] = command->rectColor.max.x;
+        instances->by[at] = command->rectColor.max.y;
+        instances->z0[at] = command->rectColor.z;
+        instances->z1[at] = command->rectColor.z;
+        instances->param[at] = 0.0f;
+        instances->r[at] = command->rectColor.color.r;
+        instances->g[at] = command->rectColor.color.g;
+        instances->b[at] = command->rectColor.color.b;
+        instances->a[at] = command->rectColor.color.a;
+        instances->kind[at] = (u32)RenderInstanceKind::Rect;
+    } break;
+    case RenderCommandType::Line: {
+        instances->ax[at] = command->line.begin.x;
+        instances->ay[at] = command->line.begin.y;
+        instances->bx[at] = command->line.end.x;
+        instances->by[at] = command->line.end.y;
+        instances->z0[at] = command->line.begin.z;
+        instances->z1[at] = command->line.end.z;
+        instances->param[at] = command->line.thickness;
+        instances->r[at] = command->line.color.r;
+        instances->g[at] = command->line.color.g;
+        instances->b[at] = command->line.color.b;
+        instances->a[at] = command->line.color.a;
+        instances->kind[at] = (u32)RenderInstanceKind::Line;
+    } break;
+    case RenderCommandType::Circle:
+    case RenderCommandType::RoundedRect:
+    case RenderCommandType::Capsule: {
+        instances->ax[at] = command->shape.a.x;
+        instances->ay[at] = command->shape.a.y;
+        instances->bx[at] = command->shape.b.x;
+        instances->by[at] = command->shape.b.y;
+        instances->z0[at] = command->shape.z;
+        instances->z1[at] = command->shape.z;
+        instances->param[at] = command->shape.radius;
+        instances->r[at] = command->shape.color.r;
+        instances->g[at] = command->shape.color.g;
+        instances->b[at] = command->shape.color.b;
+        instances->a[at] = command->shape.color.a;
+        instances->kind[at] = (u32)(command->type == RenderCommandType::Capsule ? RenderInstanceKind::Capsule : RenderInstanceKind::RoundedRect);
+    } break;
+    case RenderCommandType::Sprite: {
+        instances->ax[at] = command->sprite.min.x;
+        instances->ay[at] = command->sprite.min.y;
+        instances->bx[at] = command->sprite.max.x;
+        instances->by[at] = command->sprite.max.y;
+        instances->z0[at] = command->sprite.z;
+        instances->z1[at] = command->sprite.z;
+        instances->param[at] = 0.0f;
+        instances->r[at] = command->sprite.color.r;
+        instances->g[at] = command->sprite.color.g;
+        instances->b[at] = command->sprite.color.b;
+        instances->a[at] = command->sprite.color.a;
+        instances->kind[at] = (u32)RenderInstanceKind::Sprite;
+        instances->uvMin[at] = RendererPackUV(command->sprite.uvMin);
+        instances->uvMax[at] = RendererPackUV(command->sprite.uvMax);
+        page = command->sprite.page;
+    } break;
+    invalid_default();
+    }
 
-    glUseProgram(renderer->rectColorOpaqueShader);
-    glUniformMatrix4fv(renderer->mvpLocation, 1, GL_FALSE, renderer->canvas.projection.data);
+    instances->view[at] = command->viewIndex | (page << 16);
+}
 
-    glUseProgram(renderer->lineShader);
-    glUniformMatrix4fv(renderer->mvpLocationLine, 1, GL_FALSE, renderer->canvas.projection.data);
+// Computes window space footprint and depth of the instance. Returns false if its view has no screen mapping
+b32 RendererInstanceFootprint(const Renderer* renderer, const InstanceStream* instances, u32 index, v2* min, v2* max, f32* depth) {
+    const ViewScreenMapping* mapping = renderer->screenMappings + (instances->view[index] & 0xffff);
+    if (!mapping->valid) {
+        return false;
+    }
 
+    f32 z = instances->z0[index];
+    v2 shift = V2(z * mapping->zShift.x + mapping->offset.x, z * mapping->zShift.y + mapping->offset.y);
+    f32 ax = instances->ax[index] * mapping->scale.x + shift.x;
+    f32 bx = instances->bx[index] * mapping->scale.x + shift.x;
+    f32 ay = instances->ay[index] * mapping->scale.y + shift.y;
+    f32 by = instances->by[index] * mapping->scale.y + shift.y;
+
+    // NOTE(swarzzy): Nothing is drawn outside of the view clip rect
+    *min = V2(Max(Min(ax, bx), mapping->clipMin.x), Max(Min(ay, by), mapping->clipMin.y));
+    *max = V2(Min(Max(ax, bx), mapping->clipMax.x), Min(Max(ay, by), mapping->clipMax.y));
+    *depth = z * mapping->depthScale + mapping->depthOffset;
+    return true;
+}
+
+// Drops rects which are completely hidden behind nearer rects. Rects are expected to be the
+// first count instances of the stream. Returns the number of rects left
+u32 RendererOcclusionCullRects(Renderer* renderer, InstanceStream* instances, u32 count) {
     const PlatformState* platform = GetPlatform();
-    glViewport(0, 0, platform->windowWidth, platform->windowHeight);
+    const u32 tileSize = Renderer::OcclusionTileSize;
+    const f32 invTileSize = 1.0f / (f32)tileSize;
+    u32 tilesX = (platform->windowWidth + tileSize - 1) / tileSize;
+    u32 tilesY = (platform->windowHeight + tileSize - 1) / tileSize;
+    u32 tileCount = tilesX * tilesY;
+    if (!tileCount || count < 2) {
+        return count;
+    }
+
+    if (tileCount > renderer->occlusionTileCapacity) {
+        if (renderer->occlusionTiles) {
+            PlatformDeallocate(renderer->occlusionTiles, nullptr);
+        }
+        renderer->occlusionTileCapacity = tileCount;
+        renderer->occlusionTiles = (f32*)PlatformAllocate(sizeof(f32) * tileCount, 0, nullptr);
+        assert(renderer->occlusionTiles);
+    }
+
+    renderer->occlusionTilesX = tilesX;
+    renderer->occlusionTilesY = tilesY;
+    f32* tiles = renderer->occlusionTiles;
+    for (u32 i = 0; i < tileCount; i++) {
+        tiles[i] = F32::Max;
+    }
+
+    // NOTE(swarzzy): Every rect is an occluder for tiles which it covers completely. Rects outside
+    // of the depth range are clipped by the GPU and can't occlude anything
+    for (u32 i = 0; i < count; i++) {
+        v2 min, max;
+        f32 depth;
+        if (RendererInstanceFootprint(renderer, instances, i, &min, &max, &depth) && depth >= 0.0f && depth <= 1.0f) {
+            i32 beginX = (i32)Ceil(min.x * invTileSize);
+            i32 beginY = (i32)Ceil(min.y * invTileSize);
+            i32 endX = Min((i32)Floor(max.x * invTileSize), (i32)tilesX);
+            i32 endY = Min((i32)Floor(max.y * invTileSize), (i32)tilesY);
+            for (i32 y = Max(beginY, 0); y < endY; y++) {
+                f32* row = tiles + y * tilesX;
+                for (i32 x = Max(beginX, 0); x < endX; x++) {
+                    row[x] = Min(row[x], depth);
+                }
+            }
+        }
+    }
+
+    // NOTE(swarzzy): Rect is hidden if every tile it touches is covered by something strictly
+    // closer, so rects never occlude themselves or rects at the same depth
+    u32 at = 0;
+    for (u32 i = 0; i < count; i++) {
+        v2 min, max;
+        f32 depth;
+        b32 occluded = false;
+        if (RendererInstanceFootprint(renderer, instances, i, &min, &max, &depth)) {
+            i32 beginX = Max((i32)Floor(min.x * invTileSize), 0);
+            i32 beginY = Max((i32)Floor(min.y * invTileSize), 0);
+            i32 endX = Min((i32)Ceil(max.x * invTileSize), (i32)tilesX);
+            i32 endY = Min((i32)Ceil(max.y * invTileSize), (i32)tilesY);
+            occluded = true;
+            for (i32 y = beginY; y < endY && occluded; y++) {
+                const f32* row = tiles + y * tilesX;
+                for (i32 x = beginX; x < endX; x++) {
+                    if (row[x] >= depth) {
+                        occluded = false;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!occluded) {
+            if (at != i) {
+                instances->ax[at] = instances->ax[i];
+                instances->ay[at] = instances->ay[i];
+                instances->bx[at] = instances->bx[i];
+                instances->by[at] = instances->by[i];
+                instances->z0[at] = instances->z0[i];
+                instances->z1[at] = instances->z1[i];
+                instances->param[at] = instances->param[i];
+                instances->r[at] = instances->r[i];
+                instances->g[at] = instances->g[i];
+                instances->b[at] = instances->b[i];
+                instances->a[at] = instances->a[i];
+                instances->kind[at] = instances->kind[i];
+                instances->view[at] = instances->view[i];
+                instances->uvMin[at] = instances->uvMin[i];
+                instances->uvMax[at] = instances->uvMax[i];
+            }
+            at++;
+        }
+    }
+
+    return at;
+}
+
+// Gathers shapes to the visible stream starting at instance at ordered back to front, so their
+// anti-aliased edges are blended correctly. Returns the number of gathered shapes
+u32 RendererGatherShapes(Renderer* renderer, const RenderCommand* shapes, u32 count, u32 at, b32 cull) {
+    u32* indices = renderer->visibleIndices + at;
+    u32 visibleCount = count;
+    if (cull) {
+        // NOTE(swarzzy): Capsule bounds are formed by its segment, so view bounds are grown by the biggest radius
+        f32 maxRadius = 0.0f;
+        for (u32 i = 0; i < count; i++) {
+            if (shapes[i].type == RenderCommandType::Capsule) {
+                maxRadius = Max(maxRadius, shapes[i].shape.radius);
+            }
+        }
+        v2 viewMin = V2(renderer->viewMin.x - maxRadius, renderer->viewMin.y - maxRadius);
+        v2 viewMax = V2(renderer->viewMax.x + maxRadius, renderer->viewMax.y + maxRadius);
+        visibleCount = RendererCullCommands(shapes, count, viewMin, viewMax, offsetof(RenderCommand, shape.a), offsetof(RenderCommand, shape.b), indices);
+    } else {
+        for (u32 i = 0; i < count; i++) {
+            indices[i] = i;
+        }
+    }
+
+    // Bigger depth goes first
+    RenderSortEntry* entries = renderer->shapeEntries;
+    for (u32 i = 0; i < visibleCount; i++) {
+        entries[i] = RenderSortEntry { ~RenderSortKeyFromDepth(shapes[indices[i]].shape.z), indices[i] };
+    }
+    RenderSortEntries(entries, renderer->shapeTempEntries, visibleCount);
+
+    for (u32 i = 0; i < visibleCount; i++) {
+        const RenderCommand* command = shapes + entries[i].index;
+        assert(command->viewIndex < renderer->canvas.viewCount);
+        RendererGatherInstance(&renderer->visible, at + i, command);
+    }
+
+    return visibleCount;
 }
 
-void RendererFlushRectQueue(Renderer* renderer, RenderQueue* queue) {
-    if (queue->rectBufferAt) {
-        glBindBuffer(GL_ARRAY_BUFFER, renderer->vertexBuffer);
-        // TODO(swarzzy): Is GL_STREAM_DRAW hint ok here?
+void RendererCullQueue(Renderer* renderer, RenderQueue* queue) {
+    renderer->stats.rectsSubmitted += queue->rectBufferAt;
+    renderer->stats.linesSubmitted += queue->lineBufferAt;
+    renderer->stats.shapesSubmitted += queue->shapeBufferAt;
+
+    // Indices are written past the end of previous command kinds, so the buffer holds all of them
+    RendererReserveVisible(renderer, queue->rectBufferAt + queue->lineBufferAt + queue->shapeBufferAt);
+    u32* indices = renderer->visibleIndices;
+
+    // Visible commands are gathered to SoA for instance expansion
+    InstanceStream* instances = &renderer->visible;
+    u32 rectCount = RendererCullCommands(queue->rectBuffer, queue->rectBufferAt, renderer->viewMin, renderer->viewMax, offsetof(RenderCommand, rectColor.min), offsetof(RenderCommand, rectColor.max), indices);
+    for (u32 i = 0; i < rectCount; i++) {
+        const RenderCommand* command = queue->rectBuffer + indices[i];
+        assert(command->viewIndex < renderer->canvas.viewCount);
+        RendererGatherInstance(instances, i, command);
+    }
 
-        glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * queue->rectBufferAt * 4, nullptr, GL_STREAM_DRAW);
-        Vertex* buffer = (Vertex*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-        assert(buffer);
+    renderer->stats.rectsCulled += queue->rectBufferAt - rectCount;
 
-        usize bufferAt = 0;
+    u32 unoccludedCount = RendererOcclusionCullRects(renderer, instances, rectCount);
+    renderer->stats.rectsOccluded += rectCount - unoccludedCount;
+    rectCount = unoccludedCount;
 
-        for (usize i = 0; i < queue->rectBufferAt; i++) {
-            auto command = queue->rectBuffer + i;
+    // NOTE(swarzzy): Lines are extruded in screen space, so view bounds are grown by half
+    // of the thickest line converted to world units
+    f32 maxThickness = 0.0f;
+    for (u32 i = 0; i < queue->lineBufferAt; i++) {
+        maxThickness = Max(maxThickness, queue->lineBuffer[i].line.thickness);
+    }
 
-            // TODO(swarzzy): Only this command supported for now
-            assert(command->type == RenderCommandType::RectColor);
-            assert(command->transparent == false);
+    v2 margin = V2(renderer->worldPerPixel.x * maxThickness * 0.5f, renderer->worldPerPixel.y * maxThickness * 0.5f);
+    v2 lineViewMin = V2(renderer->viewMin.x - margin.x, renderer->viewMin.y - margin.y);
+    v2 lineViewMax = V2(renderer->viewMax.x + margin.x, renderer->viewMax.y + margin.y);
 
-            buffer[bufferAt + 0].position = V4(command->rectColor.min, command->rectColor.z, 1.0f);
-            buffer[bufferAt + 0].color = command->rectColor.color;
+    u32* lineIndices = indices + rectCount;
+    u32 lineCount = RendererCullCommands(queue->lineBuffer, queue->lineBufferAt, lineViewMin, lineViewMax, offsetof(RenderCommand, line.begin), offsetof(RenderCommand, line.end), lineIndices);
+    for (u32 i = 0; i < lineCount; i++) {
+        const RenderCommand* command = queue->lineBuffer + lineIndices[i];
+        assert(command->viewIndex < renderer->canvas.viewCount);
+        RendererGatherInstance(instances, rectCount + i, command);
+    }
 
-            buffer[bufferAt + 1].position = V4(command->rectColor.max.x, command->rectColor.min.y, command->rectColor.z, 1.0f);
-            buffer[bufferAt + 1].color = command->rectColor.color;
+    renderer->stats.linesCulled += queue->lineBufferAt - lineCount;
 
-            buffer[bufferAt + 2].position = V4(command->rectColor.max, command->rectColor.z, 1.0f);
-            buffer[bufferAt + 2].color = command->rectColor.color;
+    instances->opaqueCount = rectCount + lineCount;
+    u32 shapeCount = RendererGatherShapes(renderer, queue->shapeBuffer, queue->shapeBufferAt, instances->opaqueCount, true);
+    instances->count = instances->opaqueCount + shapeCount;
 
-            buffer[bufferAt + 3].position = V4(command->rectColor.min.x, command->rectColor.max.y, command->rectColor.z, 1.0f);
-            buffer[bufferAt + 3].color = command->rectColor.color;
+    renderer->stats.shapesCulled += queue->shapeBufferAt - shapeCount;
+}
 
-            bufferAt += 4;
+// Writes an instance record for every instance in [begin, end). Buffer points to the record of the instance begin
+void RendererExpandInstances(const InstanceStream* instances, RenderInstance* buffer, u32 begin, u32 end) {
+    u32 i = begin;
+    buffer -= begin;
+
+#if defined(SIMD_SSE2)
+    static_assert(sizeof(RenderInstance) == 64);
+    // NOTE(swarzzy): Mapped buffer memory is never read back by the CPU, so using non-temporal
+    // stores to write full instances without polluting the cache. SoA arrays are aligned and
+    // begin is always a multiple of 4
+    if (((uptr)buffer % 32) == 0 && (begin % 4) == 0) {
+        __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= end; i += 4) {
+            // Transposing 4 instances to rows. shape[k] is the shape of the instance k
+            __m128 shape[4] = { _mm_load_ps(instances->ax + i), _mm_load_ps(instances->ay + i), _mm_load_ps(instances->bx + i), _mm_load_ps(instances->by + i) };
+            __m128 params[4] = { _mm_load_ps(instances->z0 + i), _mm_load_ps(instances->z1 + i), _mm_load_ps(instances->param + i), zero };
+            __m128 color[4] = { _mm_load_ps(instances->r + i), _mm_load_ps(instances->g + i), _mm_load_ps(instances->b + i), _mm_load_ps(instances->a + i) };
+            __m128 kind[4] = { _mm_load_ps((const f32*)instances->kind + i), _mm_load_ps((const f32*)instances->view + i), _mm_load_ps((const f32*)instances->uvMin + i), _mm_load_ps((const f32*)instances->uvMax + i) };
+
+            _MM_TRANSPOSE4_PS(shape[0], shape[1], shape[2], shape[3]);
+            _MM_TRANSPOSE4_PS(params[0], params[1], params[2], params[3]);
+            _MM_TRANSPOSE4_PS(color[0], color[1], color[2], color[3]);
+            _MM_TRANSPOSE4_PS(kind[0], kind[1], kind[2], kind[3]);
+
+            for (u32 k = 0; k < 4; k++) {
+                f32* dest = (f32*)(buffer + i + k);
+#if defined(SIMD_AVX2)
+                _mm256_stream_ps(dest, _mm256_set_m128(params[k], shape[k]));
+                _mm256_stream_ps(dest + 8, _mm256_set_m128(kind[k], color[k]));
+#else
+                _mm_stream_ps(dest, shape[k]);
+                _mm_stream_ps(dest + 4, params[k]);
+                _mm_stream_ps(dest + 8, color[k]);
+                _mm_stream_ps(dest + 12, kind[k]);
+#endif
+            }
         }
-        glUnmapBuffer(GL_ARRAY_BUFFER);
+        _mm_sfence();
+    }
+#endif
+
+    for (; i < end; i++) {
+        RenderInstance* dest = buffer + i;
+        dest->shape = V4(instances->ax[i], instances->ay[i], instances->bx[i], instances->by[i]);
+        dest->params = V4(instances->z0[i], instances->z1[i], instances->param[i], 0.0f);
+        dest->color = V4(instances->r[i], instances->g[i], instances->b[i], instances->a[i]);
+        dest->kind = (RenderInstanceKind)instances->kind[i];
+        dest->viewIndex = (u16)(instances->view[i] & 0xffff);
+        dest->page = (u16)(instances->view[i] >> 16);
+        dest->uvMin[0] = (u16)(instances->uvMin[i] & 0xffff);
+        dest->uvMin[1] = (u16)(instances->uvMin[i] >> 16);
+        dest->uvMax[0] = (u16)(instances->uvMax[i] & 0xffff);
+        dest->uvMax[1] = (u16)(instances->uvMax[i] >> 16);
+    }
+}
 
-        glEnableVertexAttribArray(0);
-        glEnableVertexAttribArray(1);
+void RendererExpandInstancesJob(void* data, u32 threadIndex) {
+    auto job = (InstanceExpandJob*)data;
+    RendererExpandInstances(job->instances, job->buffer, job->begin, job->end);
+}
+
+// Same as RendererExpandInstances but splits big ranges across worker threads. Begin should be a multiple of 4
+void RendererExpandInstancesParallel(Renderer* renderer, const InstanceStream* instances, RenderInstance* buffer, u32 begin, u32 end) {
+    u32 count = end - begin;
+    if (count > Renderer::InstancesPerExpandJob) {
+        // NOTE(swarzzy): Every job writes its own range of the buffer. Job size is kept
+        // multiple of 4 so SIMD loads stay aligned
+        u32 jobCount = Min((count + Renderer::InstancesPerExpandJob - 1) / Renderer::InstancesPerExpandJob, Renderer::MaxExpandJobs);
+        u32 instancesPerJob = (((count + jobCount - 1) / jobCount) + 3) & ~3u;
+        for (u32 i = 0; i < jobCount; i++) {
+            InstanceExpandJob* job = renderer->expandJobs + i;
+            job->instances = instances;
+            job->begin = Min(begin + i * instancesPerJob, end);
+            job->end = Min(job->begin + instancesPerJob, end);
+            job->buffer = buffer + (job->begin - begin);
+            PlatformPushWork(RendererExpandInstancesJob, job);
+        }
+        PlatformCompleteAllWork();
+    } else {
+        RendererExpandInstances(instances, buffer, begin, end);
+    }
+}
 
-        glVertexAttribPointer(0, 4, GL_FLOAT, false, sizeof(Vertex), 0);
-        glVertexAttribPointer(1, 4, GL_FLOAT, false, sizeof(Vertex), (void*)sizeof(v4));
+// Expands instances of the stream to the buffer object replacing its contents
+void RendererUploadInstances(Renderer* renderer, GLuint buffer, const InstanceStream* instances, GLenum usage) {
+    GLStateBindBuffer(&renderer->glState, GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(RenderInstance) * instances->count, nullptr, usage);
+    RenderInstance* data = (RenderInstance*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+    assert(data);
+    RendererExpandInstancesParallel(renderer, instances, data, 0, instances->count);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    renderer->stats.bytesUploaded += sizeof(RenderInstance) * instances->count;
+}
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderer->indexBuffer);
-        glUseProgram(renderer->rectColorOpaqueShader);
+// Draws count instances stored in the buffer object starting at instance first
+void RendererDrawInstanceRange(Renderer* renderer, GLuint buffer, u32 first, u32 count) {
+    GLStateCache* state = &renderer->glState;
+    GLStateBindBuffer(state, GL_ARRAY_BUFFER, buffer);
 
-        glDrawElements(GL_TRIANGLES, queue->rectBufferAt * 6, GL_UNSIGNED_SHORT, 0);
+    for (u32 i = 0; i < Renderer::InstanceAttribCount; i++) {
+        GLStateEnableVertexAttribArray(state, i);
     }
-}
 
-void RendererFlushLineQueue(Renderer* renderer, RenderQueue* queue) {
-    if (queue->lineBufferAt) {
-        glBindBuffer(GL_ARRAY_BUFFER, renderer->vertexBuffer);
-        // TODO(swarzzy): Is GL_STREAM_DRAW hint ok here?
-        glBufferData(GL_ARRAY_BUFFER, sizeof(LineVertex) * queue->lineBufferAt * 2, nullptr, GL_STREAM_DRAW);
-        Vertex* buffer = (Vertex*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-        assert(buffer);
+    // NOTE(swarzzy): No base instance in GL 3.3, so the first instance is selected by attribute offsets
+    uptr base = sizeof(RenderInstance) * first;
+    GLStateVertexAttribPointer(state, 0, 4, GL_FLOAT, false, sizeof(RenderInstance), (void*)(base + offsetof(RenderInstance, shape)));
+    GLStateVertexAttribPointer(state, 1, 4, GL_FLOAT, false, sizeof(RenderInstance), (void*)(base + offsetof(RenderInstance, params)));
+    GLStateVertexAttribPointer(state, 2, 4, GL_FLOAT, false, sizeof(RenderInstance), (void*)(base + offsetof(RenderInstance, color)));
+    GLStateVertexAttribIPointer(state, 3, 1, GL_UNSIGNED_INT, sizeof(RenderInstance), (void*)(base + offsetof(RenderInstance, kind)));
+    GLStateVertexAttribIPointer(state, 4, 1, GL_UNSIGNED_SHORT, sizeof(RenderInstance), (void*)(base + offsetof(RenderInstance, viewIndex)));
+    GLStateVertexAttribIPointer(state, 5, 1, GL_UNSIGNED_SHORT, sizeof(RenderInstance), (void*)(base + offsetof(RenderInstance, page)));
+    GLStateVertexAttribPointer(state, 6, 4, GL_UNSIGNED_SHORT, true, sizeof(RenderInstance), (void*)(base + offsetof(RenderInstance, uvMin)));
 
-        usize bufferAt = 0;
+    GLStateUseProgram(state, renderer->uberShader);
 
-        for (usize i = 0; i < queue->lineBufferAt; i++) {
-            auto command = queue->lineBuffer + i;
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+    renderer->stats.drawCalls++;
+}
 
-            // TODO(swarzzy): Only this command supported for now
-            assert(command->type == RenderCommandType::Line);
-            assert(command->transparent == false);
+// Draws opaque instances and then blended ones
+void RendererDrawInstances(Renderer* renderer, GLuint buffer, u32 opaqueCount, u32 count) {
+    if (opaqueCount) {
+        RendererDrawInstanceRange(renderer, buffer, 0, opaqueCount);
+    }
+    if (count > opaqueCount) {
+        GLStateEnable(&renderer->glState, GL_BLEND);
+        // NOTE(swarzzy): Alpha is accumulated separately so layer textures end up premultiplied
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        // NOTE(swarzzy): Sprites are blended, so the atlas is needed only here
+        if (renderer->atlas.texture) {
+            glActiveTexture(GL_TEXTURE0 + Renderer::AtlasTextureUnit);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, renderer->atlas.texture);
+            glActiveTexture(GL_TEXTURE0);
+        }
+        RendererDrawInstanceRange(renderer, buffer, opaqueCount, count - opaqueCount);
+        GLStateDisable(&renderer->glState, GL_BLEND);
+    }
+}
 
-            buffer[bufferAt + 0].position = V4(command->line.begin, 1.0f);
-            buffer[bufferAt + 0].color = command->line.color;
+u64 RendererHashInstanceBlock(const InstanceStream* instances, u32 begin, u32 end) {
+    usize size = sizeof(f32) * (end - begin);
+    u64 hash = 0;
+    hash = HashBytes(instances->ax + begin, size, hash);
+    hash = HashBytes(instances->ay + begin, size, hash);
+    hash = HashBytes(instances->bx + begin, size, hash);
+    hash = HashBytes(instances->by + begin, size, hash);
+    hash = HashBytes(instances->z0 + begin, size, hash);
+    hash = HashBytes(instances->z1 + begin, size, hash);
+    hash = HashBytes(instances->param + begin, size, hash);
+    hash = HashBytes(instances->r + begin, size, hash);
+    hash = HashBytes(instances->g + begin, size, hash);
+    hash = HashBytes(instances->b + begin, size, hash);
+    hash = HashBytes(instances->a + begin, size, hash);
+    hash = HashBytes(instances->kind + begin, size, hash);
+    hash = HashBytes(instances->view + begin, size, hash);
+    hash = HashBytes(instances->uvMin + begin, size, hash);
+    hash = HashBytes(instances->uvMax + begin, size, hash);
+    return hash;
+}
 
-            buffer[bufferAt + 1].position = V4(command->line.end, 1.0f);
-            buffer[bufferAt + 1].color = command->line.color;
+// Uploads only blocks of the visible stream which changed since the last frame
+void RendererUploadDirtyInstances(Renderer* renderer) {
+    const InstanceStream* instances = &renderer->visible;
+    const u32 blockSize = Renderer::InstancesPerHashBlock;
+    u32 blockCount = (instances->count + blockSize - 1) / blockSize;
 
-            bufferAt += 2;
+    if (blockCount > renderer->blockHashCapacity) {
+        if (renderer->blockHashes) {
+            PlatformDeallocate(renderer->blockHashes, nullptr);
         }
+        renderer->blockHashCapacity = NextPowerOfTwo(blockCount);
+        renderer->blockHashes = (u64*)PlatformAllocate(sizeof(u64) * renderer->blockHashCapacity, 0, nullptr);
+        assert(renderer->blockHashes);
+        renderer->blockHashCount = 0;
+    }
 
-        glUnmapBuffer(GL_ARRAY_BUFFER);
+    if (instances->count > renderer->instanceBufferCapacity) {
+        // NOTE(swarzzy): Buffer storage is reallocated, so previous contents are lost
+        renderer->instanceBufferCapacity = Max(NextPowerOfTwo(instances->count), blockSize);
+        GLStateBindBuffer(&renderer->glState, GL_ARRAY_BUFFER, renderer->instanceBuffer);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(RenderInstance) * renderer->instanceBufferCapacity, nullptr, GL_DYNAMIC_DRAW);
+        renderer->blockHashCount = 0;
+    }
 
-        glEnableVertexAttribArray(0);
-        glEnableVertexAttribArray(1);
+    u32 dirtyBegin = 0;
+    u32 dirtyCount = 0;
+    u32 uploaded = 0;
+    for (u32 block = 0; block <= blockCount; block++) {
+        b32 dirty = false;
+        if (block < blockCount) {
+            u32 begin = block * blockSize;
+            u32 end = Min(begin + blockSize, instances->count);
+            u64 hash = RendererHashInstanceBlock(instances, begin, end);
+            dirty = block >= renderer->blockHashCount || renderer->blockHashes[block] != hash;
+            renderer->blockHashes[block] = hash;
+        }
 
-        glVertexAttribPointer(0, 4, GL_FLOAT, false, sizeof(Vertex), 0);
-        glVertexAttribPointer(1, 4, GL_FLOAT, false, sizeof(Vertex), (void*)sizeof(v4));
+        if (dirty) {
+            if (!dirtyCount) {
+                dirtyBegin = block;
+            }
+            dirtyCount++;
+        } else if (dirtyCount) {
+            // NOTE(swarzzy): Uploading a run of adjacent dirty blocks at once. Invalidating the range
+            // lets the driver avoid waiting for the previous frame which still reads the buffer
+            u32 begin = dirtyBegin * blockSize;
+            u32 end = Min((dirtyBegin + dirtyCount) * blockSize, instances->count);
+            GLStateBindBuffer(&renderer->glState, GL_ARRAY_BUFFER, renderer->instanceBuffer);
+            RenderInstance* data = (RenderInstance*)glMapBufferRange(GL_ARRAY_BUFFER, sizeof(RenderInstance) * begin, sizeof(RenderInstance) * (end - begin), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+            assert(data);
+            RendererExpandInstancesParallel(renderer, instances, data, begin, end);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            renderer->stats.bytesUploaded += sizeof(RenderInstance) * (end - begin);
+            uploaded += dirtyCount;
+            dirtyCount = 0;
+        }
+    }
+
+    renderer->stats.blocksUploaded += uploaded;
+    renderer->stats.blocksSkipped += blockCount - uploaded;
+    renderer->blockHashCount = blockCount;
+}
+
+void RenderBackendGLSubmitBatch(Renderer* renderer, const RenderBackendBatch* batch) {
+    RenderBatch* retained = batch->retained;
+    if (retained) {
+        // NOTE(swarzzy): Batch is uploaded when it is drawn for the first time after it was built,
+        // so other backends never touch GL for it
+        if (!retained->uploaded) {
+            if (!retained->buffer) {
+                glGenBuffers(1, &retained->buffer);
+                assert(retained->buffer);
+            }
+            RendererUploadInstances(renderer, retained->buffer, batch->instances, retained->usage);
+            retained->uploaded = true;
+        }
+        RendererDrawInstances(renderer, retained->buffer, batch->opaqueCount, batch->count);
+    } else {
+        // NOTE(swarzzy): Dirty blocks are tracked only for the visible stream
+        assert(batch->instances == &renderer->visible);
+        // NOTE(swarzzy): The frame is cleared every time, so the draw itself can't be skipped
+        // even if nothing changed. Only the upload is
+        RendererUploadDirtyInstances(renderer);
+        RendererDrawInstances(renderer, renderer->instanceBuffer, batch->opaqueCount, batch->count);
+    }
+}
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-        glUseProgram(renderer->lineShader);
+void RenderBackendGLEndFrame(Renderer* renderer) {
+    renderer->stats.glCallsIssued = renderer->glState.callsIssued;
+    renderer->stats.glCallsElided = renderer->glState.callsElided;
+}
 
-        glDrawArrays(GL_LINES, 0, queue->lineBufferAt * 2);
+void RendererFlushInstances(Renderer* renderer) {
+    const InstanceStream* instances = &renderer->visible;
+    if (instances->count) {
+        RenderBackendBatch batch = { instances, nullptr, instances->opaqueCount, instances->count };
+        RenderBackendGet(renderer->backendKind)->SubmitBatch(renderer, &batch);
     }
 }
 
 void RendererDraw(Renderer* renderer, RenderQueue* queue) {
-    RendererFlushRectQueue(renderer, queue);
-    RendererFlushLineQueue(renderer, queue);
+    RendererCullQueue(renderer, queue);
+    RendererFlushInstances(renderer);
 }
 
-void RendererEndFrame(Renderer* renderer) {
+void RenderBatchBuild(Renderer* renderer, RenderBatch* batch, const RenderQueue* commands, GLenum usage) {
+    // NOTE(swarzzy): Batches are not culled since they are drawn for many frames with any view.
+    // Instances are gathered through the same stream as per-frame commands, so a batch must not
+    // be built in between RendererCullQueue and RendererFlushInstances
+    u32 count = commands->rectBufferAt + commands->lineBufferAt + commands->shapeBufferAt;
+    RendererReserveVisible(renderer, count);
+    InstanceStream* instances = &renderer->visible;
+    for (u32 i = 0; i < commands->rectBufferAt; i++) {
+        RendererGatherInstance(instances, i, commands->rectBuffer + i);
+    }
+    for (u32 i = 0; i < commands->lineBufferAt; i++) {
+        RendererGatherInstance(instances, commands->rectBufferAt + i, commands->lineBuffer + i);
+    }
+    instances->opaqueCount = commands->rectBufferAt + commands->lineBufferAt;
+    RendererGatherShapes(renderer, commands->shapeBuffer, commands->shapeBufferAt, instances->opaqueCount, false);
+    instances->count = count;
+
+    InstanceStreamCopy(&batch->instances, instances);
+    batch->usage = usage;
+    batch->instanceCount = count;
+    batch->opaqueCount = instances->opaqueCount;
+    batch->valid = true;
+    batch->uploaded = false;
+    instances->count = 0;
 }
 
-GLuint CompileGLSL(const char* name, const char* vertexSource, const char* fragmentSource) {
-    GLuint resultHandle = 0;
-
-    GLuint vertexHandle = glCreateShader(GL_VERTEX_SHADER);
-    if (vertexHandle) {
-        glShaderSource(vertexHandle, 1, &vertexSource, nullptr);
-        glCompileShader(vertexHandle);
-
-        GLint vertexResult = 0;
-        glGetShaderiv(vertexHandle, GL_COMPILE_STATUS, &vertexResult);
-        if (vertexResult) {
-            GLuint fragmentHandle;
-            fragmentHandle = glCreateShader(GL_FRAGMENT_SHADER);
-            if (fragmentHandle) {
-                glShaderSource(fragmentHandle, 1, &fragmentSource, nullptr);
-                glCompileShader(fragmentHandle);
-
-                GLint fragmentResult = 0;
-                glGetShaderiv(fragmentHandle, GL_COMPILE_STATUS, &fragmentResult);
-                if (fragmentResult) {
-                    GLint programHandle;
-                    programHandle = glCreateProgram();
-                    if (programHandle) {
-                        glAttachShader(programHandle, vertexHandle);
-                        glAttachShader(programHandle, fragmentHandle);
-                        glLinkProgram(programHandle);
-
-                        GLint linkResult = 0;
-                        glGetProgramiv(programHandle, GL_LINK_STATUS, &linkResult);
-                        if (linkResult) {
-                            glDeleteShader(vertexHandle);
-                            glDeleteShader(fragmentHandle);
-                            resultHandle = programHandle;
-                        } else {
-                            i32 logLength;
-                            glGetProgramiv(programHandle, GL_INFO_LOG_LENGTH, &logLength);
-                            char* message = (char*)PlatformAllocate(logLength, 0, nullptr);
-                            glGetProgramInfoLog(programHandle, logLength, 0, message);
-                            log_print("[Error]: Failed to link shader program (%s) \n%s\n", name, message);
-                            PlatformDeallocate(message, nullptr);
-                        }
-                    } else {
-                        log_print("Failed to create shader program\n");
-                    }
-                } else {
-                    GLint logLength;
-                    glGetShaderiv(fragmentHandle, GL_INFO_LOG_LENGTH, &logLength);
-                    char* message = (char*)PlatformAllocate(logLength, 0, nullptr);
-                    glGetShaderInfoLog(fragmentHandle, logLength, nullptr, message);
-                    log_print("[Error]: Failed to compile frag shader (%s)\n%s\n", name, message);
-                    PlatformDeallocate(message, nullptr);
-                }
-            } else {
-                log_print("Failed to create fragment shader\n");
+void RenderBatchInvalidate(RenderBatch* batch) {
+    batch->valid = false;
+}
+
+void RenderBatchRelease(Renderer* renderer, RenderBatch* batch) {
+    if (batch->buffer) {
+        // NOTE(swarzzy): Deleted buffer gets unbound by GL, so the cached binding is not valid anymore
+        if (renderer->glState.arrayBuffer == batch->buffer) {
+            renderer->glState.arrayBuffer = GLStateCache::Unknown;
+        }
+        glDeleteBuffers(1, &batch->buffer);
+    }
+    if (batch->instances.capacity) {
+        PlatformDeallocate(batch->instances.ax, nullptr);
+    }
+    *batch = {};
+}
+
+void RendererDrawBatch(Renderer* renderer, RenderBatch* batch) {
+    assert(batch->valid);
+    if (batch->instanceCount) {
+        RenderBackendBatch submission = { &batch->instances, batch, batch->opaqueCount, batch->instanceCount };
+        RenderBackendGet(renderer->backendKind)->SubmitBatch(renderer, &submission);
+        renderer->stats.batchesDrawn++;
+        renderer->stats.batchInstancesDrawn += batch->instanceCount;
+    }
+}
+
+RenderLayer* RendererGetLayer(Renderer* renderer, const char* name, f32 depth) {
+    for (u32 i = 0; i < renderer->layerCount; i++) {
+        RenderLayer* layer = renderer->layers + i;
+        if (strncmp(layer->name, name, RenderLayer::MaxNameLength) == 0) {
+            return layer;
+        }
+    }
+
+    assert(renderer->layerCount < Renderer::MaxLayers);
+    RenderLayer* layer = renderer->layers + renderer->layerCount++;
+    *layer = {};
+    strncpy(layer->name, name, RenderLayer::MaxNameLength - 1);
+    layer->depth = depth;
+    layer->visible = true;
+    layer->dirty = true;
+    return layer;
+}
+
+void RenderLayerInvalidate(RenderLayer* layer) {
+    layer->dirty = true;
+}
+
+// Makes the layer targets match the window size
+void RendererResizeLayer(RenderLayer* layer, u32 width, u32 height) {
+    if (!layer->framebuffer) {
+        glGenFramebuffers(1, &layer->framebuffer);
+        glGenTextures(1, &layer->colorTexture);
+        glGenRenderbuffers(1, &layer->depthBuffer);
+        assert(layer->framebuffer && layer->colorTexture && layer->depthBuffer);
+    }
+
+    if (layer->width != width || layer->height != height) {
+        layer->width = width;
+        layer->height = height;
+        layer->dirty = true;
+
+        // NOTE(swarzzy): Layers are composited 1:1 with the screen, so no filtering is needed
+        glBindTexture(GL_TEXTURE_2D, layer->colorTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, layer->depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, layer->framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, layer->colorTexture, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, layer->depthBuffer);
+        assert(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+}
+
+void RendererDrawLayer(Renderer* renderer, RenderLayer* layer, RenderQueue* queue) {
+    if (renderer->backendKind != RenderBackendKind::GL) {
+        return;
+    }
+
+    const PlatformState* platform = GetPlatform();
+    u32 width = Max(platform->windowWidth, 1u);
+    u32 height = Max(platform->windowHeight, 1u);
+    RendererResizeLayer(layer, width, height);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, layer->framebuffer);
+    glViewport(0, 0, width, height);
+    // NOTE(swarzzy): Zero alpha marks pixels which are not covered by the layer
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // NOTE(swarzzy): Going through the visible stream but not through dirty block tracking,
+    // so hashes of per-frame instances stay valid
+    RendererCullQueue(renderer, queue);
+    const InstanceStream* instances = &renderer->visible;
+    if (instances->count) {
+        RendererUploadInstances(renderer, renderer->layerInstanceBuffer, instances, GL_STREAM_DRAW);
+        RendererDrawInstances(renderer, renderer->layerInstanceBuffer, instances->opaqueCount, instances->count);
+    }
+    renderer->visible.count = 0;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, platform->windowWidth, platform->windowHeight);
+
+    layer->dirty = false;
+    renderer->stats.layersRendered++;
+}
+
+void RendererCompositeLayers(Renderer* renderer) {
+    if (renderer->backendKind != RenderBackendKind::GL) {
+        return;
+    }
+
+    GLStateCache* state = &renderer->glState;
+    const PlatformState* platform = GetPlatform();
+
+    b32 bound = false;
+    for (u32 i = 0; i < renderer->layerCount; i++) {
+        RenderLayer* layer = renderer->layers + i;
+        // NOTE(swarzzy): Layer which was never drawn or was drawn for another window size has no valid contents
+        if (!layer->visible || !layer->framebuffer || layer->width != platform->windowWidth || layer->height != platform->windowHeight) {
+            continue;
+        }
+
+        if (!bound) {
+            // NOTE(swarzzy): Composite shader has no inputs, so instance attributes must not be fetched
+            for (u32 attrib = 0; attrib < Renderer::InstanceAttribCount; attrib++) {
+                GLStateDisableVertexAttribArray(state, attrib);
             }
-        } else {
-            GLint logLength;
-            glGetShaderiv(vertexHandle, GL_INFO_LOG_LENGTH, &logLength);
-            char* message = (char*)PlatformAllocate(logLength, 0, nullptr);
-            glGetShaderInfoLog(vertexHandle, logLength, nullptr, message);
-            log_print("[Error]: Failed to compile vertex shader (%s)\n%s", name, message);
-            PlatformDeallocate(message, nullptr);
+            GLStateUseProgram(state, renderer->compositeShader);
+            // NOTE(swarzzy): Layer contents are premultiplied
+            GLStateEnable(state, GL_BLEND);
+            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            glActiveTexture(GL_TEXTURE0);
+            glUniform1i(renderer->compositeTextureLocation, 0);
+            bound = true;
         }
-    } else {
-        log_print("Falled to create vertex shader\n");
+
+        glBindTexture(GL_TEXTURE_2D, layer->colorTexture);
+        glUniform1f(renderer->compositeDepthLocation, layer->depth);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        renderer->stats.drawCalls++;
+        renderer->stats.layersComposited++;
+    }
+
+    if (bound) {
+        GLStateDisable(state, GL_BLEND);
     }
-    return resultHandle;
+}
+
+void RendererEndFrame(Renderer* renderer) {
+    RenderBackendGet(renderer->backendKind)->EndFrame(renderer);
 }
@@ -1,27 +1,268 @@
 #pragma once
 
 #include "RenderQueue.h"
+#include "GLState.h"
+#include "TextureAtlas.h"
+#include "ShaderCache.h"
+#include "ShaderReload.h"
+#include "RenderBackend.h"
 
 struct Canvas {
-    m4x4 projection;
+    static const u32 MaxViews = 8;
+    // NOTE: Commands select a view by RenderCommand::viewIndex. Every view has its own
+    // view-projection matrix and NDC rect (min.xy, max.xy) which its geometry is clipped to,
+    // so split-screen, world and UI layers all go in one draw call
+    u32 viewCount;
+    m4x4 views[MaxViews];
+    v4 viewClips[MaxViews];
     v4 clearColor;
 };
 
+// Sets view-projection matrix of the view and makes it cover the whole screen
+void CanvasSetView(Canvas* canvas, u32 index, m4x4 viewProjection);
+// Restricts the view to the NDC rect
+void CanvasSetViewClip(Canvas* canvas, u32 index, v2 clipMin, v2 clipMax);
+
+// NOTE: Layout of the per-frame uniform block (std140) shared by all programs
+struct FrameUniforms {
+    m4x4 viewProjections[Canvas::MaxViews];
+    v4 viewClips[Canvas::MaxViews];
+    v2 viewportSize;
+    v2 _pad;
+};
+
+struct RendererStats {
+    u32 rectsSubmitted;
+    u32 rectsCulled;
+    u32 linesSubmitted;
+    u32 linesCulled;
+    // State changes that went to the driver and ones skipped by the state cache
+    u32 glCallsIssued;
+    u32 glCallsElided;
+    u32 batchesDrawn;
+    u32 batchInstancesDrawn;
+    // Hash blocks of per-frame instances which were re-uploaded and which were left as is
+    u32 blocksUploaded;
+    u32 blocksSkipped;
+    u32 layersRendered;
+    u32 layersComposited;
+    // Rects fully hidden behind nearer opaque rects
+    u32 rectsOccluded;
+    u32 shapesSubmitted;
+    u32 shapesCulled;
+    // Texture bytes streamed this frame and uploads still waiting
+    u32 textureBytesStreamed;
+    u32 textureUploadsPending;
+    u32 drawCalls;
+    // Instances, uniforms and textures
+    u32 bytesUploaded;
+};
+
+enum struct RenderInstanceKind : u32 {
+    Rect = 0, Line = 1, RoundedRect = 2, Capsule = 3, Sprite = 4
+};
+
+// NOTE: Per-instance record consumed by the uber-shader. Every instance is drawn as a single quad
+struct RenderInstance {
+    // Rect, rounded rect and sprite: min.xy, max.xy. Line and capsule: begin.xy, end.xy
+    v4 shape;
+    // z of the first point, z of the second point, line thickness in pixels or shape radius, unused
+    v4 params;
+    v4 color;
+    RenderInstanceKind kind;
+    u16 viewIndex;
+    // Atlas page of a sprite
+    u16 page;
+    // Sprite texture coordinates as normalized 16 bit integers
+    u16 uvMin[2];
+    u16 uvMax[2];
+};
+
+// NOTE: Visible instances in SoA layout. Arrays are 32 byte aligned and padded to a multiple of 8.
+// Opaque instances go first, shapes with anti-aliased edges are blended so they go after them
+// sorted back to front
+struct InstanceStream {
+    u32 count;
+    u32 opaqueCount;
+    u32 capacity;
+    f32* ax;
+    f32* ay;
+    f32* bx;
+    f32* by;
+    f32* z0;
+    f32* z1;
+    f32* param;
+    f32* r;
+    f32* g;
+    f32* b;
+    f32* a;
+    u32* kind;
+    // View index in low 16 bits, atlas page in high 16 bits
+    u32* view;
+    // Packed pairs of normalized 16 bit texture coordinates
+    u32* uvMin;
+    u32* uvMax;
+};
+
+// NOTE: Offscreen layer with the size of the window. Its contents are redrawn only when the
+// layer is dirty and are composited to the screen every frame
+struct RenderLayer {
+    static const u32 MaxNameLength = 32;
+    char name[MaxNameLength];
+    // Depth in [0, 1] the layer is composited at, smaller is closer. For the default
+    // orthographic projection it matches z of commands
+    f32 depth;
+    b32 visible;
+    b32 dirty;
+    u32 width;
+    u32 height;
+    GLuint framebuffer;
+    GLuint colorTexture;
+    GLuint depthBuffer;
+};
+
+// NOTE: Maps world space of a view to window pixels and depth. Only exists for views which keep
+// rects axis aligned and which depth does not depend on x and y, like the orthographic projection
+struct ViewScreenMapping {
+    b32 valid;
+    // pixel = world * scale + z * zShift + offset
+    v2 scale;
+    v2 zShift;
+    v2 offset;
+    // depth = z * depthScale + depthOffset, window depth in [0, 1], smaller is closer
+    f32 depthScale;
+    f32 depthOffset;
+    // View clip rect in pixels
+    v2 clipMin;
+    v2 clipMax;
+};
+
+struct InstanceExpandJob {
+    const InstanceStream* instances;
+    RenderInstance* buffer;
+    u32 begin;
+    u32 end;
+};
+
 struct Renderer {
-    // Should be less than or equal to 2^16 and multiple of 6
-    static const u32 MaxBufferCapacity = 1536;
+    // Instance expansion is split across worker threads for queues bigger than this
+    static const u32 InstancesPerExpandJob = 4096;
+    static const u32 MaxExpandJobs = 64;
+    static const GLuint FrameUniformsBinding = 0;
+    static const u32 InstancesPerHashBlock = 64;
+    static const u32 MaxLayers = 16;
+    static const u32 OcclusionTileSize = 16;
+    static const u32 InstanceAttribCount = 7;
+    static const u32 AtlasTextureUnit = 1;
+    // NOTE: Relative to the working directory, which is the build directory
+    static constexpr const char* ShaderDirectory = "../src/shaders/";
+    // Shader files are checked for changes once in this number of frames. Static build does not watch them
+    static const u32 ShaderWatchInterval = 30;
 
     Canvas canvas;
 
-    GLuint rectColorOpaqueShader;
-    GLuint lineShader;
-    GLuint vertexBuffer;
-    GLuint indexBuffer;
-    GLint mvpLocation;
-    GLint mvpLocationLine;
+    // NOTE: Frames go to this backend. GL objects are created by RendererInit whichever backend is used and
+    // batches are uploaded by the GL backend once it draws them, so the backend can be switched any time between
+    // frames. Only the kind is kept, because the backend table lives in the game library and moves when it is reloaded
+    RenderBackendKind backendKind;
+    RenderCountingBackend counting;
+
+    // World space bounds of the union of all view volumes. Updated in RendererBeginFrame
+    v2 viewMin;
+    v2 viewMax;
+    // Largest size of a pixel in world units among all views
+    v2 worldPerPixel;
+    ViewScreenMapping screenMappings[Canvas::MaxViews];
+
+    // NOTE: Coarse screen space coverage buffer for occlusion culling. Every tile holds depth
+    // of the nearest rect which covers the whole tile
+    u32 occlusionTilesX;
+    u32 occlusionTilesY;
+    u32 occlusionTileCapacity;
+    f32* occlusionTiles;
+
+    RendererStats stats;
+
+    GLStateCache glState;
+
+    InstanceStream visible;
+    // Indices of commands which survived culling
+    u32* visibleIndices;
+    // Scratch for ordering blended shapes
+    RenderSortEntry* shapeEntries;
+    RenderSortEntry* shapeTempEntries;
+    InstanceExpandJob expandJobs[MaxExpandJobs];
+
+    // Sprites of all images come from here
+    TextureAtlas atlas;
+    TextureStream textureStream;
+
+    ShaderCache shaderCache;
+    ShaderSource uberShaderSource;
+    ShaderSource compositeShaderSource;
+    u32 shaderWatchCountdown;
+    // NOTE: Rects and lines are drawn by the same shader in a single instanced draw call
+    GLuint uberShader;
+    GLuint instanceBuffer;
+    u32 instanceBufferCapacity;
+
+    // NOTE: Hashes of the instances uploaded last frame, one per InstancesPerHashBlock instances.
+    // Only blocks which hash differently get expanded and uploaded again
+    u32 blockHashCount;
+    u32 blockHashCapacity;
+    u64* blockHashes;
+    // Stays bound to FrameUniformsBinding for the whole lifetime of the renderer
+    GLuint frameUniformBuffer;
+
+    u32 layerCount;
+    RenderLayer layers[MaxLayers];
+    // Layers are redrawn rarely, so they don't go through dirty block tracking
+    GLuint layerInstanceBuffer;
+    GLuint compositeShader;
+    GLint compositeDepthLocation;
+    GLint compositeTextureLocation;
+};
+
+// NOTE: Retained batch of commands living in a GPU buffer. Built once and drawn every frame
+// with a single draw call until invalidated. Instances are kept on the CPU and the GL backend
+// uploads them when it draws the batch first time after it was built
+struct RenderBatch {
+    InstanceStream instances;
+    GLenum usage;
+    GLuint buffer;
+    u32 instanceCount;
+    u32 opaqueCount;
+    b32 valid;
+    // Buffer holds the instances
+    b32 uploaded;
 };
 
+// Adds an RGBA8 image to the renderer atlas. Result can be used with DrawSprite
+AtlasRegion RendererAddImage(Renderer* renderer, const void* rgba, u32 width, u32 height);
+
 void RendererInit(Renderer* renderer);
+// Must be called outside of RendererBeginFrame and RendererEndFrame
+void RendererSetBackend(Renderer* renderer, RenderBackendKind kind);
 void RendererBeginFrame(Renderer* renderer);
 void RendererDraw(Renderer* renderer, RenderQueue* queue);
 void RendererEndFrame(Renderer* renderer);
+
+// Gathers all commands of the queue to the batch. Can be called again on an existing batch to rebuild it
+// Usage is GL_STATIC_DRAW for batches which are built once and GL_STREAM_DRAW for ones rebuilt every frame
+void RenderBatchBuild(Renderer* renderer, RenderBatch* batch, const RenderQueue* commands, GLenum usage);
+// Marks the batch as outdated. It has to be rebuilt before drawing again
+void RenderBatchInvalidate(RenderBatch* batch);
+void RenderBatchRelease(Renderer* renderer, RenderBatch* batch);
+// Must be called between RendererBeginFrame and RendererEndFrame
+void RendererDrawBatch(Renderer* renderer, RenderBatch* batch);
+
+// Returns the layer with this name creating it on first use. New layers are dirty
+RenderLayer* RendererGetLayer(Renderer* renderer, const char* name, f32 depth);
+void RenderLayerInvalidate(RenderLayer* layer);
+// Replaces contents of the layer with commands of the queue and clears the dirty flag.
+// Must be called between RendererBeginFrame and RendererEndFrame. Layers are render targets, so only
+// the GL backend draws and composites them, other backends leave them dirty
+void RendererDrawLayer(Renderer* renderer, RenderLayer* layer, RenderQueue* queue);
+// Draws all visible layers to the screen. Layers go through the depth test, so they
+// can be placed under or over the geometry drawn with RendererDraw
+void RendererCompositeLayers(Renderer* renderer);
@@ -0,0 +1,78 @@
+#include "RenderBackend.h"
+
+void RenderBackendNullInit(Renderer* renderer) {}
+void RenderBackendNullBeginFrame(Renderer* renderer) {}
+void RenderBackendNullSubmitBatch(Renderer* renderer, const RenderBackendBatch* batch) {}
+void RenderBackendNullEndFrame(Renderer* renderer) {}
+
+void RenderBackendCountingInit(Renderer* renderer) {
+    renderer->counting = {};
+}
+
+void RenderBackendCountingBeginFrame(Renderer* renderer) {
+    renderer->counting.frame = {};
+}
+
+void RenderBackendCountingSubmitBatch(Renderer* renderer, const RenderBackendBatch* batch) {
+    RenderBackendCounts* counts = &renderer->counting.frame;
+    counts->batches++;
+    counts->opaqueInstances += batch->opaqueCount;
+    counts->blendedInstances += batch->count - batch->opaqueCount;
+    counts->vertices += batch->count * 4;
+    if (batch->retained) {
+        counts->retainedBatches++;
+    }
+    for (u32 i = 0; i < batch->count; i++) {
+        u32 kind = batch->instances->kind[i];
+        assert(kind < RenderBackendCounts::KindCount);
+        counts->kinds[kind]++;
+    }
+}
+
+void RenderBackendCountingEndFrame(Renderer* renderer) {
+    RenderCountingBackend* counting = &renderer->counting;
+    RenderBackendCounts* total = &counting->total;
+    total->batches += counting->frame.batches;
+    total->retainedBatches += counting->frame.retainedBatches;
+    total->opaqueInstances += counting->frame.opaqueInstances;
+    total->blendedInstances += counting->frame.blendedInstances;
+    total->vertices += counting->frame.vertices;
+    for (u32 kind = 0; kind < RenderBackendCounts::KindCount; kind++) {
+        total->kinds[kind] += counting->frame.kinds[kind];
+    }
+
+    if (++counting->frameCount == RenderCountingBackend::ReportInterval) {
+        f32 frames = (f32)counting->frameCount;
+        log_print("[Renderer] Per frame: %.1f batches (%.1f retained), %.1f opaque and %.1f blended instances, %.1f vertices\n",
+                  total->batches / frames, total->retainedBatches / frames, total->opaqueInstances / frames, total->blendedInstances / frames, total->vertices / frames);
+        log_print("[Renderer] Per frame gathered: %.1f rects, %.1f lines, %.1f rounded rects, %.1f capsules, %.1f sprites\n",
+                  total->kinds[(u32)RenderInstanceKind::Rect] / frames, total->kinds[(u32)RenderInstanceKind::Line] / frames,
+                  total->kinds[(u32)RenderInstanceKind::RoundedRect] / frames, total->kinds[(u32)RenderInstanceKind::Capsule] / frames,
+                  total->kinds[(u32)RenderInstanceKind::Sprite] / frames);
+        counting->total = {};
+        counting->frameCount = 0;
+    }
+}
+
+static_assert((u32)RenderInstanceKind::Sprite + 1 == RenderBackendCounts::KindCount);
+
+static const RenderBackend RenderBackends[(u32)RenderBackendKind::Count] = {
+    { "gl", RenderBackendGLInit, RenderBackendGLBeginFrame, RenderBackendGLSubmitBatch, RenderBackendGLEndFrame },
+    { "null", RenderBackendNullInit, RenderBackendNullBeginFrame, RenderBackendNullSubmitBatch, RenderBackendNullEndFrame },
+    { "counting", RenderBackendCountingInit, RenderBackendCountingBeginFrame, RenderBackendCountingSubmitBatch, RenderBackendCountingEndFrame },
+};
+
+const RenderBackend* RenderBackendGet(RenderBackendKind kind) {
+    assert((u32)kind < (u32)RenderBackendKind::Count);
+    return RenderBackends + (u32)kind;
+}
+
+b32 RenderBackendFind(const char* name, RenderBackendKind* kind) {
+    for (u32 i = 0; i < (u32)RenderBackendKind::Count; i++) {
+        if (strcmp(RenderBackends[i].name, name) == 0) {
+            *kind = (RenderBackendKind)i;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Common.h"
+
+struct Renderer;
+struct InstanceStream;
+struct RenderBatch;
+
+// NOTE: Backend receives instances which the renderer culled, sorted and gathered, so everything up to
+// the submission costs the same with any backend. GL draws them, null discards them, counting only records
+// what would be drawn. Backends can be switched between frames to see how much of the frame drawing takes
+enum struct RenderBackendKind : u32 {
+    GL = 0, Null, Counting, Count
+};
+
+// NOTE: Instances which go to the backend at once. Opaque instances go first, blended ones follow
+// them sorted back to front
+struct RenderBackendBatch {
+    const InstanceStream* instances;
+    // Null for instances gathered this frame. Retained batch is uploaded by the backend which needs it
+    RenderBatch* retained;
+    u32 opaqueCount;
+    u32 count;
+};
+
+struct RenderBackendCounts {
+    // Must match RenderInstanceKind
+    static const u32 KindCount = 5;
+
+    u32 batches;
+    u32 retainedBatches;
+    u32 opaqueInstances;
+    u32 blendedInstances;
+    // Every instance is a quad drawn as a triangle strip of 4 vertices
+    u32 vertices;
+    // Instances of every kind
+    u32 kinds[KindCount];
+};
+
+struct RenderCountingBackend {
+    // Average counts are logged once in this number of frames
+    static const u32 ReportInterval = 120;
+
+    RenderBackendCounts frame;
+    // Since the last report
+    RenderBackendCounts total;
+    u32 frameCount;
+};
+
+typedef void(RenderBackendInitFn)(Renderer* renderer);
+typedef void(RenderBackendBeginFrameFn)(Renderer* renderer);
+typedef void(RenderBackendSubmitBatchFn)(Renderer* renderer, const RenderBackendBatch* batch);
+typedef void(RenderBackendEndFrameFn)(Renderer* renderer);
+
+struct RenderBackend {
+    const char* name;
+    RenderBackendInitFn* Init;
+    RenderBackendBeginFrameFn* BeginFrame;
+    RenderBackendSubmitBatchFn* SubmitBatch;
+    RenderBackendEndFrameFn* EndFrame;
+};
+
+const RenderBackend* RenderBackendGet(RenderBackendKind kind);
+// Returns false if there is no backend with this name
+b32 RenderBackendFind(const char* name, RenderBackendKind* kind);
@@ -0,0 +1,78 @@
+#include "RenderCapture.h"
+
+void RenderCaptureWrite(RenderCapture* capture, const void* data, u32 size) {
+    if (capture->size + size > capture->capacity) {
+        capture->capacity = NextPowerOfTwo(capture->size + size);
+        capture->data = (u8*)PlatformReallocate(capture->data, capture->capacity, nullptr);
+        assert(capture->data);
+    }
+    memcpy(capture->data + capture->size, data, size);
+    capture->size += size;
+}
+
+void RenderCaptureBegin(RenderCapture* capture, const char* filename, u32 frameCount) {
+    assert(frameCount);
+    if (capture->framesLeft) {
+        log_print("[RenderCapture] Capture is already in progress\n");
+        return;
+    }
+
+    const PlatformState* platform = GetPlatform();
+    strncpy(capture->filename, filename, array_count(capture->filename) - 1);
+    capture->filename[array_count(capture->filename) - 1] = 0;
+    capture->framesLeft = frameCount;
+    capture->frameCount = 0;
+    capture->windowWidth = platform->windowWidth;
+    capture->windowHeight = platform->windowHeight;
+    capture->size = 0;
+    // NOTE(swarzzy): Header is written at the end when the frame count is known
+    RenderFrameFileHeader header = {};
+    RenderCaptureWrite(capture, &header, sizeof(header));
+
+    log_print("[RenderCapture] Capturing %u frames to %s\n", frameCount, filename);
+}
+
+void RenderCaptureFrame(RenderCapture* capture, const Canvas* canvas, const RenderQueue* queue) {
+    if (!capture->framesLeft) {
+        return;
+    }
+
+    RenderFrameHeader frame = {};
+    frame.rectCount = queue->rectBufferAt;
+    frame.lineCount = queue->lineBufferAt;
+    frame.shapeCount = queue->shapeBufferAt;
+    frame.canvas = *canvas;
+    RenderCaptureWrite(capture, &frame, sizeof(frame));
+    RenderCaptureWrite(capture, queue->rectBuffer, sizeof(RenderCommand) * queue->rectBufferAt);
+    RenderCaptureWrite(capture, queue->lineBuffer, sizeof(RenderCommand) * queue->lineBufferAt);
+    RenderCaptureWrite(capture, queue->shapeBuffer, sizeof(RenderCommand) * queue->shapeBufferAt);
+
+    capture->frameCount++;
+    capture->framesLeft--;
+    if (!capture->framesLeft) {
+        RenderCaptureEnd(capture);
+    }
+}
+
+void RenderCaptureEnd(RenderCapture* capture) {
+    if (!capture->data || !capture->size) {
+        return;
+    }
+
+    RenderFrameFileHeader* header = (RenderFrameFileHeader*)capture->data;
+    header->magic = RenderFrameFileHeader::Magic;
+    header->version = RenderFrameFileHeader::Version;
+    header->commandSize = sizeof(RenderCommand);
+    header->frameCount = capture->frameCount;
+    header->windowWidth = capture->windowWidth;
+    header->windowHeight = capture->windowHeight;
+
+    if (PlatformDebugWriteFile(capture->filename, capture->data, capture->size)) {
+        log_print("[RenderCapture] Captured %u frames, %.1f KB\n", capture->frameCount, capture->size / 1024.0f);
+    } else {
+        log_print("[RenderCapture] Failed to write %s\n", capture->filename);
+    }
+
+    PlatformDeallocate(capture->data, nullptr);
+    *capture = {};
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Common.h"
+#include "RenderQueue.h"
+#include "Render.h"
+
+// NOTE: Contents of the render queue dumped for tools/RenderBench.cpp. File is a header followed by frames.
+// Every frame is a RenderFrameHeader followed by rect, line and shape commands. Commands are written
+// as is, so a file is valid only for the build which wrote it
+struct RenderFrameFileHeader {
+    static const u32 Magic = 0x4d524652; // RFRM
+    static const u32 Version = 1;
+
+    u32 magic;
+    u32 version;
+    u32 commandSize;
+    u32 frameCount;
+    u32 windowWidth;
+    u32 windowHeight;
+};
+
+struct RenderFrameHeader {
+    u32 rectCount;
+    u32 lineCount;
+    u32 shapeCount;
+    Canvas canvas;
+};
+
+// NOTE: Frames are gathered in memory and written at once when the capture ends, so the disk does not
+// slow down the captured frames
+struct RenderCapture {
+    static constexpr const char* DefaultFilename = "render_frames.bin";
+    // Number of frames captured by F4
+    static const u32 DefaultFrameCount = 120;
+    static const u32 MaxFilenameLength = 128;
+
+    // NOTE: Copied, so the capture does not point into the game library which may be reloaded before the capture ends
+    char filename[MaxFilenameLength];
+    u32 framesLeft;
+    u32 frameCount;
+    u32 windowWidth;
+    u32 windowHeight;
+    u32 size;
+    u32 capacity;
+    u8* data;
+};
+
+// Captures the next frameCount frames
+void RenderCaptureBegin(RenderCapture* capture, const char* filename, u32 frameCount);
+// Records the queue and the canvas if capturing. Goes right before RendererDraw
+void RenderCaptureFrame(RenderCapture* capture, const Canvas* canvas, const RenderQueue* queue);
+// Writes the file. Called by RenderCaptureFrame after the last frame, can be called earlier to stop the capture
+void RenderCaptureEnd(RenderCapture* capture);
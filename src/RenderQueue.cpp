@@ -5,10 +5,15 @@ void RenderQueueInit(RenderQueue* queue, u32 size) {
     queue->rectBufferAt = 0;
     queue->lineBufferSize = size;
     queue->lineBufferAt = 0;
+    queue->shapeBufferSize = size;
+    queue->shapeBufferAt = 0;
+    queue->viewIndex = 0;
     queue->rectBuffer = (RenderCommand*)PlatformAllocate(sizeof(RenderCommand) * size, 0, nullptr);
     queue->lineBuffer = (RenderCommand*)PlatformAllocate(sizeof(RenderCommand) * size, 0, nullptr);
+    queue->shapeBuffer = (RenderCommand*)PlatformAllocate(sizeof(RenderCommand) * size, 0, nullptr);
     assert(queue->rectBuffer);
     assert(queue->lineBuffer);
+    assert(queue->shapeBuffer);
 }
 
 void RenderQueuePush(RenderQueue* queue, RenderCommand command) {
@@ -25,6 +30,15 @@ void RenderQueuePush(RenderQueue* queue, RenderCommand command) {
             queue->lineBufferAt++;
         }
     } break;
+    case RenderCommandType::Circle:
+    case RenderCommandType::RoundedRect:
+    case RenderCommandType::Capsule:
+    case RenderCommandType::Sprite: {
+        if (queue->shapeBufferAt < queue->shapeBufferSize) {
+            queue->shapeBuffer[queue->shapeBufferAt] = command;
+            queue->shapeBufferAt++;
+        }
+    } break;
     invalid_default();
     }
 }
@@ -32,6 +46,170 @@ void RenderQueuePush(RenderQueue* queue, RenderCommand command) {
 void RenderQueueReset(RenderQueue* queue) {
     queue->rectBufferAt = 0;
     queue->lineBufferAt = 0;
+    queue->shapeBufferAt = 0;
+    queue->viewIndex = 0;
+}
+
+void RenderQueueSetView(RenderQueue* queue, u32 viewIndex) {
+    queue->viewIndex = viewIndex;
+}
+
+u32 RenderSortKeyFromDepth(f32 z) {
+    // NOTE(swarzzy): Flipping float bits so unsigned integer comparison gives the same order as float comparison
+    u32 bits;
+    memcpy(&bits, &z, sizeof(u32));
+    u32 mask = (bits & 0x80000000) ? 0xffffffff : 0x80000000;
+    u32 result = bits ^ mask;
+    return result;
+}
+
+void RenderQueueShardsInit(RenderQueueShards* shards, u32 shardCount, u32 sizePerShard) {
+    assert(shardCount && shardCount <= RenderQueueShards::MaxShardCount);
+    shards->shardCount = shardCount;
+    for (u32 i = 0; i < shardCount; i++) {
+        RenderQueueShard* shard = shards->shards + i;
+        RenderQueueInit(&shard->queue, sizePerShard);
+        shard->rectEntries = (RenderSortEntry*)PlatformAllocate(sizeof(RenderSortEntry) * sizePerShard, 0, nullptr);
+        shard->lineEntries = (RenderSortEntry*)PlatformAllocate(sizeof(RenderSortEntry) * sizePerShard, 0, nullptr);
+        shard->shapeEntries = (RenderSortEntry*)PlatformAllocate(sizeof(RenderSortEntry) * sizePerShard, 0, nullptr);
+        shard->tempEntries = (RenderSortEntry*)PlatformAllocate(sizeof(RenderSortEntry) * sizePerShard, 0, nullptr);
+        assert(shard->rectEntries);
+        assert(shard->lineEntries);
+        assert(shard->shapeEntries);
+        assert(shard->tempEntries);
+    }
+}
+
+RenderQueue* RenderQueueGetShard(RenderQueueShards* shards, u32 threadIndex) {
+    assert(threadIndex < shards->shardCount);
+    return &shards->shards[threadIndex].queue;
+}
+
+// Stable bottom-up merge sort. Result is always written back to entries
+void RenderSortEntries(RenderSortEntry* entries, RenderSortEntry* temp, u32 count) {
+    RenderSortEntry* source = entries;
+    RenderSortEntry* dest = temp;
+    for (u32 width = 1; width < count; width *= 2) {
+        for (u32 begin = 0; begin < count; begin += width * 2) {
+            u32 middle = Min(begin + width, count);
+            u32 end = Min(begin + width * 2, count);
+            u32 a = begin;
+            u32 b = middle;
+            for (u32 i = begin; i < end; i++) {
+                if (a < middle && (b >= end || source[a].key <= source[b].key)) {
+                    dest[i] = source[a++];
+                } else {
+                    dest[i] = source[b++];
+                }
+            }
+        }
+        RenderSortEntry* t = source;
+        source = dest;
+        dest = t;
+    }
+    if (source != entries) {
+        memcpy(entries, source, sizeof(RenderSortEntry) * count);
+    }
+}
+
+// Command buffers of the queue
+enum struct RenderQueueBuffer : u32 {
+    Rect, Line, Shape, Count
+};
+
+void RenderShardBuffer(RenderQueueShard* shard, RenderQueueBuffer buffer, RenderCommand** commands, u32* count, RenderSortEntry** entries) {
+    switch (buffer) {
+    case RenderQueueBuffer::Rect: { *commands = shard->queue.rectBuffer; *count = shard->queue.rectBufferAt; *entries = shard->rectEntries; } break;
+    case RenderQueueBuffer::Line: { *commands = shard->queue.lineBuffer; *count = shard->queue.lineBufferAt; *entries = shard->lineEntries; } break;
+    case RenderQueueBuffer::Shape: { *commands = shard->queue.shapeBuffer; *count = shard->queue.shapeBufferAt; *entries = shard->shapeEntries; } break;
+    invalid_default();
+    }
+}
+
+void RenderQueueSortShardJob(void* data, u32 threadIndex) {
+    auto shard = (RenderQueueShard*)data;
+    for (u32 buffer = 0; buffer < (u32)RenderQueueBuffer::Count; buffer++) {
+        RenderCommand* commands;
+        u32 count;
+        RenderSortEntry* entries;
+        RenderShardBuffer(shard, (RenderQueueBuffer)buffer, &commands, &count, &entries);
+        for (u32 i = 0; i < count; i++) {
+            entries[i] = RenderSortEntry { commands[i].sortKey, i };
+        }
+        RenderSortEntries(entries, shard->tempEntries, count);
+    }
+}
+
+// K-way merge of sorted shards. Ties are resolved by shard index so the result does not depend
+// on thread scheduling. Returns the number of commands which did not fit to dest
+u32 RenderQueueMergeSorted(RenderCommand* dest, u32 destSize, u32* destAt, RenderQueueShards* shards, RenderQueueBuffer buffer) {
+    u32 heads[RenderQueueShards::MaxShardCount] = {};
+    while (*destAt < destSize) {
+        u32 bestShard = U32::Max;
+        u32 bestKey = 0;
+        for (u32 i = 0; i < shards->shardCount; i++) {
+            RenderCommand* commands;
+            u32 count;
+            RenderSortEntry* entries;
+            RenderShardBuffer(shards->shards + i, buffer, &commands, &count, &entries);
+            if (heads[i] < count) {
+                u32 key = entries[heads[i]].key;
+                if (bestShard == U32::Max || key < bestKey) {
+                    bestShard = i;
+                    bestKey = key;
+                }
+            }
+        }
+
+        if (bestShard == U32::Max) {
+            break;
+        }
+
+        RenderCommand* source;
+        u32 count;
+        RenderSortEntry* entries;
+        RenderShardBuffer(shards->shards + bestShard, buffer, &source, &count, &entries);
+        dest[*destAt] = source[entries[heads[bestShard]].index];
+        (*destAt)++;
+        heads[bestShard]++;
+    }
+
+    u32 dropped = 0;
+    for (u32 i = 0; i < shards->shardCount; i++) {
+        RenderCommand* commands;
+        u32 count;
+        RenderSortEntry* entries;
+        RenderShardBuffer(shards->shards + i, buffer, &commands, &count, &entries);
+        dropped += count - heads[i];
+    }
+    return dropped;
+}
+
+void RenderQueueMergeShards(RenderQueue* queue, RenderQueueShards* shards) {
+    u32 nonEmptyCount = 0;
+    for (u32 i = 0; i < shards->shardCount; i++) {
+        RenderQueueShard* shard = shards->shards + i;
+        if (shard->queue.rectBufferAt || shard->queue.lineBufferAt || shard->queue.shapeBufferAt) {
+            PlatformPushWork(RenderQueueSortShardJob, shard);
+            nonEmptyCount++;
+        }
+    }
+
+    if (nonEmptyCount) {
+        PlatformCompleteAllWork();
+
+        u32 dropped = 0;
+        dropped += RenderQueueMergeSorted(queue->rectBuffer, queue->rectBufferSize, &queue->rectBufferAt, shards, RenderQueueBuffer::Rect);
+        dropped += RenderQueueMergeSorted(queue->lineBuffer, queue->lineBufferSize, &queue->lineBufferAt, shards, RenderQueueBuffer::Line);
+        dropped += RenderQueueMergeSorted(queue->shapeBuffer, queue->shapeBufferSize, &queue->shapeBufferAt, shards, RenderQueueBuffer::Shape);
+        if (dropped) {
+            log_print("[RenderQueue] Queue is full, %u commands of shards were dropped\n", dropped);
+        }
+
+        for (u32 i = 0; i < shards->shardCount; i++) {
+            RenderQueueReset(&shards->shards[i].queue);
+        }
+    }
 }
 
 void DrawQuad(RenderQueue* queue, v2 min, v2 max, f32 z, v4 color) {
@@ -41,16 +219,391 @@ void DrawQuad(RenderQueue* queue, v2 min, v2 max, f32 z, v4 color) {
     command.rectColor.max = max;
     command.rectColor.color = color;
     command.rectColor.z = z;
+    command.sortKey = RenderSortKeyFromDepth(z);
+    command.viewIndex = queue->viewIndex;
 
     RenderQueuePush(queue, command);
 }
 
-void DrawLine(RenderQueue* queue, v3 begin, v3 end, v4 color) {
+void DrawLine(RenderQueue* queue, v3 begin, v3 end, v4 color, f32 thickness) {
     RenderCommand command {};
     command.type = RenderCommandType::Line;
     command.line.begin = begin;
     command.line.end = end;
     command.line.color = color;
+    command.line.thickness = thickness;
+    command.sortKey = RenderSortKeyFromDepth(Min(begin.z, end.z));
+    command.viewIndex = queue->viewIndex;
+
+    RenderQueuePush(queue, command);
+}
+
+void DrawShape(RenderQueue* queue, RenderCommandType type, v2 a, v2 b, f32 radius, f32 z, v4 color) {
+    RenderCommand command {};
+    command.type = type;
+    command.shape.a = a;
+    command.shape.b = b;
+    command.shape.radius = radius;
+    command.shape.z = z;
+    command.shape.color = color;
+    command.sortKey = RenderSortKeyFromDepth(z);
+    command.viewIndex = queue->viewIndex;
 
     RenderQueuePush(queue, command);
 }
+
+void DrawCircle(RenderQueue* queue, v2 center, f32 radius, f32 z, v4 color) {
+    DrawShape(queue, RenderCommandType::Circle, V2(center.x - radius, center.y - radius), V2(center.x + radius, center.y + radius), radius, z, color);
+}
+
+void DrawRoundedRect(RenderQueue* queue, v2 min, v2 max, f32 radius, f32 z, v4 color) {
+    DrawShape(queue, RenderCommandType::RoundedRect, min, max, radius, z, color);
+}
+
+void DrawCapsule(RenderQueue* queue, v2 begin, v2 end, f32 radius, f32 z, v4 color) {
+    DrawShape(queue, RenderCommandType::Capsule, begin, end, radius, z, color);
+}
+
+void DrawSprite(RenderQueue* queue, v2 min, v2 max, f32 z, const AtlasRegion* region, v4 tint) {
+    assert(region->valid);
+    RenderCommand command {};
+    command.type = RenderCommandType::Sprite;
+    command.sprite.min = min;
+    command.sprite.max = max;
+    command.sprite.color = tint;
+    command.sprite.z = z;
+    command.sprite.page = region->page;
+    command.sprite.uvMin = region->uvMin;
+    command.sprite.uvMax = region->uvMax;
+    command.sortKey = RenderSortKeyFromDepth(z);
+    command.viewIndex = queue->viewIndex;
+
+    RenderQueuePush(queue, command);
+}
+
+// Hash of the properties which must match for rects to be merged
+u32 RenderRectMergeKey(const RenderCommand* command) {
+    u32 words[7];
+    memcpy(words, &command->rectColor.color, sizeof(v4));
+    memcpy(words + 4, &command->rectColor.z, sizeof(f32));
+    words[5] = command->viewIndex;
+    words[6] = command->transparent;
+    return (u32)HashBytes(words, sizeof(words), 0);
+}
+
+b32 RenderRectsMergeable(const RenderCommand* a, const RenderCommand* b) {
+    return a->rectColor.color == b->rectColor.color && a->rectColor.z == b->rectColor.z && a->viewIndex == b->viewIndex && a->transparent == b->transparent;
+}
+
+// Sorts coordinates and removes duplicates. Returns the number of unique coordinates
+u32 RenderSortUniqueCoords(f32* coords, RenderSortEntry* entries, RenderSortEntry* temp, u32 count) {
+    for (u32 i = 0; i < count; i++) {
+        entries[i].key = RenderSortKeyFromDepth(coords[i]);
+        entries[i].index = i;
+    }
+    RenderSortEntries(entries, temp, count);
+
+    u32 at = 0;
+    for (u32 i = 0; i < count; i++) {
+        if (at == 0 || entries[i].key != entries[at - 1].key) {
+            entries[at++] = entries[i];
+        }
+    }
+
+    // NOTE(swarzzy): Writing through temp since source coordinates are referenced by entries
+    f32* sorted = (f32*)temp;
+    for (u32 i = 0; i < at; i++) {
+        sorted[i] = coords[entries[i].index];
+    }
+    memcpy(coords, sorted, sizeof(f32) * at);
+    return at;
+}
+
+// Index of the first coordinate which is not less than value
+u32 RenderFindCoord(const f32* coords, u32 count, f32 value) {
+    u32 begin = 0;
+    u32 end = count;
+    while (begin < end) {
+        u32 middle = (begin + end) / 2;
+        if (coords[middle] < value) {
+            begin = middle + 1;
+        } else {
+            end = middle;
+        }
+    }
+    return begin;
+}
+
+// Normalized bounds of a rect, so min is less than max
+void RenderRectBounds(const RenderCommand* command, v2* min, v2* max) {
+    *min = V2(Min(command->rectColor.min.x, command->rectColor.max.x), Min(command->rectColor.min.y, command->rectColor.max.y));
+    *max = V2(Max(command->rectColor.min.x, command->rectColor.max.x), Max(command->rectColor.min.y, command->rectColor.max.y));
+}
+
+// NOTE: Scratch of RenderMergeRectGroup. Sized for all rects of the queue
+struct RectMergeScratch {
+    RenderSortEntry* entries;
+    RenderSortEntry* temp;
+    f32* xs;
+    f32* ys;
+    u8* cells;
+    usize cellCapacity;
+};
+
+// Writes rects covering the same area as the members of the group to result. Returns the number of
+// written rects or zero if merging does not make the group smaller
+u32 RenderMergeRectGroup(const RenderCommand* rects, const u32* members, u32 memberCount, RectMergeScratch* scratch, RenderCommand* result) {
+    // NOTE(swarzzy): Groups with grids bigger than this are left as is, since coordinate
+    // compression of scattered rects produces quadratic amount of cells
+    const u64 MaxCellsPerGroup = 1 << 22;
+
+    f32* xs = scratch->xs;
+    f32* ys = scratch->ys;
+    for (u32 i = 0; i < memberCount; i++) {
+        const RenderCommand* command = rects + members[i];
+        xs[i * 2 + 0] = command->rectColor.min.x;
+        xs[i * 2 + 1] = command->rectColor.max.x;
+        ys[i * 2 + 0] = command->rectColor.min.y;
+        ys[i * 2 + 1] = command->rectColor.max.y;
+    }
+    u32 xCount = RenderSortUniqueCoords(xs, scratch->entries, scratch->temp, memberCount * 2);
+    u32 yCount = RenderSortUniqueCoords(ys, scratch->entries, scratch->temp, memberCount * 2);
+    u32 columns = xCount - 1;
+    u32 rows = yCount - 1;
+    u64 cellCount = (u64)columns * rows;
+    if (!cellCount || cellCount > MaxCellsPerGroup) {
+        return 0;
+    }
+
+    if (cellCount > scratch->cellCapacity) {
+        if (scratch->cells) {
+            PlatformDeallocate(scratch->cells, nullptr);
+        }
+        scratch->cellCapacity = (usize)cellCount;
+        scratch->cells = (u8*)PlatformAllocate(scratch->cellCapacity, 0, nullptr);
+        assert(scratch->cells);
+    }
+    u8* cells = scratch->cells;
+    memset(cells, 0, (usize)cellCount);
+
+    // Marking cells of compressed grid covered by any rect of the group
+    for (u32 i = 0; i < memberCount; i++) {
+        v2 min, max;
+        RenderRectBounds(rects + members[i], &min, &max);
+        u32 x0 = RenderFindCoord(xs, xCount, min.x);
+        u32 x1 = RenderFindCoord(xs, xCount, max.x);
+        u32 y0 = RenderFindCoord(ys, yCount, min.y);
+        u32 y1 = RenderFindCoord(ys, yCount, max.y);
+        for (u32 y = y0; y < y1; y++) {
+            memset(cells + (usize)y * columns + x0, 1, x1 - x0);
+        }
+    }
+
+    // Greedy meshing. Growing every rect along x first and then along y
+    const RenderCommand* base = rects + members[0];
+    u32 resultCount = 0;
+    for (u32 y = 0; y < rows; y++) {
+        for (u32 x = 0; x < columns; x++) {
+            if (!cells[(usize)y * columns + x]) {
+                continue;
+            }
+
+            // NOTE(swarzzy): Greedy meshing may produce more rects than there were for some shapes,
+            // original rects are used in that case
+            if (resultCount + 1 == memberCount) {
+                return 0;
+            }
+
+            u32 width = 1;
+            while (x + width < columns && cells[(usize)y * columns + x + width]) {
+                width++;
+            }
+
+            u32 height = 1;
+            while (y + height < rows) {
+                const u8* row = cells + (usize)(y + height) * columns + x;
+                u32 covered = 0;
+                while (covered < width && row[covered]) {
+                    covered++;
+                }
+                if (covered != width) {
+                    break;
+                }
+                height++;
+            }
+
+            for (u32 clear = 0; clear < height; clear++) {
+                memset(cells + (usize)(y + clear) * columns + x, 0, width);
+            }
+
+            RenderCommand command = *base;
+            command.rectColor.min = V2(xs[x], ys[y]);
+            command.rectColor.max = V2(xs[x + width], ys[y + height]);
+            result[resultCount++] = command;
+            x += width - 1;
+        }
+    }
+    return resultCount;
+}
+
+RectMergeStats RenderQueueMergeRects(RenderQueue* queue) {
+    // Flags of a group
+    const u8 GroupConflicts = 1 << 0;
+    const u8 GroupMerged = 1 << 1;
+    // Merging was tried and did not make the group smaller
+    const u8 GroupKept = 1 << 2;
+
+    RectMergeStats stats {};
+    u32 count = queue->rectBufferAt;
+    stats.rectsBefore = count;
+    stats.rectsAfter = count;
+    if (count < 2) {
+        return stats;
+    }
+
+    const RenderCommand* rects = queue->rectBuffer;
+    RectMergeScratch scratch {};
+    scratch.entries = (RenderSortEntry*)PlatformAllocate(sizeof(RenderSortEntry) * count * 2, 0, nullptr);
+    scratch.temp = (RenderSortEntry*)PlatformAllocate(sizeof(RenderSortEntry) * count * 2, 0, nullptr);
+    scratch.xs = (f32*)PlatformAllocate(sizeof(f32) * count * 2, 0, nullptr);
+    scratch.ys = (f32*)PlatformAllocate(sizeof(f32) * count * 2, 0, nullptr);
+    RenderSortEntry* sorted = (RenderSortEntry*)PlatformAllocate(sizeof(RenderSortEntry) * count, 0, nullptr);
+    // Indices of rects of every group go one after another starting at groupBegin[group]
+    u32* members = (u32*)PlatformAllocate(sizeof(u32) * count, 0, nullptr);
+    u32* groupBegin = (u32*)PlatformAllocate(sizeof(u32) * (count + 1), 0, nullptr);
+    u32* groupOf = (u32*)PlatformAllocate(sizeof(u32) * count, 0, nullptr);
+    u8* groupFlags = (u8*)PlatformAllocate(count, 0, nullptr);
+    RenderCommand* result = (RenderCommand*)PlatformAllocate(sizeof(RenderCommand) * count, 0, nullptr);
+    assert(scratch.entries && scratch.temp && scratch.xs && scratch.ys && sorted && members && groupBegin && groupOf && groupFlags && result);
+
+    for (u32 i = 0; i < count; i++) {
+        assert(rects[i].type == RenderCommandType::RectColor);
+        sorted[i].key = RenderRectMergeKey(rects + i);
+        sorted[i].index = i;
+    }
+    RenderSortEntries(sorted, scratch.temp, count);
+
+    u32 groupCount = 0;
+    u32 memberAt = 0;
+    for (u32 run = 0; run < count;) {
+        u32 runEnd = run + 1;
+        while (runEnd < count && sorted[runEnd].key == sorted[run].key) {
+            runEnd++;
+        }
+
+        // NOTE(swarzzy): Hash run may contain several groups if hashes collide. Taking the
+        // first unprocessed rect of the run and everything matching it until the run is empty
+        for (u32 first = run; first < runEnd; first++) {
+            if (sorted[first].index == U32::Max) {
+                continue;
+            }
+            const RenderCommand* base = rects + sorted[first].index;
+            u32 group = groupCount++;
+            groupBegin[group] = memberAt;
+            groupFlags[group] = 0;
+            for (u32 i = first; i < runEnd; i++) {
+                if (sorted[i].index != U32::Max && RenderRectsMergeable(base, rects + sorted[i].index)) {
+                    members[memberAt++] = sorted[i].index;
+                    groupOf[sorted[i].index] = group;
+                    sorted[i].index = U32::Max;
+                }
+            }
+        }
+
+        run = runEnd;
+    }
+    groupBegin[groupCount] = memberAt;
+
+    // NOTE(swarzzy): Depth test is LEQUAL, so of overlapping rects with the same z the last one wins. Merged group
+    // moves its rects to the place of the first one, so groups which overlap rects of other groups with the same
+    // z are not merged. Rects are swept along x within every z and view to find them
+    for (u32 i = 0; i < count; i++) {
+        u32 words[2];
+        memcpy(words, &rects[i].rectColor.z, sizeof(f32));
+        words[1] = rects[i].viewIndex;
+        sorted[i].key = (u32)HashBytes(words, sizeof(words), 0);
+        sorted[i].index = i;
+    }
+    RenderSortEntries(sorted, scratch.temp, count);
+
+    RenderSortEntry* sweep = scratch.entries;
+    for (u32 run = 0; run < count;) {
+        u32 runEnd = run + 1;
+        while (runEnd < count && sorted[runEnd].key == sorted[run].key) {
+            runEnd++;
+        }
+
+        u32 sweepCount = runEnd - run;
+        for (u32 i = 0; i < sweepCount; i++) {
+            v2 min, max;
+            RenderRectBounds(rects + sorted[run + i].index, &min, &max);
+            sweep[i].key = RenderSortKeyFromDepth(min.x);
+            sweep[i].index = sorted[run + i].index;
+        }
+        RenderSortEntries(sweep, scratch.temp, sweepCount);
+
+        for (u32 i = 0; i < sweepCount; i++) {
+            const RenderCommand* a = rects + sweep[i].index;
+            v2 aMin, aMax;
+            RenderRectBounds(a, &aMin, &aMax);
+            for (u32 j = i + 1; j < sweepCount; j++) {
+                const RenderCommand* b = rects + sweep[j].index;
+                v2 bMin, bMax;
+                RenderRectBounds(b, &bMin, &bMax);
+                if (bMin.x >= aMax.x) {
+                    break;
+                }
+                u32 aGroup = groupOf[sweep[i].index];
+                u32 bGroup = groupOf[sweep[j].index];
+                // NOTE(swarzzy): Rects which only touch do not overlap
+                if (aGroup != bGroup && bMin.y < aMax.y && aMin.y < bMax.y &&
+                    a->rectColor.z == b->rectColor.z && a->viewIndex == b->viewIndex) {
+                    groupFlags[aGroup] |= GroupConflicts;
+                    groupFlags[bGroup] |= GroupConflicts;
+                }
+            }
+        }
+
+        run = runEnd;
+    }
+
+    // NOTE(swarzzy): Rects are written in the original order. Merged group takes the place of its first rect
+    u32 resultCount = 0;
+    for (u32 i = 0; i < count; i++) {
+        u32 group = groupOf[i];
+        if (groupFlags[group] & GroupMerged) {
+            continue;
+        }
+        u32 memberCount = groupBegin[group + 1] - groupBegin[group];
+        if (memberCount > 1 && !(groupFlags[group] & (GroupConflicts | GroupKept))) {
+            u32 merged = RenderMergeRectGroup(rects, members + groupBegin[group], memberCount, &scratch, result + resultCount);
+            if (merged) {
+                resultCount += merged;
+                groupFlags[group] |= GroupMerged;
+                continue;
+            }
+            groupFlags[group] |= GroupKept;
+        }
+        result[resultCount++] = rects[i];
+    }
+
+    memcpy(queue->rectBuffer, result, sizeof(RenderCommand) * resultCount);
+    queue->rectBufferAt = resultCount;
+    stats.rectsAfter = resultCount;
+
+    if (scratch.cells) {
+        PlatformDeallocate(scratch.cells, nullptr);
+    }
+    PlatformDeallocate(result, nullptr);
+    PlatformDeallocate(groupFlags, nullptr);
+    PlatformDeallocate(groupOf, nullptr);
+    PlatformDeallocate(groupBegin, nullptr);
+    PlatformDeallocate(members, nullptr);
+    PlatformDeallocate(sorted, nullptr);
+    PlatformDeallocate(scratch.ys, nullptr);
+    PlatformDeallocate(scratch.xs, nullptr);
+    PlatformDeallocate(scratch.temp, nullptr);
+    PlatformDeallocate(scratch.entries, nullptr);
+
+    return stats;
+}
@@ -1,9 +1,10 @@
 #pragma once
 
 #include "Common.h"
+#include "TextureAtlas.h"
 
 enum struct RenderCommandType : u32 {
-    RectColor, Line
+    RectColor, Line, Circle, RoundedRect, Capsule, Sprite
 };
 
 struct RenderCommand {
@@ -11,6 +12,12 @@ struct RenderCommand {
 
     b32 transparent;
 
+    // NOTE: Commands recorded to queue shards are ordered by this key on merge
+    u32 sortKey;
+
+    // Index of the view-projection matrix in the canvas
+    u32 viewIndex;
+
     union {
         struct {
             v2 min;
@@ -22,9 +29,29 @@ struct RenderCommand {
             v3 begin;
             v3 end;
             v4 color;
-            // Not supported for now
+            // In pixels
             f32 thickness;
         } line;
+        // NOTE: Shapes with anti-aliased edges. Circle and rounded rect: a and b are bounds,
+        // radius is the corner radius. Capsule: a and b are end points of the segment
+        struct {
+            v2 a;
+            v2 b;
+            v4 color;
+            f32 z;
+            f32 radius;
+        } shape;
+        // NOTE: Starts the same way as shape, so bounds and z are at the same offsets
+        struct {
+            v2 min;
+            v2 max;
+            // Multiplied by the texture color
+            v4 color;
+            f32 z;
+            u32 page;
+            v2 uvMin;
+            v2 uvMax;
+        } sprite;
     };
 };
 
@@ -33,16 +60,76 @@ struct RenderQueue {
     u32 rectBufferAt;
     u32 lineBufferSize;
     u32 lineBufferAt;
+    // Shapes and sprites. They are blended so they go separately from the opaque commands
+    u32 shapeBufferSize;
+    u32 shapeBufferAt;
+    // View assigned to commands pushed by Draw* calls
+    u32 viewIndex;
     RenderCommand* rectBuffer;
     // TODO(swarzzy): Should we use separate buffers for different command or just
     // use one and sort it?
     RenderCommand* lineBuffer;
+    RenderCommand* shapeBuffer;
+};
+
+struct RenderSortEntry {
+    u32 key;
+    u32 index;
+};
+
+struct RenderQueueShard {
+    RenderQueue queue;
+    // Scratch space for sorting
+    RenderSortEntry* rectEntries;
+    RenderSortEntry* lineEntries;
+    RenderSortEntry* shapeEntries;
+    RenderSortEntry* tempEntries;
+};
+
+// NOTE: Per-thread render queues. Every thread records commands to its own shard
+// (selected by threadIndex passed to the job) so no synchronization is needed.
+// Shards then get sorted and merged into the main queue before drawing.
+struct RenderQueueShards {
+    static const u32 MaxShardCount = 16;
+    u32 shardCount;
+    RenderQueueShard shards[MaxShardCount];
 };
 
 void RenderQueueInit(RenderQueue* queue, u32 size);
 void RenderQueuePush(RenderQueue* queue, RenderCommand command);
 void RenderQueueReset(RenderQueue* queue);
+// Following draws go to the view with this index. Reset to zero on RenderQueueReset
+void RenderQueueSetView(RenderQueue* queue, u32 viewIndex);
+
+void RenderQueueShardsInit(RenderQueueShards* shards, u32 shardCount, u32 sizePerShard);
+RenderQueue* RenderQueueGetShard(RenderQueueShards* shards, u32 threadIndex);
+// Appends commands from all shards to the queue ordered by sort key and resets the shards.
+// Commands which were pushed to the queue directly keep their order and go first.
+// Must be called after all jobs that record to the shards are completed. Commands which do not fit
+// to the queue are dropped and logged
+void RenderQueueMergeShards(RenderQueue* queue, RenderQueueShards* shards);
+
+// Smaller depth values are closer to the viewer, so opaque geometry ends up sorted front to back
+u32 RenderSortKeyFromDepth(f32 z);
+
+struct RectMergeStats {
+    u32 rectsBefore;
+    u32 rectsAfter;
+};
+
+// NOTE: Replaces adjacent or overlapping rects which have the same color, z and view with
+// fewer bigger rects covering the same area. Intended for static content before it goes
+// to a batch, since the pass is too slow to run every frame. Merged rects take the place of
+// the first rect of the group. Groups which overlap rects of other groups with the same z and
+// view are not merged, so the rect which wins the depth test does not change
+RectMergeStats RenderQueueMergeRects(RenderQueue* queue);
 
 // Helpers
 void DrawQuad(RenderQueue* queue, v2 min, v2 max, f32 z, v4 color);
-void DrawLine(RenderQueue* queue, v3 begin, v3 end, v4 color);
+// Thickness is in pixels
+void DrawLine(RenderQueue* queue, v3 begin, v3 end, v4 color, f32 thickness);
+void DrawCircle(RenderQueue* queue, v2 center, f32 radius, f32 z, v4 color);
+void DrawRoundedRect(RenderQueue* queue, v2 min, v2 max, f32 radius, f32 z, v4 color);
+// Thickness is 2 * radius in world units
+void DrawCapsule(RenderQueue* queue, v2 begin, v2 end, f32 radius, f32 z, v4 color);
+void DrawSprite(RenderQueue* queue, v2 min, v2 max, f32 z, const AtlasRegion* region, v4 tint);
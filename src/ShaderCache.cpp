@@ -0,0 +1,212 @@
+#include "ShaderCache.h"
+
+struct ShaderCacheHeader {
+    static const u32 Magic = 0x43444853; // SHDC
+
+    u32 magic;
+    u32 binaryFormat;
+    u64 key;
+    u32 binarySize;
+    u32 _pad;
+};
+
+// Hashes a driver string. Missing strings are hashed as empty
+u64 ShaderCacheHashString(GLenum name, u64 seed) {
+    const char* string = (const char*)glGetString(name);
+    if (!string) {
+        string = "";
+    }
+    return HashBytes(string, (usize)strlen(string), seed);
+}
+
+void ShaderCacheInit(ShaderCache* cache) {
+    *cache = {};
+    cache->driverHash = ShaderCacheHashString(GL_VENDOR, 0);
+    cache->driverHash = ShaderCacheHashString(GL_RENDERER, cache->driverHash);
+    cache->driverHash = ShaderCacheHashString(GL_VERSION, cache->driverHash);
+
+    if (gl_extension(parallelShaderCompile)) {
+        // NOTE(swarzzy): Lets the driver pick the number of compiler threads
+        glMaxShaderCompilerThreadsKHR(0xffffffff);
+    }
+}
+
+// NOTE(swarzzy): With KHR_parallel_shader_compile compilation and linking run on driver threads. Status and
+// log queries block until they are done, so completion is polled first and the driver keeps working meanwhile
+b32 ShaderProgramReady(GLuint program) {
+    if (!gl_extension(parallelShaderCompile)) {
+        return true;
+    }
+    GLint complete = GL_FALSE;
+    glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete == GL_TRUE;
+}
+
+void ShaderWaitForProgram(GLuint program) {
+    while (!ShaderProgramReady(program)) {
+        CpuRelax();
+    }
+}
+
+// Creates the program from the cached binary. Returns zero if there is no valid binary
+GLuint ShaderCacheLoad(ShaderBuild* build) {
+    GLuint program = 0;
+    u32 size = PlatformDebugGetFileSize(build->filename);
+    if (size > sizeof(ShaderCacheHeader)) {
+        u8* data = (u8*)PlatformAllocate(size, 0, nullptr);
+        assert(data);
+        if (PlatformDebugReadFile(data, size, build->filename) == size) {
+            ShaderCacheHeader* header = (ShaderCacheHeader*)data;
+            if (header->magic == ShaderCacheHeader::Magic && header->key == build->key && header->binarySize == size - sizeof(ShaderCacheHeader)) {
+                program = glCreateProgram();
+                glProgramBinary(program, header->binaryFormat, data + sizeof(ShaderCacheHeader), header->binarySize);
+                ShaderWaitForProgram(program);
+                GLint linkResult = 0;
+                glGetProgramiv(program, GL_LINK_STATUS, &linkResult);
+                if (!linkResult) {
+                    // NOTE(swarzzy): Drivers may reject their binaries after updates which don't change the version string
+                    log_print("[Renderer] Cached binary of program (%s) was rejected by the driver\n", build->name);
+                    glDeleteProgram(program);
+                    program = 0;
+                }
+            }
+        }
+        PlatformDeallocate(data, nullptr);
+    }
+    return program;
+}
+
+void ShaderCacheSave(ShaderBuild* build) {
+    GLint binarySize = 0;
+    glGetProgramiv(build->program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+    if (binarySize > 0) {
+        u32 size = sizeof(ShaderCacheHeader) + (u32)binarySize;
+        u8* data = (u8*)PlatformAllocate(size, 0, nullptr);
+        assert(data);
+        ShaderCacheHeader* header = (ShaderCacheHeader*)data;
+        *header = {};
+        header->magic = ShaderCacheHeader::Magic;
+        header->key = build->key;
+
+        GLsizei written = 0;
+        GLenum format = 0;
+        glGetProgramBinary(build->program, binarySize, &written, &format, data + sizeof(ShaderCacheHeader));
+        header->binaryFormat = format;
+        header->binarySize = (u32)written;
+        if (!written || !PlatformDebugWriteFile(build->filename, data, sizeof(ShaderCacheHeader) + (u32)written)) {
+            log_print("[Renderer] Failed to save binary of program (%s)\n", build->name);
+        }
+        PlatformDeallocate(data, nullptr);
+    }
+}
+
+void ShaderBuildBegin(ShaderCache* cache, ShaderBuild* build, const char* name, const char* vertexSource, const char* fragmentSource) {
+    *build = {};
+    build->name = name;
+    build->key = HashBytes(vertexSource, (usize)strlen(vertexSource), cache->driverHash);
+    build->key = HashBytes(fragmentSource, (usize)strlen(fragmentSource), build->key);
+    snprintf(build->filename, array_count(build->filename), "shader_cache_%s.bin", name);
+
+    if (gl_extension(getProgramBinary)) {
+        build->program = ShaderCacheLoad(build);
+        if (build->program) {
+            build->fromCache = true;
+            AtomicAdd(&cache->hits, 1);
+            return;
+        }
+    }
+    AtomicAdd(&cache->misses, 1);
+
+    // NOTE(swarzzy): Nothing is queried here. Status queries block until compilation is done
+    build->vertex = glCreateShader(GL_VERTEX_SHADER);
+    build->fragment = glCreateShader(GL_FRAGMENT_SHADER);
+    build->program = glCreateProgram();
+    if (build->vertex && build->fragment && build->program) {
+        glShaderSource(build->vertex, 1, &vertexSource, nullptr);
+        glCompileShader(build->vertex);
+        glShaderSource(build->fragment, 1, &fragmentSource, nullptr);
+        glCompileShader(build->fragment);
+        glAttachShader(build->program, build->vertex);
+        glAttachShader(build->program, build->fragment);
+        if (gl_extension(getProgramBinary)) {
+            glProgramParameteri(build->program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        glLinkProgram(build->program);
+    }
+}
+
+b32 ShaderBuildReady(const ShaderBuild* build) {
+    if (build->fromCache || !(build->vertex && build->fragment && build->program)) {
+        return true;
+    }
+    return ShaderProgramReady(build->program);
+}
+
+GLuint ShaderBuildEnd(ShaderCache* cache, ShaderBuild* build) {
+    if (build->fromCache) {
+        return build->program;
+    }
+
+    b32 success = false;
+    if (build->vertex && build->fragment && build->program) {
+        ShaderWaitForProgram(build->program);
+        GLint vertexResult = 0;
+        glGetShaderiv(build->vertex, GL_COMPILE_STATUS, &vertexResult);
+        GLint fragmentResult = 0;
+        glGetShaderiv(build->fragment, GL_COMPILE_STATUS, &fragmentResult);
+        GLint linkResult = 0;
+        glGetProgramiv(build->program, GL_LINK_STATUS, &linkResult);
+
+        if (!vertexResult) {
+            GLint logLength;
+            glGetShaderiv(build->vertex, GL_INFO_LOG_LENGTH, &logLength);
+            char* message = (char*)PlatformAllocate(logLength, 0, nullptr);
+            glGetShaderInfoLog(build->vertex, logLength, nullptr, message);
+            log_print("[Error]: Failed to compile vertex shader (%s)\n%s", build->name, message);
+            PlatformDeallocate(message, nullptr);
+        } else if (!fragmentResult) {
+            GLint logLength;
+            glGetShaderiv(build->fragment, GL_INFO_LOG_LENGTH, &logLength);
+            char* message = (char*)PlatformAllocate(logLength, 0, nullptr);
+            glGetShaderInfoLog(build->fragment, logLength, nullptr, message);
+            log_print("[Error]: Failed to compile frag shader (%s)\n%s\n", build->name, message);
+            PlatformDeallocate(message, nullptr);
+        } else if (!linkResult) {
+            i32 logLength;
+            glGetProgramiv(build->program, GL_INFO_LOG_LENGTH, &logLength);
+            char* message = (char*)PlatformAllocate(logLength, 0, nullptr);
+            glGetProgramInfoLog(build->program, logLength, 0, message);
+            log_print("[Error]: Failed to link shader program (%s) \n%s\n", build->name, message);
+            PlatformDeallocate(message, nullptr);
+        } else {
+            success = true;
+        }
+    } else {
+        log_print("[Error]: Failed to create shader objects (%s)\n", build->name);
+    }
+
+    if (build->vertex) {
+        glDeleteShader(build->vertex);
+    }
+    if (build->fragment) {
+        glDeleteShader(build->fragment);
+    }
+
+    if (!success) {
+        if (build->program) {
+            glDeleteProgram(build->program);
+        }
+        return 0;
+    }
+
+    if (gl_extension(getProgramBinary)) {
+        ShaderCacheSave(build);
+    }
+    return build->program;
+}
+
+GLuint CompileGLSL(ShaderCache* cache, const char* name, const char* vertexSource, const char* fragmentSource) {
+    ShaderBuild build;
+    ShaderBuildBegin(cache, &build, name, vertexSource, fragmentSource);
+    return ShaderBuildEnd(cache, &build);
+}
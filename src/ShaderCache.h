@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Common.h"
+
+// NOTE: Linked program binaries are saved to files and loaded on later runs instead of compiling
+// the sources. Binaries are valid only for the driver which produced them, so the driver strings
+// are a part of the cache key
+struct ShaderCache {
+    u64 driverHash;
+    // Updated by the GL worker thread as well
+    volatile u32 hits;
+    volatile u32 misses;
+};
+
+// NOTE: Program which is being built. Programs are built in two steps, so the driver can compile
+// several of them in parallel in between
+struct ShaderBuild {
+    char filename[64];
+    const char* name;
+    // Hash of the sources and the driver
+    u64 key;
+    GLuint vertex;
+    GLuint fragment;
+    GLuint program;
+    b32 fromCache;
+};
+
+void ShaderCacheInit(ShaderCache* cache);
+// Loads the program binary from the cache or starts compiling the program from source
+void ShaderBuildBegin(ShaderCache* cache, ShaderBuild* build, const char* name, const char* vertexSource, const char* fragmentSource);
+// Returns true if ShaderBuildEnd will not block. Always true without KHR_parallel_shader_compile
+b32 ShaderBuildReady(const ShaderBuild* build);
+// Waits for the program, reports errors and saves the binary to the cache. Returns zero on failure
+GLuint ShaderBuildEnd(ShaderCache* cache, ShaderBuild* build);
+// Both steps at once
+GLuint CompileGLSL(ShaderCache* cache, const char* name, const char* vertexSource, const char* fragmentSource);
@@ -0,0 +1,122 @@
+#include "ShaderReload.h"
+#include "EmbeddedShaders.h"
+
+void ShaderSourceInit(ShaderSource* source, ShaderCache* cache, const char* directory, const char* name) {
+    *source = {};
+    strncpy(source->name, name, array_count(source->name) - 1);
+    source->cache = cache;
+    snprintf(source->vertexPath, array_count(source->vertexPath), "%s%s.vert", directory, name);
+    snprintf(source->fragmentPath, array_count(source->fragmentPath), "%s%s.frag", directory, name);
+}
+
+// Returns null if the file can not be read
+char* ShaderSourceReadFile(const char* path) {
+    char* result = nullptr;
+    u32 size = PlatformDebugGetFileSize(path);
+    if (size) {
+        result = (char*)PlatformAllocate(size + 1, 0, nullptr);
+        assert(result);
+        if (!PlatformDebugReadTextFile(result, size + 1, path)) {
+            PlatformDeallocate(result, nullptr);
+            result = nullptr;
+        }
+    }
+    if (!result) {
+        log_print("[Renderer] Failed to read shader file %s\n", path);
+    }
+    return result;
+}
+
+b32 ShaderSourceLoad(ShaderSource* source) {
+    assert(!source->vertex && !source->fragment);
+    // NOTE(swarzzy): Write times are taken before reading, so changes made while reading are not missed
+    source->vertexWriteTime = PlatformDebugGetFileWriteTime(source->vertexPath);
+    source->fragmentWriteTime = PlatformDebugGetFileWriteTime(source->fragmentPath);
+    source->vertex = ShaderSourceReadFile(source->vertexPath);
+    source->fragment = ShaderSourceReadFile(source->fragmentPath);
+    if (!source->vertex || !source->fragment) {
+        ShaderSourceFree(source);
+        return false;
+    }
+    return true;
+}
+
+char* ShaderSourceCopyText(const char* text) {
+    u32 size = (u32)strlen(text) + 1;
+    char* result = (char*)PlatformAllocate(size, 0, nullptr);
+    assert(result);
+    memcpy(result, text, size);
+    return result;
+}
+
+b32 ShaderSourceLoadEmbedded(ShaderSource* source) {
+    assert(!source->vertex && !source->fragment);
+    for (u32 i = 0; i < array_count(EmbeddedShaders); i++) {
+        const EmbeddedShader* shader = EmbeddedShaders + i;
+        if (strcmp(shader->name, source->name) == 0) {
+            // NOTE(swarzzy): Copies are owned the same way as loaded files, so the rest of the code does not care where sources came from
+            source->vertex = ShaderSourceCopyText(shader->vertex);
+            source->fragment = ShaderSourceCopyText(shader->fragment);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ShaderSourceFree(ShaderSource* source) {
+    if (source->vertex) {
+        PlatformDeallocate(source->vertex, nullptr);
+        source->vertex = nullptr;
+    }
+    if (source->fragment) {
+        PlatformDeallocate(source->fragment, nullptr);
+        source->fragment = nullptr;
+    }
+}
+
+void ShaderSourceBuildJob(void* data, u32 threadIndex) {
+    ShaderSource* source = (ShaderSource*)data;
+    GLuint program = CompileGLSL(source->cache, source->name, source->vertex, source->fragment);
+    // NOTE(swarzzy): Objects are shared between the contexts, but commands which built the program
+    // have to be complete before the other context can use it
+    glFinish();
+    ShaderSourceFree(source);
+    if (program) {
+        AtomicStore(&source->readyProgram, program);
+    }
+    AtomicStore(&source->busy, 0);
+}
+
+b32 ShaderSourceWatch(ShaderSource* source) {
+    // NOTE(swarzzy): Waiting until the previous result is taken, otherwise it would be overwritten
+    if (AtomicLoad(&source->busy) || AtomicLoad(&source->readyProgram)) {
+        return false;
+    }
+
+    u64 vertexWriteTime = PlatformDebugGetFileWriteTime(source->vertexPath);
+    u64 fragmentWriteTime = PlatformDebugGetFileWriteTime(source->fragmentPath);
+    // NOTE(swarzzy): Editors may remove the file for a moment while saving it
+    if (!vertexWriteTime || !fragmentWriteTime) {
+        return false;
+    }
+    if (vertexWriteTime == source->vertexWriteTime && fragmentWriteTime == source->fragmentWriteTime) {
+        return false;
+    }
+
+    if (!ShaderSourceLoad(source)) {
+        // NOTE(swarzzy): Not trying again until the files are changed once more
+        source->vertexWriteTime = vertexWriteTime;
+        source->fragmentWriteTime = fragmentWriteTime;
+        return false;
+    }
+
+    log_print("[Renderer] Rebuilding program (%s)\n", source->name);
+    AtomicStore(&source->busy, 1);
+    PlatformPushGLWork(ShaderSourceBuildJob, source);
+    return true;
+}
+
+GLuint ShaderSourceTakeProgram(ShaderSource* source) {
+    GLuint result = AtomicExchange(&source->readyProgram, 0);
+    return result;
+}
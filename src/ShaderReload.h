@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Common.h"
+#include "ShaderCache.h"
+
+// NOTE: Program built from a pair of source files which are watched for changes. Changed programs are
+// rebuilt in the background on the platform GL thread and picked up by the renderer only if they link,
+// so a broken edit keeps the old program running. Platform finishes GL jobs before it reloads game code
+struct EmbeddedShader {
+    const char* name;
+    const char* vertex;
+    const char* fragment;
+};
+
+struct ShaderSource {
+    static const u32 MaxPathLength = 128;
+    static const u32 MaxNameLength = 32;
+
+    // NOTE(swarzzy): Copied, so the source does not point into the game library which may be reloaded
+    char name[MaxNameLength];
+    char vertexPath[MaxPathLength];
+    char fragmentPath[MaxPathLength];
+    // Write times of the files when they were read last time
+    u64 vertexWriteTime;
+    u64 fragmentWriteTime;
+    // Loaded sources. Owned by the build job while it is in flight
+    char* vertex;
+    char* fragment;
+    ShaderCache* cache;
+
+    // Program which was rebuilt but not yet taken by the renderer
+    volatile u32 readyProgram;
+    // Set while a build job is in flight
+    volatile u32 busy;
+};
+
+// Files are <directory><name>.vert and <directory><name>.frag
+void ShaderSourceInit(ShaderSource* source, ShaderCache* cache, const char* directory, const char* name);
+// Reads both files. Returns false if any of them can not be read
+b32 ShaderSourceLoad(ShaderSource* source);
+// Takes sources which were built into the game by gen_embedded_shaders.sh. Returns false if there are no sources with this name
+b32 ShaderSourceLoadEmbedded(ShaderSource* source);
+void ShaderSourceFree(ShaderSource* source);
+// Starts rebuilding the program if the files were changed since they were read. Returns true if the build was started
+b32 ShaderSourceWatch(ShaderSource* source);
+// Returns the rebuilt program once it is ready, zero otherwise. Caller owns the program
+GLuint ShaderSourceTakeProgram(ShaderSource* source);
@@ -0,0 +1,583 @@
+#include "SoftwareRenderer.h"
+
+// Window space vertex of a quad
+struct SoftwareVertex {
+    f32 x;
+    f32 y;
+    f32 z;
+    v2 local;
+};
+
+// R goes to the lowest byte, so the buffer is laid out as GL_RGBA, GL_UNSIGNED_BYTE
+inline u32 SoftwarePackColor(v4 color) {
+    u32 r = (u32)(Saturate(color.r) * 255.0f + 0.5f);
+    u32 g = (u32)(Saturate(color.g) * 255.0f + 0.5f);
+    u32 b = (u32)(Saturate(color.b) * 255.0f + 0.5f);
+    u32 a = (u32)(Saturate(color.a) * 255.0f + 0.5f);
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+inline v4 SoftwareUnpackColor(u32 color) {
+    const f32 scale = 1.0f / 255.0f;
+    return V4((f32)(color & 0xff) * scale, (f32)((color >> 8) & 0xff) * scale, (f32)((color >> 16) & 0xff) * scale, (f32)(color >> 24) * scale);
+}
+
+void SoftwareRendererInit(SoftwareRenderer* renderer, u32 width, u32 height) {
+    *renderer = {};
+    SoftwareRendererResize(renderer, width, height);
+}
+
+void SoftwareRendererResize(SoftwareRenderer* renderer, u32 width, u32 height) {
+    if (renderer->width == width && renderer->height == height && renderer->color) {
+        return;
+    }
+
+    if (renderer->color) {
+        PlatformDeallocate(renderer->color, nullptr);
+        PlatformDeallocate(renderer->depth, nullptr);
+        PlatformDeallocate(renderer->binOffsets, nullptr);
+        PlatformDeallocate(renderer->binCounts, nullptr);
+    }
+
+    renderer->width = Max(width, 1u);
+    renderer->height = Max(height, 1u);
+    renderer->tilesX = (renderer->width + SoftwareRenderer::TileSize - 1) / SoftwareRenderer::TileSize;
+    renderer->tilesY = (renderer->height + SoftwareRenderer::TileSize - 1) / SoftwareRenderer::TileSize;
+    u32 pixelCount = renderer->width * renderer->height;
+    u32 tileCount = renderer->tilesX * renderer->tilesY;
+    renderer->color = (u32*)PlatformAllocate(sizeof(u32) * pixelCount, 32, nullptr);
+    renderer->depth = (f32*)PlatformAllocate(sizeof(f32) * pixelCount, 32, nullptr);
+    renderer->binOffsets = (u32*)PlatformAllocate(sizeof(u32) * tileCount, 0, nullptr);
+    renderer->binCounts = (u32*)PlatformAllocate(sizeof(u32) * tileCount, 0, nullptr);
+    assert(renderer->color && renderer->depth && renderer->binOffsets && renderer->binCounts);
+}
+
+void SoftwareRendererFree(SoftwareRenderer* renderer) {
+    if (renderer->color) {
+        PlatformDeallocate(renderer->color, nullptr);
+        PlatformDeallocate(renderer->depth, nullptr);
+        PlatformDeallocate(renderer->binOffsets, nullptr);
+        PlatformDeallocate(renderer->binCounts, nullptr);
+    }
+    if (renderer->binIndices) {
+        PlatformDeallocate(renderer->binIndices, nullptr);
+    }
+    if (renderer->primitives) {
+        PlatformDeallocate(renderer->primitives, nullptr);
+        PlatformDeallocate(renderer->shapeEntries, nullptr);
+        PlatformDeallocate(renderer->shapeTempEntries, nullptr);
+    }
+    *renderer = {};
+}
+
+void SoftwareRendererReservePrimitives(SoftwareRenderer* renderer, u32 count) {
+    if (count > renderer->primitiveCapacity) {
+        if (renderer->primitives) {
+            PlatformDeallocate(renderer->primitives, nullptr);
+            PlatformDeallocate(renderer->shapeEntries, nullptr);
+            PlatformDeallocate(renderer->shapeTempEntries, nullptr);
+        }
+        renderer->primitiveCapacity = NextPowerOfTwo(count);
+        renderer->primitives = (SoftwarePrimitive*)PlatformAllocate(sizeof(SoftwarePrimitive) * renderer->primitiveCapacity, 0, nullptr);
+        renderer->shapeEntries = (RenderSortEntry*)PlatformAllocate(sizeof(RenderSortEntry) * renderer->primitiveCapacity, 0, nullptr);
+        renderer->shapeTempEntries = (RenderSortEntry*)PlatformAllocate(sizeof(RenderSortEntry) * renderer->primitiveCapacity, 0, nullptr);
+        assert(renderer->primitives && renderer->shapeEntries && renderer->shapeTempEntries);
+    }
+}
+
+// Projects a point to window pixels. Fails for points behind the camera
+b32 SoftwareProjectVertex(const SoftwareRenderer* renderer, const m4x4* view, v3 p, SoftwareVertex* vertex) {
+    v4 clip = *view * V4(p, 1.0f);
+    if (clip.w <= 0.0f) {
+        return false;
+    }
+    f32 invW = 1.0f / clip.w;
+    vertex->x = (clip.x * invW * 0.5f + 0.5f) * (f32)renderer->width;
+    vertex->y = (clip.y * invW * 0.5f + 0.5f) * (f32)renderer->height;
+    vertex->z = clip.z * invW * 0.5f + 0.5f;
+    vertex->local = V2(0.0f);
+    return true;
+}
+
+// Plane of an attribute over window space through three vertices: value = dx * x + dy * y + d0
+void SoftwareAttributePlane(const SoftwareVertex* v0, const SoftwareVertex* v1, const SoftwareVertex* v2, f32 f0, f32 f1, f32 f2, f32 invDet, f32* dx, f32* dy, f32* d0) {
+    *dx = ((f1 - f0) * (v2->y - v0->y) - (f2 - f0) * (v1->y - v0->y)) * invDet;
+    *dy = ((f2 - f0) * (v1->x - v0->x) - (f1 - f0) * (v2->x - v0->x)) * invDet;
+    *d0 = f0 - *dx * v0->x - *dy * v0->y;
+}
+
+// Sets up edge functions, attribute planes and bounds of a convex quad with vertices going around it.
+// Returns false if the quad does not cover any pixel
+b32 SoftwareSetupQuad(const SoftwareRenderer* renderer, const SoftwareVertex* v, v4 viewClip, SoftwarePrimitive* primitive) {
+    f32 area = 0.0f;
+    for (u32 i = 0; i < 4; i++) {
+        const SoftwareVertex* a = v + i;
+        const SoftwareVertex* b = v + (i + 1) % 4;
+        area += a->x * b->y - b->x * a->y;
+    }
+    if (Abs(area) < 1e-6f) {
+        return false;
+    }
+
+    // NOTE(swarzzy): Interior is on the left of every edge of a counter-clockwise quad, so edges
+    // of clockwise quads are flipped
+    f32 sign = area > 0.0f ? 1.0f : -1.0f;
+    f32 minX = F32::Max, minY = F32::Max, maxX = -F32::Max, maxY = -F32::Max;
+    for (u32 i = 0; i < 4; i++) {
+        const SoftwareVertex* a = v + i;
+        const SoftwareVertex* b = v + (i + 1) % 4;
+        f32 dx = b->x - a->x;
+        f32 dy = b->y - a->y;
+        primitive->edgeA[i] = -dy * sign;
+        primitive->edgeB[i] = dx * sign;
+        primitive->edgeC[i] = (dy * a->x - dx * a->y) * sign;
+        minX = Min(minX, a->x);
+        minY = Min(minY, a->y);
+        maxX = Max(maxX, a->x);
+        maxY = Max(maxY, a->y);
+    }
+
+    // Attributes are planar over the quad, so the bigger of two triangles gives the most precise plane
+    f32 det013 = (v[1].x - v[0].x) * (v[3].y - v[0].y) - (v[3].x - v[0].x) * (v[1].y - v[0].y);
+    f32 det012 = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+    const SoftwareVertex* p2 = Abs(det013) >= Abs(det012) ? v + 3 : v + 2;
+    f32 det = Abs(det013) >= Abs(det012) ? det013 : det012;
+    f32 invDet = 1.0f / det;
+    SoftwareAttributePlane(v, v + 1, p2, v[0].z, v[1].z, p2->z, invDet, &primitive->depthX, &primitive->depthY, &primitive->depth0);
+    if (primitive->shape) {
+        SoftwareAttributePlane(v, v + 1, p2, v[0].local.x, v[1].local.x, p2->local.x, invDet, &primitive->localX.x, &primitive->localY.x, &primitive->local0.x);
+        SoftwareAttributePlane(v, v + 1, p2, v[0].local.y, v[1].local.y, p2->local.y, invDet, &primitive->localX.y, &primitive->localY.y, &primitive->local0.y);
+    }
+
+    // NOTE(swarzzy): Pixel is covered if its center is inside, so bounds are half-open ranges of pixel centers
+    f32 width = (f32)renderer->width;
+    f32 height = (f32)renderer->height;
+    f32 clipMinX = (Clamp(viewClip.x, -1.0f, 1.0f) * 0.5f + 0.5f) * width;
+    f32 clipMinY = (Clamp(viewClip.y, -1.0f, 1.0f) * 0.5f + 0.5f) * height;
+    f32 clipMaxX = (Clamp(viewClip.z, -1.0f, 1.0f) * 0.5f + 0.5f) * width;
+    f32 clipMaxY = (Clamp(viewClip.w, -1.0f, 1.0f) * 0.5f + 0.5f) * height;
+    primitive->minX = (i32)Ceil(Max(minX, clipMinX) - 0.5f);
+    primitive->minY = (i32)Ceil(Max(minY, clipMinY) - 0.5f);
+    primitive->maxX = (i32)Ceil(Min(maxX, clipMaxX) - 0.5f);
+    primitive->maxY = (i32)Ceil(Min(maxY, clipMaxY) - 0.5f);
+    return primitive->minX < primitive->maxX && primitive->minY < primitive->maxY;
+}
+
+// Appends the primitive if it is visible
+void SoftwarePushQuad(SoftwareRenderer* renderer, const Canvas* canvas, u32 viewIndex, const SoftwareVertex* vertices, SoftwarePrimitive* primitive) {
+    if (SoftwareSetupQuad(renderer, vertices, canvas->viewClips[viewIndex], primitive)) {
+        renderer->primitives[renderer->primitiveCount++] = *primitive;
+    }
+}
+
+void SoftwarePushRect(SoftwareRenderer* renderer, const Canvas* canvas, const RenderCommand* command) {
+    const m4x4* view = canvas->views + command->viewIndex;
+    v2 min = command->rectColor.min;
+    v2 max = command->rectColor.max;
+    f32 z = command->rectColor.z;
+    SoftwareVertex vertices[4];
+    if (!SoftwareProjectVertex(renderer, view, V3(min.x, min.y, z), vertices + 0) ||
+        !SoftwareProjectVertex(renderer, view, V3(max.x, min.y, z), vertices + 1) ||
+        !SoftwareProjectVertex(renderer, view, V3(max.x, max.y, z), vertices + 2) ||
+        !SoftwareProjectVertex(renderer, view, V3(min.x, max.y, z), vertices + 3)) {
+        renderer->stats.primitivesClipped++;
+        return;
+    }
+
+    // NOTE(swarzzy): Solid primitives are not blended, so their alpha is always one like in the uber-shader
+    SoftwarePrimitive primitive = {};
+    primitive.color = V4(command->rectColor.color.xyz, 1.0f);
+    primitive.packedColor = SoftwarePackColor(primitive.color);
+    SoftwarePushQuad(renderer, canvas, command->viewIndex, vertices, &primitive);
+}
+
+// Line is extruded in window space, so its thickness is in pixels
+void SoftwarePushLine(SoftwareRenderer* renderer, const Canvas* canvas, const RenderCommand* command) {
+    const m4x4* view = canvas->views + command->viewIndex;
+    SoftwareVertex begin, end;
+    if (!SoftwareProjectVertex(renderer, view, command->line.begin, &begin) ||
+        !SoftwareProjectVertex(renderer, view, command->line.end, &end)) {
+        renderer->stats.primitivesClipped++;
+        return;
+    }
+
+    v2 dir = V2(end.x - begin.x, end.y - begin.y);
+    f32 len = Length(dir);
+    dir = len > 0.0f ? dir * (1.0f / len) : V2(1.0f, 0.0f);
+    v2 offset = V2(-dir.y, dir.x) * (command->line.thickness * 0.5f);
+
+    SoftwareVertex vertices[4];
+    vertices[0] = { begin.x - offset.x, begin.y - offset.y, begin.z, V2(0.0f) };
+    vertices[1] = { end.x - offset.x, end.y - offset.y, end.z, V2(0.0f) };
+    vertices[2] = { end.x + offset.x, end.y + offset.y, end.z, V2(0.0f) };
+    vertices[3] = { begin.x + offset.x, begin.y + offset.y, begin.z, V2(0.0f) };
+
+    SoftwarePrimitive primitive = {};
+    primitive.color = V4(command->line.color.xyz, 1.0f);
+    primitive.packedColor = SoftwarePackColor(primitive.color);
+    SoftwarePushQuad(renderer, canvas, command->viewIndex, vertices, &primitive);
+}
+
+// Circles, rounded rects and capsules are rounded rects in their own space, same as in the uber-shader
+void SoftwarePushShape(SoftwareRenderer* renderer, const Canvas* canvas, const RenderCommand* command) {
+    const m4x4* view = canvas->views + command->viewIndex;
+    v2 a = command->shape.a;
+    v2 b = command->shape.b;
+    f32 radius = command->shape.radius;
+
+    SoftwarePrimitive primitive = {};
+    primitive.shape = true;
+    primitive.color = command->shape.color;
+
+    v2 center = (a + b) * 0.5f;
+    v2 axis = V2(1.0f, 0.0f);
+    if (command->type == RenderCommandType::Capsule) {
+        v2 dir = b - a;
+        f32 len = Length(dir);
+        axis = len > 0.0f ? dir * (1.0f / len) : axis;
+        primitive.halfSize = V2(len * 0.5f + radius, radius);
+        primitive.radius = radius;
+    } else {
+        primitive.halfSize = V2(Abs(b.x - a.x) * 0.5f, Abs(b.y - a.y) * 0.5f);
+        primitive.radius = Min(radius, Min(primitive.halfSize.x, primitive.halfSize.y));
+    }
+    v2 normal = V2(-axis.y, axis.x);
+
+    // NOTE(swarzzy): Quad gets one pixel of margin for anti-aliasing
+    f32 pixelX = 2.0f / ((f32)renderer->width * Length(V2(view->_11, view->_21)));
+    f32 pixelY = 2.0f / ((f32)renderer->height * Length(V2(view->_12, view->_22)));
+    v2 extent = primitive.halfSize + V2(Max(pixelX, pixelY));
+
+    const v2 corners[4] = { V2(-1.0f, -1.0f), V2(1.0f, -1.0f), V2(1.0f, 1.0f), V2(-1.0f, 1.0f) };
+    SoftwareVertex vertices[4];
+    for (u32 i = 0; i < 4; i++) {
+        v2 local = V2(corners[i].x * extent.x, corners[i].y * extent.y);
+        v2 position = center + axis * local.x + normal * local.y;
+        if (!SoftwareProjectVertex(renderer, view, V3(position, command->shape.z), vertices + i)) {
+            renderer->stats.primitivesClipped++;
+            return;
+        }
+        vertices[i].local = local;
+    }
+
+    SoftwarePushQuad(renderer, canvas, command->viewIndex, vertices, &primitive);
+}
+
+inline f32 SoftwareEdge(const SoftwarePrimitive* primitive, u32 edge, f32 x, f32 y) {
+    return primitive->edgeA[edge] * x + primitive->edgeB[edge] * y + primitive->edgeC[edge];
+}
+
+// True if the quad may cover pixel centers of the rect. Every edge is checked at the rect corner
+// where the edge function is the biggest
+b32 SoftwareQuadTouchesRect(const SoftwarePrimitive* primitive, f32 minX, f32 minY, f32 maxX, f32 maxY) {
+    for (u32 i = 0; i < 4; i++) {
+        f32 x = primitive->edgeA[i] > 0.0f ? maxX : minX;
+        f32 y = primitive->edgeB[i] > 0.0f ? maxY : minY;
+        if (SoftwareEdge(primitive, i, x, y) < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SoftwareRendererBin(SoftwareRenderer* renderer, const Canvas* canvas, const RenderQueue* queue) {
+    renderer->stats = {};
+    renderer->primitiveCount = 0;
+    renderer->clearColor = SoftwarePackColor(canvas->clearColor);
+    SoftwareRendererReservePrimitives(renderer, queue->rectBufferAt + queue->lineBufferAt + queue->shapeBufferAt);
+
+    // NOTE(swarzzy): Same order as the GL renderer: opaque rects, then lines, then shapes back to front
+    for (u32 i = 0; i < queue->rectBufferAt; i++) {
+        assert(queue->rectBuffer[i].viewIndex < canvas->viewCount);
+        SoftwarePushRect(renderer, canvas, queue->rectBuffer + i);
+    }
+    for (u32 i = 0; i < queue->lineBufferAt; i++) {
+        assert(queue->lineBuffer[i].viewIndex < canvas->viewCount);
+        SoftwarePushLine(renderer, canvas, queue->lineBuffer + i);
+    }
+
+    u32 shapeCount = 0;
+    for (u32 i = 0; i < queue->shapeBufferAt; i++) {
+        if (queue->shapeBuffer[i].type == RenderCommandType::Sprite) {
+            renderer->stats.spritesSkipped++;
+        } else {
+            renderer->shapeEntries[shapeCount++] = RenderSortEntry { ~RenderSortKeyFromDepth(queue->shapeBuffer[i].shape.z), i };
+        }
+    }
+    RenderSortEntries(renderer->shapeEntries, renderer->shapeTempEntries, shapeCount);
+    for (u32 i = 0; i < shapeCount; i++) {
+        const RenderCommand* command = queue->shapeBuffer + renderer->shapeEntries[i].index;
+        assert(command->viewIndex < canvas->viewCount);
+        SoftwarePushShape(renderer, canvas, command);
+    }
+    renderer->stats.primitives = renderer->primitiveCount;
+
+    // NOTE(swarzzy): First pass counts primitives of every tile, second one writes their indices
+    const u32 tileSize = SoftwareRenderer::TileSize;
+    u32 tileCount = renderer->tilesX * renderer->tilesY;
+    memset(renderer->binCounts, 0, sizeof(u32) * tileCount);
+    for (u32 pass = 0; pass < 2; pass++) {
+        for (u32 i = 0; i < renderer->primitiveCount; i++) {
+            const SoftwarePrimitive* primitive = renderer->primitives + i;
+            u32 tileMinX = (u32)primitive->minX / tileSize;
+            u32 tileMinY = (u32)primitive->minY / tileSize;
+            u32 tileMaxX = (u32)(primitive->maxX - 1) / tileSize;
+            u32 tileMaxY = (u32)(primitive->maxY - 1) / tileSize;
+            for (u32 y = tileMinY; y <= tileMaxY; y++) {
+                for (u32 x = tileMinX; x <= tileMaxX; x++) {
+                    f32 minX = (f32)(x * tileSize) + 0.5f;
+                    f32 minY = (f32)(y * tileSize) + 0.5f;
+                    if (SoftwareQuadTouchesRect(primitive, minX, minY, minX + (f32)(tileSize - 1), minY + (f32)(tileSize - 1))) {
+                        u32 tile = y * renderer->tilesX + x;
+                        if (pass) {
+                            renderer->binIndices[renderer->binOffsets[tile] + renderer->binCounts[tile]] = i;
+                        }
+                        renderer->binCounts[tile]++;
+                    }
+                }
+            }
+        }
+
+        if (!pass) {
+            u32 total = 0;
+            for (u32 tile = 0; tile < tileCount; tile++) {
+                renderer->binOffsets[tile] = total;
+                total += renderer->binCounts[tile];
+                renderer->binCounts[tile] = 0;
+            }
+            renderer->stats.binned = total;
+            if (total > renderer->binIndexCapacity) {
+                if (renderer->binIndices) {
+                    PlatformDeallocate(renderer->binIndices, nullptr);
+                }
+                renderer->binIndexCapacity = NextPowerOfTwo(total);
+                renderer->binIndices = (u32*)PlatformAllocate(sizeof(u32) * renderer->binIndexCapacity, 0, nullptr);
+                assert(renderer->binIndices);
+            }
+        }
+    }
+}
+
+// Depth tests and writes a span of an opaque primitive. Depth goes linearly from z with step dzdx.
+// Fragments outside of the depth range are clipped like in GL
+void SoftwareFillSpan(u32* color, f32* depth, u32 count, f32 z, f32 dzdx, u32 packedColor) {
+    u32 i = 0;
+
+#if defined(SIMD_AVX2)
+    {
+        __m256 z0 = _mm256_set1_ps(z);
+        __m256 dz = _mm256_set1_ps(dzdx);
+        __m256 lanes = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+        __m256 zero = _mm256_setzero_ps();
+        __m256i source = _mm256_set1_epi32((int)packedColor);
+        for (; i + 8 <= count; i += 8) {
+            __m256 fragment = _mm256_add_ps(z0, _mm256_mul_ps(dz, _mm256_add_ps(_mm256_set1_ps((f32)i), lanes)));
+            __m256 dest = _mm256_loadu_ps(depth + i);
+            __m256 pass = _mm256_and_ps(_mm256_cmp_ps(fragment, dest, _CMP_LE_OQ), _mm256_cmp_ps(fragment, zero, _CMP_GE_OQ));
+            _mm256_storeu_ps(depth + i, _mm256_blendv_ps(dest, fragment, pass));
+            __m256i pixels = _mm256_loadu_si256((const __m256i*)(color + i));
+            _mm256_storeu_si256((__m256i*)(color + i), _mm256_blendv_epi8(pixels, source, _mm256_castps_si256(pass)));
+        }
+    }
+#endif
+
+#if defined(SIMD_SSE2)
+    {
+        __m128 z0 = _mm_set1_ps(z);
+        __m128 dz = _mm_set1_ps(dzdx);
+        __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+        __m128 zero = _mm_setzero_ps();
+        __m128i source = _mm_set1_epi32((int)packedColor);
+        for (; i + 4 <= count; i += 4) {
+            __m128 fragment = _mm_add_ps(z0, _mm_mul_ps(dz, _mm_add_ps(_mm_set1_ps((f32)i), lanes)));
+            __m128 dest = _mm_loadu_ps(depth + i);
+            __m128 pass = _mm_and_ps(_mm_cmple_ps(fragment, dest), _mm_cmpge_ps(fragment, zero));
+            _mm_storeu_ps(depth + i, _mm_or_ps(_mm_and_ps(pass, fragment), _mm_andnot_ps(pass, dest)));
+            __m128i mask = _mm_castps_si128(pass);
+            __m128i pixels = _mm_loadu_si128((const __m128i*)(color + i));
+            _mm_storeu_si128((__m128i*)(color + i), _mm_or_si128(_mm_and_si128(mask, source), _mm_andnot_si128(mask, pixels)));
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        f32 fragment = z + dzdx * (f32)i;
+        if (fragment <= depth[i] && fragment >= 0.0f) {
+            depth[i] = fragment;
+            color[i] = packedColor;
+        }
+    }
+}
+
+// Blends a span of an anti-aliased shape. Coverage is the signed distance to the rounded rect over
+// its change across one pixel, like fwidth in the uber-shader
+void SoftwareBlendShapeSpan(const SoftwarePrimitive* primitive, u32* color, f32* depth, i32 beginX, i32 endX, f32 y) {
+    for (i32 x = beginX; x < endX; x++) {
+        f32 px = (f32)x + 0.5f;
+        f32 fragment = primitive->depthX * px + primitive->depthY * y + primitive->depth0;
+        u32 at = (u32)(x - beginX);
+        if (fragment > depth[at] || fragment < 0.0f) {
+            continue;
+        }
+
+        v2 local = primitive->local0 + primitive->localX * px + primitive->localY * y;
+        v2 q = V2(Abs(local.x), Abs(local.y)) - primitive->halfSize + V2(primitive->radius);
+        v2 outside = V2(Max(q.x, 0.0f), Max(q.y, 0.0f));
+        f32 outsideLength = Length(outside);
+        f32 dist = outsideLength + Min(Max(q.x, q.y), 0.0f) - primitive->radius;
+
+        v2 gradient = outsideLength > 0.0f ? outside * (1.0f / outsideLength) : (q.x > q.y ? V2(1.0f, 0.0f) : V2(0.0f, 1.0f));
+        gradient.x = local.x < 0.0f ? -gradient.x : gradient.x;
+        gradient.y = local.y < 0.0f ? -gradient.y : gradient.y;
+        f32 width = Max(Abs(Dot(gradient, primitive->localX)) + Abs(Dot(gradient, primitive->localY)), 1e-5f);
+        f32 coverage = Clamp(0.5f - dist / width, 0.0f, 1.0f);
+        if (coverage <= 0.0f) {
+            continue;
+        }
+
+        // NOTE(swarzzy): glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA)
+        f32 alpha = primitive->color.a * coverage;
+        v4 dest = SoftwareUnpackColor(color[at]);
+        v4 result;
+        result.r = primitive->color.r * alpha + dest.r * (1.0f - alpha);
+        result.g = primitive->color.g * alpha + dest.g * (1.0f - alpha);
+        result.b = primitive->color.b * alpha + dest.b * (1.0f - alpha);
+        result.a = alpha + dest.a * (1.0f - alpha);
+        color[at] = SoftwarePackColor(result);
+        depth[at] = fragment;
+    }
+}
+
+// Rasterizes binned primitives of the tile. Returns the number of primitives rejected by the tile depth
+u32 SoftwareRasterTile(SoftwareRenderer* renderer, u32 tile) {
+    const i32 tileSize = (i32)SoftwareRenderer::TileSize;
+    i32 tileMinX = (i32)(tile % renderer->tilesX) * tileSize;
+    i32 tileMinY = (i32)(tile / renderer->tilesX) * tileSize;
+    i32 tileMaxX = Min(tileMinX + tileSize, (i32)renderer->width);
+    i32 tileMaxY = Min(tileMinY + tileSize, (i32)renderer->height);
+    u32 stride = renderer->width;
+
+    for (i32 y = tileMinY; y < tileMaxY; y++) {
+        u32* color = renderer->color + y * stride;
+        f32* depth = renderer->depth + y * stride;
+        for (i32 x = tileMinX; x < tileMaxX; x++) {
+            color[x] = renderer->clearColor;
+            depth[x] = 1.0f;
+        }
+    }
+
+    // NOTE(swarzzy): Farthest depth of the tile known so far. Opaque primitives which cover the whole
+    // tile lower it, so primitives behind them are rejected without touching pixels
+    f32 tileMaxDepth = 1.0f;
+    u32 rejected = 0;
+
+    const u32* indices = renderer->binIndices + renderer->binOffsets[tile];
+    u32 count = renderer->binCounts[tile];
+    for (u32 i = 0; i < count; i++) {
+        const SoftwarePrimitive* primitive = renderer->primitives + indices[i];
+        i32 minX = Max(primitive->minX, tileMinX);
+        i32 minY = Max(primitive->minY, tileMinY);
+        i32 maxX = Min(primitive->maxX, tileMaxX);
+        i32 maxY = Min(primitive->maxY, tileMaxY);
+
+        // Depth is planar, so its extremes over the rect are at the corners
+        f32 x0 = (f32)minX + 0.5f;
+        f32 y0 = (f32)minY + 0.5f;
+        f32 x1 = (f32)maxX - 0.5f;
+        f32 y1 = (f32)maxY - 0.5f;
+        f32 zx0 = primitive->depthX * (primitive->depthX > 0.0f ? x0 : x1);
+        f32 zx1 = primitive->depthX * (primitive->depthX > 0.0f ? x1 : x0);
+        f32 zy0 = primitive->depthY * (primitive->depthY > 0.0f ? y0 : y1);
+        f32 zy1 = primitive->depthY * (primitive->depthY > 0.0f ? y1 : y0);
+        f32 nearest = zx0 + zy0 + primitive->depth0;
+        f32 farthest = zx1 + zy1 + primitive->depth0;
+        if (nearest > tileMaxDepth) {
+            rejected++;
+            continue;
+        }
+
+        for (i32 y = minY; y < maxY; y++) {
+            // NOTE(swarzzy): Span of pixel centers of the row inside of all edges
+            f32 py = (f32)y + 0.5f;
+            f32 spanMin = -F32::Max;
+            f32 spanMax = F32::Max;
+            b32 empty = false;
+            for (u32 e = 0; e < 4; e++) {
+                f32 a = primitive->edgeA[e];
+                f32 k = primitive->edgeB[e] * py + primitive->edgeC[e];
+                if (a > 0.0f) {
+                    spanMin = Max(spanMin, -k / a);
+                } else if (a < 0.0f) {
+                    spanMax = Min(spanMax, -k / a);
+                } else if (k < 0.0f) {
+                    empty = true;
+                }
+            }
+            if (empty) {
+                continue;
+            }
+            i32 beginX = Max((i32)Max(Ceil(spanMin - 0.5f), (f32)minX), minX);
+            i32 endX = Min((i32)Min(Ceil(spanMax - 0.5f), (f32)maxX), maxX);
+            if (beginX >= endX) {
+                continue;
+            }
+
+            u32* color = renderer->color + y * stride + beginX;
+            f32* depth = renderer->depth + y * stride + beginX;
+            if (primitive->shape) {
+                SoftwareBlendShapeSpan(primitive, color, depth, beginX, endX, py);
+            } else {
+                f32 z = primitive->depthX * ((f32)beginX + 0.5f) + primitive->depthY * py + primitive->depth0;
+                SoftwareFillSpan(color, depth, (u32)(endX - beginX), z, primitive->depthX, primitive->packedColor);
+            }
+        }
+
+        if (!primitive->shape && nearest >= 0.0f && minX == tileMinX && minY == tileMinY && maxX == tileMaxX && maxY == tileMaxY) {
+            b32 covered = true;
+            for (u32 e = 0; e < 4; e++) {
+                f32 x = primitive->edgeA[e] > 0.0f ? x0 : x1;
+                f32 y = primitive->edgeB[e] > 0.0f ? y0 : y1;
+                if (SoftwareEdge(primitive, e, x, y) < 0.0f) {
+                    covered = false;
+                }
+            }
+            if (covered) {
+                tileMaxDepth = Min(tileMaxDepth, farthest);
+            }
+        }
+    }
+
+    return rejected;
+}
+
+void SoftwareRasterJob(void* data, u32 threadIndex) {
+    auto renderer = (SoftwareRenderer*)data;
+    u32 tileCount = renderer->tilesX * renderer->tilesY;
+    u32 rejected = 0;
+    while (true) {
+        u32 tile = AtomicAdd(&renderer->nextTile, 1);
+        if (tile >= tileCount) {
+            break;
+        }
+        rejected += SoftwareRasterTile(renderer, tile);
+    }
+    if (rejected) {
+        AtomicAdd((volatile u32*)&renderer->stats.tileRejects, rejected);
+    }
+}
+
+void SoftwareRendererRaster(SoftwareRenderer* renderer) {
+    // NOTE(swarzzy): Tiles do not overlap, so jobs take them one by one without any other synchronization
+    u32 tileCount = renderer->tilesX * renderer->tilesY;
+    u32 jobCount = Max(Min(GetPlatform()->threadCount, tileCount), 1u);
+    renderer->nextTile = 0;
+    for (u32 i = 0; i < jobCount; i++) {
+        PlatformPushWork(SoftwareRasterJob, renderer);
+    }
+    PlatformCompleteAllWork();
+}
+
+void SoftwareRendererDraw(SoftwareRenderer* renderer, const Canvas* canvas, const RenderQueue* queue) {
+    SoftwareRendererBin(renderer, canvas, queue);
+    SoftwareRendererRaster(renderer);
+}
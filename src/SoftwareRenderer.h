@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Common.h"
+#include "RenderQueue.h"
+#include "Render.h"
+
+// NOTE: CPU renderer for the same render queue the GL renderer consumes. Commands are projected to window
+// pixels, binned into screen tiles and tiles are rasterized in parallel by platform worker threads. Output is
+// an RGBA8 color buffer and a depth buffer in memory with the bottom left origin, same as glReadPixels gives.
+// It follows the uber-shader: LEQUAL depth test, opaque rects and lines go first in queue order, shapes are
+// blended back to front with anti-aliased edges. Sprites are not supported yet and are skipped
+// The game draws through it when the platform has no OpenGL. render_bench -software -golden checks its output
+// against a reference image
+
+// Window space quad. Every primitive is a convex quad, attributes are interpolated linearly in window space
+struct SoftwarePrimitive {
+    // Edge functions a * x + b * y + c which are positive inside
+    f32 edgeA[4];
+    f32 edgeB[4];
+    f32 edgeC[4];
+    // depth = depthX * x + depthY * y + depth0
+    f32 depthX;
+    f32 depthY;
+    f32 depth0;
+    // Covered pixels, bounds are clipped to the view clip rect and the framebuffer
+    i32 minX;
+    i32 minY;
+    i32 maxX;
+    i32 maxY;
+    // Shapes only. Position in shape space, its half size and corner radius
+    b32 shape;
+    v2 localX;
+    v2 localY;
+    v2 local0;
+    v2 halfSize;
+    f32 radius;
+    v4 color;
+    u32 packedColor;
+};
+
+struct SoftwareRendererStats {
+    u32 primitives;
+    // Primitive and tile pairs
+    u32 binned;
+    // Primitives which were rejected for a whole tile because the tile is already closer
+    u32 tileRejects;
+    u32 spritesSkipped;
+    // Primitives behind the camera. There is no near plane clipping
+    u32 primitivesClipped;
+};
+
+struct SoftwareRenderer {
+    static const u32 TileSize = 64;
+
+    u32 width;
+    u32 height;
+    // Rows go from the bottom of the window
+    u32* color;
+    f32* depth;
+
+    u32 tilesX;
+    u32 tilesY;
+
+    // NOTE: Bins are filled in two passes over the primitives. Indices of primitives which touch the tile
+    // go to binIndices starting at binOffsets[tile], so bins keep the order of primitives
+    u32* binOffsets;
+    u32* binCounts;
+    u32 binIndexCapacity;
+    u32* binIndices;
+
+    u32 primitiveCount;
+    u32 primitiveCapacity;
+    SoftwarePrimitive* primitives;
+    RenderSortEntry* shapeEntries;
+    RenderSortEntry* shapeTempEntries;
+
+    u32 clearColor;
+    // Next tile to be taken by a raster job
+    volatile u32 nextTile;
+    SoftwareRendererStats stats;
+};
+
+void SoftwareRendererInit(SoftwareRenderer* renderer, u32 width, u32 height);
+void SoftwareRendererResize(SoftwareRenderer* renderer, u32 width, u32 height);
+void SoftwareRendererFree(SoftwareRenderer* renderer);
+// Projects commands of the queue with the views of the canvas and bins them into tiles
+void SoftwareRendererBin(SoftwareRenderer* renderer, const Canvas* canvas, const RenderQueue* queue);
+// Clears the framebuffer and rasterizes binned primitives. Tiles are spread across worker threads
+void SoftwareRendererRaster(SoftwareRenderer* renderer);
+// Bins and rasterizes the queue
+void SoftwareRendererDraw(SoftwareRenderer* renderer, const Canvas* canvas, const RenderQueue* queue);
@@ -0,0 +1,131 @@
+#include "Text.h"
+#include "Font8x8.h"
+
+void TextCacheInit(TextCache* cache, Renderer* renderer) {
+    *cache = {};
+    cache->glyphPool = (TextGlyph*)PlatformAllocate(sizeof(TextGlyph) * TextCache::MaxGlyphs, 0, nullptr);
+    cache->textPool = (char*)PlatformAllocate(TextCache::MaxTextBytes, 0, nullptr);
+    assert(cache->glyphPool && cache->textPool);
+
+    const u32 glyphSize = Font8x8GlyphSize;
+    for (u32 character = 0; character < array_count(cache->glyphs); character++) {
+        const u8* rows = Font8x8Data + character * glyphSize;
+
+        u32 coverage = 0;
+        for (u32 row = 0; row < glyphSize; row++) {
+            coverage |= rows[row];
+        }
+        if (!coverage) {
+            continue;
+        }
+
+        // NOTE(swarzzy): Texture rows go bottom up while font rows go top down. Empty pixels are
+        // white so linear filtering doesn't darken edges
+        u32 pixels[Font8x8GlyphSize * Font8x8GlyphSize];
+        for (u32 y = 0; y < glyphSize; y++) {
+            u8 bits = rows[glyphSize - 1 - y];
+            for (u32 x = 0; x < glyphSize; x++) {
+                pixels[y * glyphSize + x] = (bits & (0x80 >> x)) ? 0xffffffff : 0x00ffffff;
+            }
+        }
+
+        cache->glyphs[character] = RendererAddImage(renderer, pixels, glyphSize, glyphSize);
+    }
+}
+
+void TextCacheClear(TextCache* cache) {
+    for (u32 i = 0; i < TextCache::MaxRuns; i++) {
+        cache->runs[i].hash = 0;
+    }
+    cache->runCount = 0;
+    cache->glyphPoolAt = 0;
+    cache->textPoolAt = 0;
+}
+
+// Glyphs are laid out for the unit size and scaled when drawn
+void TextLayout(TextCache* cache, TextRun* run, const char* text, usize length) {
+    run->firstGlyph = cache->glyphPoolAt;
+    run->glyphCount = 0;
+
+    f32 x = 0.0f;
+    f32 y = 0.0f;
+    f32 width = 0.0f;
+    for (usize i = 0; i < length; i++) {
+        u32 character = (u8)text[i];
+        if (character == '\n') {
+            x = 0.0f;
+            y -= 1.0f;
+            continue;
+        }
+
+        if (cache->glyphs[character].valid) {
+            TextGlyph* glyph = cache->glyphPool + run->firstGlyph + run->glyphCount;
+            glyph->min = V2(x, y - 1.0f);
+            glyph->max = V2(x + 1.0f, y);
+            glyph->character = character;
+            run->glyphCount++;
+        }
+
+        x += 1.0f;
+        width = Max(width, x);
+    }
+
+    cache->glyphPoolAt += run->glyphCount;
+    run->extent = V2(width, 1.0f - y);
+    cache->runsLaidOut++;
+}
+
+// Finds the run of the string or lays it out
+const TextRun* TextGetRun(TextCache* cache, const char* text, usize length) {
+    u64 hash = HashBytes(text, length, 0);
+    if (!hash) {
+        hash = 1;
+    }
+
+    u32 mask = TextCache::MaxRuns - 1;
+    u32 slot = (u32)hash & mask;
+    while (cache->runs[slot].hash) {
+        const TextRun* run = cache->runs + slot;
+        if (run->hash == hash && run->textLength == length && memcmp(cache->textPool + run->textOffset, text, length) == 0) {
+            cache->runsReused++;
+            return cache->runs + slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // NOTE(swarzzy): Glyph count never exceeds the length, so the pool is checked before layout
+    if (length > TextCache::MaxGlyphs || length > TextCache::MaxTextBytes) {
+        return nullptr;
+    }
+    if (cache->runCount >= TextCache::MaxRuns * 3 / 4 || cache->glyphPoolAt + length > TextCache::MaxGlyphs ||
+        cache->textPoolAt + length > TextCache::MaxTextBytes) {
+        TextCacheClear(cache);
+        slot = (u32)hash & mask;
+    }
+
+    TextRun* run = cache->runs + slot;
+    run->hash = hash;
+    run->textOffset = cache->textPoolAt;
+    run->textLength = (u32)length;
+    memcpy(cache->textPool + cache->textPoolAt, text, length);
+    cache->textPoolAt += (u32)length;
+    cache->runCount++;
+    TextLayout(cache, run, text, length);
+    return run;
+}
+
+v2 DrawString(RenderQueue* queue, TextCache* cache, const char* text, v2 position, f32 size, f32 z, v4 color) {
+    const TextRun* run = TextGetRun(cache, text, (usize)strlen(text));
+    if (!run) {
+        return V2(0.0f);
+    }
+
+    for (u32 i = 0; i < run->glyphCount; i++) {
+        const TextGlyph* glyph = cache->glyphPool + run->firstGlyph + i;
+        v2 min = V2(position.x + glyph->min.x * size, position.y + glyph->min.y * size);
+        v2 max = V2(position.x + glyph->max.x * size, position.y + glyph->max.y * size);
+        DrawSprite(queue, min, max, z, cache->glyphs + glyph->character, color);
+    }
+
+    return V2(run->extent.x * size, run->extent.y * size);
+}
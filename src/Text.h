@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Common.h"
+#include "RenderQueue.h"
+
+struct Renderer;
+
+// NOTE: Glyph quad of a laid out string relative to its top left corner
+struct TextGlyph {
+    v2 min;
+    v2 max;
+    u32 character;
+};
+
+// NOTE: Laid out string. Its glyphs live in the glyph pool of the cache
+struct TextRun {
+    // Hash of the string. Zero marks an empty slot
+    u64 hash;
+    // The string itself lives in the text pool of the cache, so hash collisions are told apart
+    u32 textOffset;
+    u32 textLength;
+    u32 firstGlyph;
+    u32 glyphCount;
+    v2 extent;
+};
+
+// NOTE: Glyphs of the embedded 8x8 font in the renderer atlas and laid out strings.
+// Runs are laid out for the unit size, so strings drawn every frame are laid out only once whatever size they are drawn with
+struct TextCache {
+    // Power of two
+    static const u32 MaxRuns = 512;
+    static const u32 MaxGlyphs = 16384;
+    static const u32 MaxTextBytes = 16384;
+
+    // Empty glyphs like space are not valid
+    AtlasRegion glyphs[256];
+
+    // Open addressing table. When it gets full all runs are dropped
+    u32 runCount;
+    TextRun runs[MaxRuns];
+    u32 glyphPoolAt;
+    TextGlyph* glyphPool;
+    u32 textPoolAt;
+    char* textPool;
+
+    u32 runsLaidOut;
+    u32 runsReused;
+};
+
+// Adds glyphs of the font to the renderer atlas
+void TextCacheInit(TextCache* cache, Renderer* renderer);
+void TextCacheClear(TextCache* cache);
+
+// Draws the string as sprites. Glyphs are squares of the size in world units, lines go down from the position.
+// Returns the extent of the text
+v2 DrawString(RenderQueue* queue, TextCache* cache, const char* text, v2 position, f32 size, f32 z, v4 color);
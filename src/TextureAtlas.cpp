@@ -0,0 +1,160 @@
+#include "TextureAtlas.h"
+
+void TextureAtlasInit(TextureAtlas* atlas, TextureStream* stream) {
+    *atlas = {};
+    atlas->stream = stream;
+
+    // NOTE(swarzzy): Storage for all pages is allocated with the rest of GL objects, so adding images
+    // only packs them and queues uploads which are issued by the GL backend
+    glGenTextures(1, &atlas->texture);
+    assert(atlas->texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, atlas->texture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, TextureAtlas::PageSize, TextureAtlas::PageSize, TextureAtlas::MaxPages, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    static_assert(TextureAtlas::PageSize <= array_count(((AtlasPage*)nullptr)->nodes));
+    static_assert(TextureAtlas::PageSize <= U16::Max);
+}
+
+void TextureAtlasClear(TextureAtlas* atlas) {
+    for (u32 i = 0; i < TextureAtlas::MaxPages; i++) {
+        atlas->pages[i].nodeCount = 0;
+    }
+    atlas->pageCount = 0;
+}
+
+// Returns y at which an image of the given width placed at the node would end up, or U32::Max if it doesn't fit
+u32 SkylineFit(const AtlasPage* page, u32 nodeIndex, u32 width, u32 height) {
+    u32 x = page->nodes[nodeIndex].x;
+    if (x + width > TextureAtlas::PageSize) {
+        return U32::Max;
+    }
+
+    u32 y = 0;
+    u32 widthLeft = width;
+    for (u32 i = nodeIndex; widthLeft > 0; i++) {
+        assert(i < page->nodeCount);
+        y = Max(y, (u32)page->nodes[i].y);
+        if (y + height > TextureAtlas::PageSize) {
+            return U32::Max;
+        }
+        widthLeft -= Min(widthLeft, (u32)page->nodes[i].width);
+    }
+    return y;
+}
+
+// Finds place for the rect and updates the skyline. Returns false if the rect doesn't fit
+b32 SkylineInsert(AtlasPage* page, u32 width, u32 height, u32* resultX, u32* resultY) {
+    if (page->nodeCount == 0) {
+        page->nodes[0] = SkylineNode { 0, 0, (u16)TextureAtlas::PageSize };
+        page->nodeCount = 1;
+    }
+
+    // NOTE(swarzzy): Bottom-left rule. Lowest top edge wins, narrower segment on ties
+    u32 bestIndex = U32::Max;
+    u32 bestTop = U32::Max;
+    u32 bestWidth = U32::Max;
+    for (u32 i = 0; i < page->nodeCount; i++) {
+        u32 y = SkylineFit(page, i, width, height);
+        if (y != U32::Max) {
+            u32 top = y + height;
+            if (top < bestTop || (top == bestTop && page->nodes[i].width < bestWidth)) {
+                bestIndex = i;
+                bestTop = top;
+                bestWidth = page->nodes[i].width;
+            }
+        }
+    }
+
+    if (bestIndex == U32::Max || page->nodeCount == array_count(page->nodes)) {
+        return false;
+    }
+
+    u32 x = page->nodes[bestIndex].x;
+    *resultX = x;
+    *resultY = bestTop - height;
+
+    // Inserting the new segment and cutting segments which are now under it
+    memmove(page->nodes + bestIndex + 1, page->nodes + bestIndex, sizeof(SkylineNode) * (page->nodeCount - bestIndex));
+    page->nodes[bestIndex] = SkylineNode { (u16)x, (u16)bestTop, (u16)width };
+    page->nodeCount++;
+
+    u32 end = x + width;
+    u32 i = bestIndex + 1;
+    while (i < page->nodeCount && page->nodes[i].x < end) {
+        SkylineNode* node = page->nodes + i;
+        u32 nodeEnd = node->x + node->width;
+        if (nodeEnd <= end) {
+            memmove(page->nodes + i, page->nodes + i + 1, sizeof(SkylineNode) * (page->nodeCount - i - 1));
+            page->nodeCount--;
+        } else {
+            node->width = (u16)(nodeEnd - end);
+            node->x = (u16)end;
+            break;
+        }
+    }
+
+    // Merging neighbours at the same height
+    for (u32 j = 0; j + 1 < page->nodeCount;) {
+        if (page->nodes[j].y == page->nodes[j + 1].y) {
+            page->nodes[j].width += page->nodes[j + 1].width;
+            memmove(page->nodes + j + 1, page->nodes + j + 2, sizeof(SkylineNode) * (page->nodeCount - j - 2));
+            page->nodeCount--;
+        } else {
+            j++;
+        }
+    }
+
+    return true;
+}
+
+AtlasRegion TextureAtlasAdd(TextureAtlas* atlas, const void* rgba, u32 width, u32 height) {
+    AtlasRegion region {};
+    const u32 padding = TextureAtlas::Padding;
+    u32 paddedWidth = width + padding * 2;
+    u32 paddedHeight = height + padding * 2;
+    if (!width || !height || paddedWidth > TextureAtlas::PageSize || paddedHeight > TextureAtlas::PageSize) {
+        return region;
+    }
+
+    u32 x = 0;
+    u32 y = 0;
+    u32 pageIndex = 0;
+    for (; pageIndex < TextureAtlas::MaxPages; pageIndex++) {
+        if (SkylineInsert(atlas->pages + pageIndex, paddedWidth, paddedHeight, &x, &y)) {
+            break;
+        }
+    }
+
+    if (pageIndex == TextureAtlas::MaxPages) {
+        return region;
+    }
+
+    atlas->pageCount = Max(atlas->pageCount, pageIndex + 1);
+
+    // Replicating image edges to the padding. Padded image is written right to the upload storage
+    u32* padded = TextureStreamPush(atlas->stream, GL_TEXTURE_2D_ARRAY, atlas->texture, x, y, pageIndex, paddedWidth, paddedHeight);
+    const u32* source = (const u32*)rgba;
+    for (u32 row = 0; row < paddedHeight; row++) {
+        u32 sourceRow = (u32)Clamp((i32)row - (i32)padding, 0, (i32)height - 1);
+        for (u32 column = 0; column < paddedWidth; column++) {
+            u32 sourceColumn = (u32)Clamp((i32)column - (i32)padding, 0, (i32)width - 1);
+            padded[row * paddedWidth + column] = source[sourceRow * width + sourceColumn];
+        }
+    }
+
+    atlas->imagesAdded++;
+    atlas->bytesQueued += sizeof(u32) * paddedWidth * paddedHeight;
+
+    f32 invSize = 1.0f / (f32)TextureAtlas::PageSize;
+    region.valid = true;
+    region.page = pageIndex;
+    region.width = width;
+    region.height = height;
+    region.uvMin = V2((x + padding) * invSize, (y + padding) * invSize);
+    region.uvMax = V2((x + padding + width) * invSize, (y + padding + height) * invSize);
+    return region;
+}
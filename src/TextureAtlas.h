@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Common.h"
+#include "TextureStream.h"
+
+// NOTE: Location of an image inside of the atlas
+struct AtlasRegion {
+    b32 valid;
+    u32 page;
+    u32 width;
+    u32 height;
+    v2 uvMin;
+    v2 uvMax;
+};
+
+// NOTE: Skyline is a list of horizontal segments describing the top edge of packed images.
+// New image is placed on top of the segment where its top ends up the lowest
+struct SkylineNode {
+    u16 x;
+    u16 y;
+    u16 width;
+};
+
+struct AtlasPage {
+    u32 nodeCount;
+    SkylineNode nodes[1024];
+};
+
+// NOTE: RGBA8 images packed into layers of a texture array, so sprites from different
+// images and pages can be drawn without rebinding textures
+struct TextureAtlas {
+    static const u32 PageSize = 1024;
+    static const u32 MaxPages = 4;
+    // Empty pixels around every image. Image edges are replicated there so linear filtering
+    // doesn't bleed neighbours in
+    static const u32 Padding = 1;
+
+    GLuint texture;
+    // Image uploads are streamed through it
+    TextureStream* stream;
+    u32 pageCount;
+    AtlasPage pages[MaxPages];
+
+    u32 imagesAdded;
+    u64 bytesQueued;
+};
+
+void TextureAtlasInit(TextureAtlas* atlas, TextureStream* stream);
+// Packs the image and queues its upload to the atlas. Returned region is not valid if the atlas is full.
+// Sprites drawn before the stream gets to the image show whatever was in the atlas region before
+AtlasRegion TextureAtlasAdd(TextureAtlas* atlas, const void* rgba, u32 width, u32 height);
+// Forgets all images. Texture contents stay until overwritten
+void TextureAtlasClear(TextureAtlas* atlas);
@@ -0,0 +1,154 @@
+#include "TextureStream.h"
+
+void TextureStreamInit(TextureStream* stream, u32 frameBudget) {
+    *stream = {};
+    stream->frameBudget = Min(frameBudget, TextureStream::SlotSize);
+
+    for (u32 i = 0; i < TextureStream::SlotCount; i++) {
+        TextureStreamSlot* slot = stream->slots + i;
+        glGenBuffers(1, &slot->buffer);
+        assert(slot->buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->buffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, TextureStream::SlotSize, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+// Copies rows of the upload to the bound texture. Pixels are either a client pointer or an offset in the bound unpack buffer
+void TextureStreamCopyRows(const TextureUpload* upload, u32 firstRow, u32 rowCount, const void* pixels) {
+    glBindTexture(upload->target, upload->texture);
+    if (upload->target == GL_TEXTURE_2D_ARRAY) {
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, upload->x, upload->y + firstRow, upload->layer, upload->width, rowCount, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    } else {
+        assert(upload->target == GL_TEXTURE_2D);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, upload->x, upload->y + firstRow, upload->width, rowCount, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+}
+
+// Synchronously uploads what is left of the oldest pending upload
+void TextureStreamUploadFirst(TextureStream* stream) {
+    assert(stream->pendingCount);
+    TextureUpload* upload = stream->pending + stream->pendingBegin;
+    u32 rowCount = upload->height - upload->rowsUploaded;
+    TextureStreamCopyRows(upload, upload->rowsUploaded, rowCount, upload->pixels + upload->width * upload->rowsUploaded);
+    stream->bytesUploaded += sizeof(u32) * upload->width * rowCount;
+
+    PlatformDeallocate(upload->pixels, nullptr);
+    stream->pendingBegin = (stream->pendingBegin + 1) % TextureStream::MaxPendingUploads;
+    stream->pendingCount--;
+}
+
+u32* TextureStreamPush(TextureStream* stream, GLenum target, GLuint texture, u32 x, u32 y, u32 layer, u32 width, u32 height) {
+    assert(width && height);
+    // NOTE(swarzzy): At least a single row has to fit in the budget
+    assert(sizeof(u32) * width <= stream->frameBudget);
+
+    if (stream->pendingCount == TextureStream::MaxPendingUploads) {
+        // NOTE(swarzzy): Making space for the new upload the slow way
+        TextureStreamUploadFirst(stream);
+    }
+
+    TextureUpload* upload = stream->pending + (stream->pendingBegin + stream->pendingCount) % TextureStream::MaxPendingUploads;
+    stream->pendingCount++;
+
+    upload->target = target;
+    upload->texture = texture;
+    upload->x = x;
+    upload->y = y;
+    upload->layer = layer;
+    upload->width = width;
+    upload->height = height;
+    upload->rowsUploaded = 0;
+    upload->pixels = (u32*)PlatformAllocate(sizeof(u32) * width * height, 0, nullptr);
+    assert(upload->pixels);
+
+    return upload->pixels;
+}
+
+void TextureStreamUpdate(TextureStream* stream) {
+    stream->frameBytesUploaded = 0;
+
+    TextureStreamSlot* slot = stream->slots + stream->slotIndex;
+    if (slot->fence) {
+        // NOTE(swarzzy): Not waiting here. If the GPU is still reading the buffer uploads just wait for the next frame
+        GLenum status = glClientWaitSync(slot->fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED) {
+            stream->framesSkipped++;
+            return;
+        }
+        glDeleteSync(slot->fence);
+        slot->fence = 0;
+    }
+
+    if (!stream->pendingCount) {
+        return;
+    }
+
+    struct Chunk {
+        u32 firstRow;
+        u32 rowCount;
+        u32 offset;
+    };
+
+    // NOTE(swarzzy): Copies can not be issued while the buffer is mapped, so rows are staged first
+    Chunk chunks[TextureStream::MaxPendingUploads];
+    u32 chunkCount = 0;
+    u32 used = 0;
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->buffer);
+    // NOTE(swarzzy): The fence guarantees the GPU is done with the buffer, so the driver doesn't need to sync
+    u8* mapped = (u8*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, TextureStream::SlotSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    assert(mapped);
+
+    for (u32 i = 0; i < stream->pendingCount; i++) {
+        TextureUpload* upload = stream->pending + (stream->pendingBegin + i) % TextureStream::MaxPendingUploads;
+        u32 rowSize = sizeof(u32) * upload->width;
+        u32 rowCount = Min(upload->height - upload->rowsUploaded, (stream->frameBudget - used) / rowSize);
+        if (!rowCount) {
+            break;
+        }
+
+        u32 size = rowSize * rowCount;
+        memcpy(mapped + used, upload->pixels + upload->width * upload->rowsUploaded, size);
+        chunks[chunkCount++] = Chunk { upload->rowsUploaded, rowCount, used };
+        upload->rowsUploaded += rowCount;
+        used += size;
+
+        // NOTE(swarzzy): Narrower uploads could still fit, but they would finish before this one and stay
+        // in the ring behind it. Later uploads may also overwrite the same texels, so they must not go first
+        if (upload->rowsUploaded < upload->height) {
+            break;
+        }
+    }
+
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    for (u32 i = 0; i < chunkCount; i++) {
+        TextureUpload* upload = stream->pending + (stream->pendingBegin + i) % TextureStream::MaxPendingUploads;
+        TextureStreamCopyRows(upload, chunks[i].firstRow, chunks[i].rowCount, (void*)(uptr)chunks[i].offset);
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    stream->slotIndex = (stream->slotIndex + 1) % TextureStream::SlotCount;
+
+    // Releasing finished uploads. Staging stops at the first upload which did not fit, so they all go first
+    while (stream->pendingCount) {
+        TextureUpload* upload = stream->pending + stream->pendingBegin;
+        if (upload->rowsUploaded < upload->height) {
+            break;
+        }
+        PlatformDeallocate(upload->pixels, nullptr);
+        stream->pendingBegin = (stream->pendingBegin + 1) % TextureStream::MaxPendingUploads;
+        stream->pendingCount--;
+    }
+
+    stream->frameBytesUploaded = used;
+    stream->bytesUploaded += used;
+}
+
+void TextureStreamFlush(TextureStream* stream) {
+    while (stream->pendingCount) {
+        TextureStreamUploadFirst(stream);
+    }
+}
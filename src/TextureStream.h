@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Common.h"
+
+// NOTE: Texture region waiting to be uploaded. Pixels are RGBA8 and owned by the stream
+struct TextureUpload {
+    // GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY
+    GLenum target;
+    GLuint texture;
+    u32 x;
+    u32 y;
+    // Ignored for GL_TEXTURE_2D
+    u32 layer;
+    u32 width;
+    u32 height;
+    // Big uploads are split by rows across frames
+    u32 rowsUploaded;
+    u32* pixels;
+};
+
+struct TextureStreamSlot {
+    GLuint buffer;
+    // Signaled when the GPU is done reading the buffer
+    GLsync fence;
+};
+
+// NOTE: Uploads pixels through a ring of pixel buffer objects. Every frame pending uploads are copied
+// to the next buffer of the ring until the frame budget is spent and the texture copies are issued from it,
+// so the driver copies asynchronously and the render thread never waits for big uploads
+struct TextureStream {
+    static const u32 SlotCount = 3;
+    static const u32 SlotSize = 4 * 1024 * 1024;
+    static const u32 DefaultFrameBudget = 2 * 1024 * 1024;
+    static const u32 MaxPendingUploads = 1024;
+
+    u32 frameBudget;
+    u32 slotIndex;
+    TextureStreamSlot slots[SlotCount];
+
+    // Ring buffer of uploads in the order they were pushed
+    u32 pendingBegin;
+    u32 pendingCount;
+    TextureUpload pending[MaxPendingUploads];
+
+    u32 frameBytesUploaded;
+    // Frames when the next buffer was still in use by the GPU, so nothing was uploaded
+    u32 framesSkipped;
+    u64 bytesUploaded;
+};
+
+// Budget is clamped to the buffer size
+void TextureStreamInit(TextureStream* stream, u32 frameBudget);
+// Returns storage for width * height RGBA8 pixels which caller fills. They are copied to the texture
+// during following frames. Texture storage must already be allocated
+u32* TextureStreamPush(TextureStream* stream, GLenum target, GLuint texture, u32 x, u32 y, u32 layer, u32 width, u32 height);
+// Streams pending uploads to the next buffer of the ring. Called once per frame
+void TextureStreamUpdate(TextureStream* stream);
+// Uploads everything pending right now. Useful when stalls don't matter, e.g. behind a loading screen
+void TextureStreamFlush(TextureStream* stream);
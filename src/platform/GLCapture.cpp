@@ -0,0 +1,432 @@
+#include "GLCapture.h"
+
+static GLCapture GlobalGLCapture;
+
+void GLCaptureFlush(GLCapture* capture) {
+    if (capture->bufferUsed) {
+        if (SDL_RWwrite(capture->file, capture->buffer, 1, capture->bufferUsed) != capture->bufferUsed) {
+            log_print("[GLCapture] Failed to write the trace: %s\n", SDL_GetError());
+        }
+        capture->bytesWritten += capture->bufferUsed;
+        capture->bufferUsed = 0;
+    }
+}
+
+void GLCaptureWrite(const void* data, u32 size) {
+    GLCapture* capture = &GlobalGLCapture;
+    if (capture->bufferUsed + size > GLCapture::BufferSize) {
+        GLCaptureFlush(capture);
+        if (size > GLCapture::BufferSize) {
+            // NOTE(swarzzy): Big blobs bypass the buffer
+            if (SDL_RWwrite(capture->file, data, 1, size) != size) {
+                log_print("[GLCapture] Failed to write the trace: %s\n", SDL_GetError());
+            }
+            capture->bytesWritten += size;
+            return;
+        }
+    }
+    memcpy(capture->buffer + capture->bufferUsed, data, size);
+    capture->bufferUsed += size;
+}
+
+template<typename T>
+void GLCaptureWriteValue(T value) {
+    GLCaptureWrite(&value, sizeof(T));
+}
+
+void GLCaptureWriteData(const void* data, u32 size) {
+    GLCaptureWrite(data, size);
+}
+
+// Shader strings are written one after another with their null terminators
+void GLCaptureWriteData(const GLchar* const* strings, u32 size) {
+    u32 written = 0;
+    for (u32 i = 0; written < size; i++) {
+        u32 length = (u32)strlen(strings[i]) + 1;
+        GLCaptureWrite(strings[i], length);
+        written += length;
+    }
+    assert(written == size);
+}
+
+template<typename T>
+void GLCaptureWriteArg(u32 dataSize, T value) {
+    if constexpr (GLTraceArg<T>::IsPointer) {
+        GLCaptureWriteValue((u64)(uptr)value);
+        if constexpr (GLTraceArg<T>::IsData) {
+            GLCaptureWriteValue(dataSize);
+            if (dataSize) {
+                GLCaptureWriteData(value, dataSize);
+            }
+        } else {
+            GLCaptureWriteValue((u32)0);
+        }
+    } else {
+        GLCaptureWriteValue(value);
+    }
+}
+
+// Size of the pixel data read from client memory. Zero if it is read from the bound unpack buffer
+u32 GLCapturePixelDataSize(GLenum format, GLenum type, GLsizei width, GLsizei height, GLsizei depth, const void* pixels) {
+    if (!pixels) {
+        return 0;
+    }
+    GLint unpackBuffer = 0;
+    GlobalGLCapture.functions.fn.glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &unpackBuffer);
+    if (unpackBuffer) {
+        return 0;
+    }
+
+    u32 componentCount = 4;
+    switch (format) {
+    case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: { componentCount = 1; } break;
+    case GL_RG: case GL_RG_INTEGER: { componentCount = 2; } break;
+    case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: { componentCount = 3; } break;
+    default: {} break;
+    }
+
+    u32 pixelSize = componentCount;
+    switch (type) {
+    case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: { pixelSize = componentCount * 2; } break;
+    case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: { pixelSize = componentCount * 4; } break;
+    case GL_UNSIGNED_INT_8_8_8_8: case GL_UNSIGNED_INT_8_8_8_8_REV: case GL_UNSIGNED_INT_2_10_10_10_REV: { pixelSize = 4; } break;
+    default: {} break;
+    }
+
+    GLint alignment = 4;
+    GlobalGLCapture.functions.fn.glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    u32 rowSize = (u32)width * pixelSize;
+    u32 rowPitch = (rowSize + (u32)alignment - 1) / (u32)alignment * (u32)alignment;
+    // NOTE(swarzzy): The last row is not padded
+    return rowPitch * ((u32)height * (u32)depth - 1) + rowSize;
+}
+
+// NOTE: Sizes of the data referenced by pointer arguments. Pointers of functions without a specialization are written as values
+template<u32 Index>
+struct GLCaptureData {
+    template<typename... Args>
+    static u32 Size(u32 arg, Args... args) { return 0; }
+};
+
+template<>
+struct GLCaptureData<OPENGL_FUNCTION_INDEX(glBufferData)> {
+    static u32 Size(u32 arg, GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+        return arg == 2 && data ? (u32)size : 0;
+    }
+};
+
+template<>
+struct GLCaptureData<OPENGL_FUNCTION_INDEX(glBufferSubData)> {
+    static u32 Size(u32 arg, GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+        return arg == 3 ? (u32)size : 0;
+    }
+};
+
+template<>
+struct GLCaptureData<OPENGL_FUNCTION_INDEX(glShaderSource)> {
+    static u32 Size(u32 arg, GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths) {
+        u32 size = 0;
+        if (arg == 2) {
+            // NOTE(swarzzy): Strings are assumed to be null terminated
+            for (GLsizei i = 0; i < count; i++) {
+                size += (u32)strlen(strings[i]) + 1;
+            }
+        } else if (arg == 3 && lengths) {
+            size = sizeof(GLint) * (u32)count;
+        }
+        return size;
+    }
+};
+
+template<>
+struct GLCaptureData<OPENGL_FUNCTION_INDEX(glProgramBinary)> {
+    static u32 Size(u32 arg, GLuint program, GLenum format, const void* binary, GLsizei length) {
+        return arg == 2 ? (u32)length : 0;
+    }
+};
+
+template<>
+struct GLCaptureData<OPENGL_FUNCTION_INDEX(glTexImage2D)> {
+    static u32 Size(u32 arg, GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels) {
+        return arg == 8 ? GLCapturePixelDataSize(format, type, width, height, 1, pixels) : 0;
+    }
+};
+
+template<>
+struct GLCaptureData<OPENGL_FUNCTION_INDEX(glTexImage3D)> {
+    static u32 Size(u32 arg, GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels) {
+        return arg == 9 ? GLCapturePixelDataSize(format, type, width, height, depth, pixels) : 0;
+    }
+};
+
+template<>
+struct GLCaptureData<OPENGL_FUNCTION_INDEX(glTexSubImage2D)> {
+    static u32 Size(u32 arg, GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels) {
+        return arg == 8 ? GLCapturePixelDataSize(format, type, width, height, 1, pixels) : 0;
+    }
+};
+
+template<>
+struct GLCaptureData<OPENGL_FUNCTION_INDEX(glTexSubImage3D)> {
+    static u32 Size(u32 arg, GLenum target, GLint level, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels) {
+        return arg == 10 ? GLCapturePixelDataSize(format, type, width, height, depth, pixels) : 0;
+    }
+};
+
+#define GLCAPTURE_STRING_DATA(name) \
+template<> \
+struct GLCaptureData<OPENGL_FUNCTION_INDEX(name)> { \
+    static u32 Size(u32 arg, GLuint program, const GLchar* string) { \
+        return arg == 1 ? (u32)strlen(string) + 1 : 0; \
+    } \
+};
+
+GLCAPTURE_STRING_DATA(glGetUniformLocation)
+GLCAPTURE_STRING_DATA(glGetUniformBlockIndex)
+GLCAPTURE_STRING_DATA(glGetAttribLocation)
+
+// Value is the last argument, matrix functions have transpose flag in between
+#define GLCAPTURE_ARRAY_DATA(name, type, elementCount) \
+template<> \
+struct GLCaptureData<OPENGL_FUNCTION_INDEX(name)> { \
+    template<typename... Args> \
+    static u32 Size(u32 arg, GLint location, GLsizei count, Args... args) { \
+        return arg == sizeof...(Args) + 1 ? sizeof(type) * (elementCount) * (u32)count : 0; \
+    } \
+};
+
+GLCAPTURE_ARRAY_DATA(glUniform1fv, GLfloat, 1)
+GLCAPTURE_ARRAY_DATA(glUniform2fv, GLfloat, 2)
+GLCAPTURE_ARRAY_DATA(glUniform3fv, GLfloat, 3)
+GLCAPTURE_ARRAY_DATA(glUniform4fv, GLfloat, 4)
+GLCAPTURE_ARRAY_DATA(glUniform1iv, GLint, 1)
+GLCAPTURE_ARRAY_DATA(glUniform2iv, GLint, 2)
+GLCAPTURE_ARRAY_DATA(glUniform3iv, GLint, 3)
+GLCAPTURE_ARRAY_DATA(glUniform4iv, GLint, 4)
+GLCAPTURE_ARRAY_DATA(glUniformMatrix3fv, GLfloat, 9)
+GLCAPTURE_ARRAY_DATA(glUniformMatrix4fv, GLfloat, 16)
+
+#define GLCAPTURE_NAMES_DATA(name) \
+template<> \
+struct GLCaptureData<OPENGL_FUNCTION_INDEX(name)> { \
+    static u32 Size(u32 arg, GLsizei count, const GLuint* names) { \
+        return arg == 1 ? sizeof(GLuint) * (u32)count : 0; \
+    } \
+};
+
+GLCAPTURE_NAMES_DATA(glDeleteBuffers)
+GLCAPTURE_NAMES_DATA(glDeleteTextures)
+GLCAPTURE_NAMES_DATA(glDeleteVertexArrays)
+GLCAPTURE_NAMES_DATA(glDeleteFramebuffers)
+GLCAPTURE_NAMES_DATA(glDeleteRenderbuffers)
+GLCAPTURE_NAMES_DATA(glDeleteQueries)
+
+#undef GLCAPTURE_STRING_DATA
+#undef GLCAPTURE_ARRAY_DATA
+#undef GLCAPTURE_NAMES_DATA
+
+void GLCaptureAddMapping(GLenum target, void* pointer, u32 size) {
+    GLCapture* capture = &GlobalGLCapture;
+    for (u32 i = 0; i < GLCapture::MaxMappings; i++) {
+        GLCapture::Mapping* mapping = capture->mappings + i;
+        if (!mapping->pointer) {
+            *mapping = { target, pointer, size };
+            return;
+        }
+    }
+    log_print("[GLCapture] Too many mapped buffers. Contents of the buffer will be missing from the trace\n");
+}
+
+// NOTE: Hooks are called while the capture lock is held. Before is called before the call record is written
+template<u32 Index>
+struct GLCaptureHook {
+    template<typename... Args>
+    static void Before(Args... args) {}
+    template<typename R, typename... Args>
+    static void After(R result, Args... args) {}
+};
+
+template<>
+struct GLCaptureHook<OPENGL_FUNCTION_INDEX(glMapBufferRange)> {
+    static void Before(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {}
+    static void After(void* result, GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+        if (result && (access & GL_MAP_WRITE_BIT)) {
+            GLCaptureAddMapping(target, result, (u32)length);
+        }
+    }
+};
+
+template<>
+struct GLCaptureHook<OPENGL_FUNCTION_INDEX(glMapBuffer)> {
+    static void Before(GLenum target, GLenum access) {}
+    static void After(void* result, GLenum target, GLenum access) {
+        if (result && access != GL_READ_ONLY) {
+            GLint size = 0;
+            GlobalGLCapture.functions.fn.glGetBufferParameteriv(target, GL_BUFFER_SIZE, &size);
+            GLCaptureAddMapping(target, result, (u32)size);
+        }
+    }
+};
+
+template<>
+struct GLCaptureHook<OPENGL_FUNCTION_INDEX(glUnmapBuffer)> {
+    static void Before(GLenum target) {
+        GLCapture* capture = &GlobalGLCapture;
+        for (u32 i = 0; i < GLCapture::MaxMappings; i++) {
+            GLCapture::Mapping* mapping = capture->mappings + i;
+            if (mapping->pointer && mapping->target == target) {
+                GLCaptureWriteValue((u16)GLTraceMarker::MappedData);
+                GLCaptureWriteValue((u32)target);
+                GLCaptureWriteValue(mapping->size);
+                GLCaptureWrite(mapping->pointer, mapping->size);
+                *mapping = {};
+                break;
+            }
+        }
+    }
+    static void After(GLboolean result, GLenum target) {}
+};
+
+template<u32 Index, typename... Args>
+void GLCaptureWriteCall(Args... args) {
+    GLCaptureHook<Index>::Before(args...);
+    GLCaptureWriteValue((u16)Index);
+    u32 position = 0;
+    (GLCaptureWriteArg(GLCaptureData<Index>::Size(position++, args...), args), ...);
+    GlobalGLCapture.callCount++;
+}
+
+// NOTE: Replaces the function in the table while capturing. Calls are written and executed under the lock,
+// so calls from the GL worker thread appear in the trace in the order they were made
+template<u32 Index, typename Fn>
+struct GLCaptureThunk;
+
+template<u32 Index, typename R, typename... Args>
+struct GLCaptureThunk<Index, R (APIENTRYP)(Args...)> {
+    static R APIENTRY Call(Args... args) {
+        auto function = (R (APIENTRYP)(Args...))GlobalGLCapture.functions.raw[Index];
+        SDL_AtomicLock(&GlobalGLCapture.lock);
+        if (!GlobalGLCapture.active) {
+            SDL_AtomicUnlock(&GlobalGLCapture.lock);
+            return function(args...);
+        }
+        GLCaptureWriteCall<Index>(args...);
+        R result = function(args...);
+        GLCaptureWriteValue((u64)(uptr)result);
+        GLCaptureHook<Index>::After(result, args...);
+        SDL_AtomicUnlock(&GlobalGLCapture.lock);
+        return result;
+    }
+};
+
+template<u32 Index, typename... Args>
+struct GLCaptureThunk<Index, void (APIENTRYP)(Args...)> {
+    static void APIENTRY Call(Args... args) {
+        auto function = (void (APIENTRYP)(Args...))GlobalGLCapture.functions.raw[Index];
+        SDL_AtomicLock(&GlobalGLCapture.lock);
+        if (GlobalGLCapture.active) {
+            GLCaptureWriteCall<Index>(args...);
+        }
+        function(args...);
+        SDL_AtomicUnlock(&GlobalGLCapture.lock);
+    }
+};
+
+b32 GLCaptureBegin(OpenGL* gl, const char* filename, u32 frameCount) {
+    GLCapture* capture = &GlobalGLCapture;
+    assert(!capture->active);
+    assert(frameCount);
+
+    capture->file = SDL_RWFromFile(filename, "wb");
+    if (!capture->file) {
+        log_print("[GLCapture] Failed to open %s: %s\n", filename, SDL_GetError());
+        return false;
+    }
+    capture->buffer = (u8*)malloc(GLCapture::BufferSize);
+    if (!capture->buffer) {
+        panic("[GLCapture] Failed to allocate the trace buffer");
+    }
+    capture->bufferUsed = 0;
+    capture->bytesWritten = 0;
+    capture->callCount = 0;
+    capture->frameCount = frameCount;
+    capture->framesCaptured = 0;
+    capture->gl = gl;
+
+    // NOTE(swarzzy): Functions which are resolved on the first call would replace the thunks, so everything is resolved right now
+    SDLResolveAllOpenGLFunctions(gl);
+    capture->functions = gl->functions;
+
+    GLTraceHeader header = {};
+    header.magic = GLTraceHeader::Magic;
+    header.version = GLTraceHeader::Version;
+    header.functionCount = OpenGL::FunctionCount;
+    header.frameCount = frameCount;
+    GLCaptureWrite(&header, sizeof(header));
+
+    capture->active = true;
+
+    // NOTE(swarzzy): Missing optional functions stay null, so extension checks still work
+#define GLCAPTURE_SET_THUNK(type, name) if (gl->functions.fn.name) { gl->functions.fn.name = GLCaptureThunk<OPENGL_FUNCTION_INDEX(name), type>::Call; }
+    OPENGL_FUNCTIONS(GLCAPTURE_SET_THUNK)
+    OPENGL_OPTIONAL_FUNCTIONS(GLCAPTURE_SET_THUNK)
+#undef GLCAPTURE_SET_THUNK
+
+    log_print("[GLCapture] Capturing %u frames to %s\n", frameCount, filename);
+    return true;
+}
+
+void GLCaptureInitFromEnvironment(OpenGL* gl) {
+    const char* frames = SDL_getenv(GLCapture::FramesVariable);
+    if (frames) {
+        int frameCount = SDL_atoi(frames);
+        if (frameCount > 0) {
+            GLCaptureBegin(gl, GLCapture::DefaultFilename, (u32)frameCount);
+        } else {
+            log_print("[GLCapture] %s should be a positive number of frames\n", GLCapture::FramesVariable);
+        }
+    }
+}
+
+void GLCaptureEndFrame() {
+    GLCapture* capture = &GlobalGLCapture;
+    if (capture->active) {
+        SDL_AtomicLock(&capture->lock);
+        GLCaptureWriteValue((u16)GLTraceMarker::EndFrame);
+        capture->framesCaptured++;
+        SDL_AtomicUnlock(&capture->lock);
+
+        if (capture->framesCaptured == capture->frameCount) {
+            GLCaptureEnd();
+        }
+    }
+}
+
+void GLCaptureEnd() {
+    GLCapture* capture = &GlobalGLCapture;
+    if (!capture->active) {
+        return;
+    }
+
+    SDL_AtomicLock(&capture->lock);
+    capture->gl->functions = capture->functions;
+    capture->active = false;
+
+    GLCaptureFlush(capture);
+    // NOTE(swarzzy): Capture may be ended early, so the header gets the actual frame count
+    GLTraceHeader header = {};
+    header.magic = GLTraceHeader::Magic;
+    header.version = GLTraceHeader::Version;
+    header.functionCount = OpenGL::FunctionCount;
+    header.frameCount = capture->framesCaptured;
+    SDL_RWseek(capture->file, 0, RW_SEEK_SET);
+    SDL_RWwrite(capture->file, &header, sizeof(header), 1);
+    SDL_RWclose(capture->file);
+    capture->file = nullptr;
+    free(capture->buffer);
+    capture->buffer = nullptr;
+    SDL_AtomicUnlock(&capture->lock);
+
+    log_print("[GLCapture] Captured %u frames, %llu calls, %.2f MB\n", capture->framesCaptured,
+              (unsigned long long)capture->callCount, (f64)capture->bytesWritten / (1024.0 * 1024.0));
+}
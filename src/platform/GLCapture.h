@@ -0,0 +1,84 @@
+#pragma once
+
+// NOTE: Trace of OpenGL calls which can be replayed by tools/GLReplay.cpp. Capture replaces every entry of the
+// function table with a thunk which writes the call to the trace and then forwards it. Trace is a header followed
+// by records. Record starts with u16 function index or one of the markers. Call records contain the arguments
+// in order, scalars as is and pointers as u64 value, u32 data size and the data. Pointers with no data are buffer
+// offsets or output parameters. Non-void calls end with the result as u64.
+// Object names are not remapped on replay, so the trace has to be captured from the start of the program
+// to create all the objects and it relies on the driver to hand out the same names in the same order
+struct GLTraceHeader {
+    static const u32 Magic = 0x52544c47; // GLTR
+    static const u32 Version = 1;
+
+    u32 magic;
+    u32 version;
+    // Traces are valid only for the same function table
+    u32 functionCount;
+    u32 frameCount;
+};
+
+enum struct GLTraceMarker : u16 {
+    // Buffer swap
+    EndFrame = 0xffff,
+    // Contents of a mapped buffer written right before it is unmapped. Followed by u32 target, u32 size and the data
+    MappedData = 0xfffe,
+};
+
+// NOTE: Only pointers to const may carry data. Other pointers are output parameters which get scratch memory on replay
+// and handles such as GLsync which are mapped to the ones created on replay
+template<typename T>
+struct GLTraceArg {
+    static const bool IsPointer = false;
+    static const bool IsData = false;
+};
+
+template<typename T>
+struct GLTraceArg<T*> {
+    static const bool IsPointer = true;
+    static const bool IsData = false;
+};
+
+template<typename T>
+struct GLTraceArg<const T*> {
+    static const bool IsPointer = true;
+    static const bool IsData = true;
+};
+
+struct GLCapture {
+    static constexpr const char* DefaultFilename = "gl_capture.bin";
+    // Number of frames to capture
+    static constexpr const char* FramesVariable = "PONG_GL_CAPTURE_FRAMES";
+    static const u32 BufferSize = 16 * 1024 * 1024;
+    static const u32 MaxMappings = 4;
+
+    struct Mapping {
+        GLenum target;
+        void* pointer;
+        u32 size;
+    };
+
+    b32 active;
+    u32 frameCount;
+    u32 framesCaptured;
+    u64 callCount;
+    u64 bytesWritten;
+    SDL_RWops* file;
+    SDL_SpinLock lock;
+    u32 bufferUsed;
+    u8* buffer;
+
+    // Buffers mapped for writing. Their contents are captured when they are unmapped
+    Mapping mappings[MaxMappings];
+    // Actual functions. Entries of the table are thunks while capturing
+    OpenGL::Functions functions;
+    OpenGL* gl;
+};
+
+// Starts capturing all calls made through the table. Should be called before any objects are created
+b32 GLCaptureBegin(OpenGL* gl, const char* filename, u32 frameCount);
+// Starts capturing if the frame count environment variable is set
+void GLCaptureInitFromEnvironment(OpenGL* gl);
+// Marks the buffer swap. Capture ends after the requested number of frames
+void GLCaptureEndFrame();
+void GLCaptureEnd();
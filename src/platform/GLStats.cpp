@@ -0,0 +1,185 @@
+#include "GLStats.h"
+
+static GLStats GlobalGLStats;
+
+// NOTE: Replaces the function in the table while counting
+template<u32 Index, typename Fn>
+struct GLStatsThunk;
+
+template<u32 Index, typename R, typename... Args>
+struct GLStatsThunk<Index, R (APIENTRYP)(Args...)> {
+    static R APIENTRY Call(Args... args) {
+        auto function = (R (APIENTRYP)(Args...))GlobalGLStats.functions.raw[Index];
+        u64 begin = ReadCycleCounter();
+        R result = function(args...);
+        GlobalGLStats.cycles[Index] += ReadCycleCounter() - begin;
+        GlobalGLStats.calls[Index]++;
+        return result;
+    }
+};
+
+template<u32 Index, typename... Args>
+struct GLStatsThunk<Index, void (APIENTRYP)(Args...)> {
+    static void APIENTRY Call(Args... args) {
+        auto function = (void (APIENTRYP)(Args...))GlobalGLStats.functions.raw[Index];
+        u64 begin = ReadCycleCounter();
+        function(args...);
+        GlobalGLStats.cycles[Index] += ReadCycleCounter() - begin;
+        GlobalGLStats.calls[Index]++;
+    }
+};
+
+GLCallKind GLStatsClassify(const char* name) {
+    static const char* DrawPrefixes[] = { "glDraw", "glMultiDraw" };
+    static const char* StatePrefixes[] = {
+        "glBind", "glUseProgram", "glEnable", "glDisable", "glBlend", "glDepth", "glCullFace", "glFrontFace",
+        "glViewport", "glScissor", "glActiveTexture", "glPolygon", "glColorMask", "glStencil", "glPixelStore",
+        "glTexParameter", "glVertexAttribPointer", "glVertexAttribIPointer", "glVertexAttribDivisor",
+    };
+
+    for (u32 i = 0; i < array_count(DrawPrefixes); i++) {
+        if (strncmp(name, DrawPrefixes[i], strlen(DrawPrefixes[i])) == 0) {
+            return GLCallKind::Draw;
+        }
+    }
+    for (u32 i = 0; i < array_count(StatePrefixes); i++) {
+        if (strncmp(name, StatePrefixes[i], strlen(StatePrefixes[i])) == 0) {
+            return GLCallKind::StateChange;
+        }
+    }
+    if (strncmp(name, "glUniform", 9) == 0) {
+        return GLCallKind::Uniform;
+    }
+    return GLCallKind::Other;
+}
+
+const OpenGLFrameStats* GLStatsBegin(OpenGL* gl) {
+    GLStats* stats = &GlobalGLStats;
+    assert(!stats->active);
+
+    memset(stats, 0, sizeof(GLStats));
+    for (u32 i = 0; i < OpenGL::FunctionCount; i++) {
+        stats->kinds[i] = GLStatsClassify(OpenGL::FunctionNames[i]);
+    }
+
+    // NOTE(swarzzy): Functions which are resolved on the first call would replace the thunks, so everything is resolved right now
+    SDLResolveAllOpenGLFunctions(gl);
+    stats->functions = gl->functions;
+    stats->gl = gl;
+    stats->beginCycles = ReadCycleCounter();
+    stats->beginCounter = SDL_GetPerformanceCounter();
+    stats->frameBeginCycles = stats->beginCycles;
+    stats->frameBeginCounter = stats->beginCounter;
+    stats->active = true;
+
+    // NOTE(swarzzy): Missing optional functions stay null, so extension checks still work
+#define GLSTATS_SET_THUNK(type, name) if (gl->functions.fn.name) { gl->functions.fn.name = GLStatsThunk<OPENGL_FUNCTION_INDEX(name), type>::Call; }
+    OPENGL_FUNCTIONS(GLSTATS_SET_THUNK)
+    OPENGL_OPTIONAL_FUNCTIONS(GLSTATS_SET_THUNK)
+#undef GLSTATS_SET_THUNK
+
+    log_print("[GLStats] Counting OpenGL calls\n");
+    return &stats->frame;
+}
+
+const OpenGLFrameStats* GLStatsInitFromEnvironment(OpenGL* gl) {
+    const OpenGLFrameStats* result = nullptr;
+    const char* value = SDL_getenv(GLStats::Variable);
+    if (value && SDL_atoi(value)) {
+        result = GLStatsBegin(gl);
+    }
+    return result;
+}
+
+void GLStatsEndFrame() {
+    GLStats* stats = &GlobalGLStats;
+    if (!stats->active) {
+        return;
+    }
+
+    u64 frameCycles = ReadCycleCounter();
+    u64 frameCounter = SDL_GetPerformanceCounter();
+
+    OpenGLFrameStats* frame = &stats->frame;
+    frame->callCount = 0;
+    frame->drawCount = 0;
+    frame->stateChangeCount = 0;
+    frame->uniformCount = 0;
+    frame->cycleCount = 0;
+    if (frameCounter > stats->frameBeginCounter) {
+        frame->cyclesPerSecond = (f64)(frameCycles - stats->frameBeginCycles) * (f64)SDL_GetPerformanceFrequency() / (f64)(frameCounter - stats->frameBeginCounter);
+    }
+
+    for (u32 i = 0; i < OpenGL::FunctionCount; i++) {
+        u32 calls = stats->calls[i];
+        frame->calls[i] = calls;
+        frame->cycles[i] = stats->cycles[i];
+        frame->callCount += calls;
+        frame->cycleCount += stats->cycles[i];
+        switch (stats->kinds[i]) {
+        case GLCallKind::Draw: { frame->drawCount += calls; } break;
+        case GLCallKind::StateChange: { frame->stateChangeCount += calls; } break;
+        case GLCallKind::Uniform: { frame->uniformCount += calls; } break;
+        default: {} break;
+        }
+        stats->totalCalls[i] += calls;
+        stats->totalCycles[i] += stats->cycles[i];
+    }
+
+    memset(stats->calls, 0, sizeof(stats->calls));
+    memset(stats->cycles, 0, sizeof(stats->cycles));
+    stats->frameBeginCycles = frameCycles;
+    stats->frameBeginCounter = frameCounter;
+    stats->frameCount++;
+}
+
+void GLStatsEnd() {
+    GLStats* stats = &GlobalGLStats;
+    if (!stats->active) {
+        return;
+    }
+
+    stats->gl->functions = stats->functions;
+    stats->active = false;
+
+    u64 elapsedCounter = SDL_GetPerformanceCounter() - stats->beginCounter;
+    f64 cyclesPerSecond = elapsedCounter ? (f64)(ReadCycleCounter() - stats->beginCycles) * (f64)SDL_GetPerformanceFrequency() / (f64)elapsedCounter : 0.0;
+    f64 msPerCycle = cyclesPerSecond > 0.0 ? 1000.0 / cyclesPerSecond : 0.0;
+
+    u64 callCount = 0;
+    u64 cycleCount = 0;
+    for (u32 i = 0; i < OpenGL::FunctionCount; i++) {
+        callCount += stats->totalCalls[i];
+        cycleCount += stats->totalCycles[i];
+    }
+
+    u32 frameCount = Max(stats->frameCount, 1u);
+    log_print("[GLStats] %u frames, %.1f calls and %.3f ms per frame\n", stats->frameCount,
+              (f64)callCount / frameCount, (f64)cycleCount * msPerCycle / frameCount);
+
+    // NOTE(swarzzy): Selecting the most expensive functions. The table is small so it is done the simple way
+    u32 report[GLStats::ReportCount];
+    u32 reportCount = 0;
+    for (u32 i = 0; i < OpenGL::FunctionCount; i++) {
+        if (!stats->totalCalls[i]) {
+            continue;
+        }
+        u32 at = Min(reportCount, GLStats::ReportCount - 1);
+        if (reportCount == GLStats::ReportCount && stats->totalCycles[report[at]] >= stats->totalCycles[i]) {
+            continue;
+        }
+        while (at && stats->totalCycles[report[at - 1]] < stats->totalCycles[i]) {
+            report[at] = report[at - 1];
+            at--;
+        }
+        report[at] = i;
+        reportCount = Min(reportCount + 1, GLStats::ReportCount);
+    }
+
+    for (u32 i = 0; i < reportCount; i++) {
+        u32 index = report[i];
+        log_print("[GLStats] %-32s %10llu calls %9.3f ms %8.1f cycles per call\n", OpenGL::FunctionNames[index],
+                  (unsigned long long)stats->totalCalls[index], (f64)stats->totalCycles[index] * msPerCycle,
+                  (f64)stats->totalCycles[index] / (f64)stats->totalCalls[index]);
+    }
+}
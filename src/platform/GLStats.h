@@ -0,0 +1,50 @@
+#pragma once
+
+// NOTE: Counts calls made through the OpenGL function table. Every entry of the table is replaced with a thunk
+// which reads the cycle counter around the call. Unlike GLCapture nothing is written, so it is cheap enough
+// to be left enabled in release builds. Counters of the last frame are published in PlatformState::glStats
+// and totals of the whole run are logged when statistics are disabled
+
+enum struct GLCallKind : u8 {
+    Other = 0, Draw, StateChange, Uniform
+};
+
+struct GLStats {
+    // Any non-zero value enables statistics
+    static constexpr const char* Variable = "PONG_GL_STATS";
+    // Number of the most expensive functions in the final report
+    static const u32 ReportCount = 12;
+
+    b32 active;
+    u32 frameCount;
+
+    // Counters of the frame in progress. The GL worker thread uses the same table and the counters are not atomic,
+    // so a call made by both threads at once may be lost. This is fine for statistics
+    u32 calls[OpenGL::FunctionCount];
+    u64 cycles[OpenGL::FunctionCount];
+    GLCallKind kinds[OpenGL::FunctionCount];
+
+    // Totals since statistics were enabled
+    u64 totalCalls[OpenGL::FunctionCount];
+    u64 totalCycles[OpenGL::FunctionCount];
+    u64 beginCycles;
+    u64 beginCounter;
+
+    // Used to measure the cycle counter frequency
+    u64 frameBeginCycles;
+    u64 frameBeginCounter;
+    OpenGLFrameStats frame;
+
+    // Actual functions. Entries of the table are thunks while counting
+    OpenGL::Functions functions;
+    OpenGL* gl;
+};
+
+// Wraps all functions of the table. Returns stats of the last frame which stay valid until GLStatsEnd
+const OpenGLFrameStats* GLStatsBegin(OpenGL* gl);
+// Enables statistics if the environment variable is set. Returns null otherwise
+const OpenGLFrameStats* GLStatsInitFromEnvironment(OpenGL* gl);
+// Publishes counters of the frame and resets them
+void GLStatsEndFrame();
+// Restores the table and logs totals
+void GLStatsEnd();
@@ -16,6 +16,11 @@ void UnloadGameCode(LibraryData* lib) {
     remove(LibraryData::TempLibName);
 }
 
+b32 GameCodeChanged(const LibraryData* lib) {
+    struct stat fileAttribs;
+    return stat(LibraryData::LibName, &fileAttribs) == 0 && fileAttribs.st_mtime != lib->lastChangeTime;
+}
+
 b32 UpdateGameCode(LibraryData* lib) {
     b32 updated = false;
     struct stat fileAttribs;
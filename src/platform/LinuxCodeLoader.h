@@ -17,5 +17,7 @@ struct LibraryData
     void* handle;
 };
 
+// Returns true if the library was rebuilt since it was loaded and the next UpdateGameCode will reload it
+b32 GameCodeChanged(const LibraryData* lib);
 b32 UpdateGameCode(LibraryData* lib);
 void UnloadGameCode(LibraryData* lib);
@@ -10,732 +10,433 @@
 #undef APIENTRY
 #endif
 
+// KHR_parallel_shader_compile
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC) (GLuint count);
+
+// NOTE: Every function known to the platform as X(type, name). Functions listed in OpenGLUsed.h are
+// resolved at startup and fail the loading if missing. The rest are resolved on the first call
+#define OPENGL_FUNCTIONS(X) \
+    /* 1.0 */ \
+    X(PFNGLCULLFACEPROC, glCullFace) \
+    X(PFNGLFRONTFACEPROC, glFrontFace) \
+    X(PFNGLHINTPROC, glHint) \
+    X(PFNGLLINEWIDTHPROC, glLineWidth) \
+    X(PFNGLPOINTSIZEPROC, glPointSize) \
+    X(PFNGLPOLYGONMODEPROC, glPolygonMode) \
+    X(PFNGLSCISSORPROC, glScissor) \
+    X(PFNGLTEXPARAMETERFPROC, glTexParameterf) \
+    X(PFNGLTEXPARAMETERFVPROC, glTexParameterfv) \
+    X(PFNGLTEXPARAMETERIPROC, glTexParameteri) \
+    X(PFNGLTEXPARAMETERIVPROC, glTexParameteriv) \
+    X(PFNGLTEXIMAGE1DPROC, glTexImage1D) \
+    X(PFNGLTEXIMAGE2DPROC, glTexImage2D) \
+    X(PFNGLDRAWBUFFERPROC, glDrawBuffer) \
+    X(PFNGLCLEARPROC, glClear) \
+    X(PFNGLCLEARCOLORPROC, glClearColor) \
+    X(PFNGLCLEARSTENCILPROC, glClearStencil) \
+    X(PFNGLCLEARDEPTHPROC, glClearDepth) \
+    X(PFNGLSTENCILMASKPROC, glStencilMask) \
+    X(PFNGLCOLORMASKPROC, glColorMask) \
+    X(PFNGLDEPTHMASKPROC, glDepthMask) \
+    X(PFNGLDISABLEPROC, glDisable) \
+    X(PFNGLENABLEPROC, glEnable) \
+    X(PFNGLFINISHPROC, glFinish) \
+    X(PFNGLFLUSHPROC, glFlush) \
+    X(PFNGLBLENDFUNCPROC, glBlendFunc) \
+    X(PFNGLLOGICOPPROC, glLogicOp) \
+    X(PFNGLSTENCILFUNCPROC, glStencilFunc) \
+    X(PFNGLSTENCILOPPROC, glStencilOp) \
+    X(PFNGLDEPTHFUNCPROC, glDepthFunc) \
+    X(PFNGLPIXELSTOREFPROC, glPixelStoref) \
+    X(PFNGLPIXELSTOREIPROC, glPixelStorei) \
+    X(PFNGLREADBUFFERPROC, glReadBuffer) \
+    X(PFNGLREADPIXELSPROC, glReadPixels) \
+    X(PFNGLGETBOOLEANVPROC, glGetBooleanv) \
+    X(PFNGLGETDOUBLEVPROC, glGetDoublev) \
+    X(PFNGLGETERRORPROC, glGetError) \
+    X(PFNGLGETFLOATVPROC, glGetFloatv) \
+    X(PFNGLGETINTEGERVPROC, glGetIntegerv) \
+    X(PFNGLGETSTRINGPROC, glGetString) \
+    X(PFNGLGETTEXIMAGEPROC, glGetTexImage) \
+    X(PFNGLGETTEXPARAMETERFVPROC, glGetTexParameterfv) \
+    X(PFNGLGETTEXPARAMETERIVPROC, glGetTexParameteriv) \
+    X(PFNGLGETTEXLEVELPARAMETERFVPROC, glGetTexLevelParameterfv) \
+    X(PFNGLGETTEXLEVELPARAMETERIVPROC, glGetTexLevelParameteriv) \
+    X(PFNGLISENABLEDPROC, glIsEnabled) \
+    X(PFNGLDEPTHRANGEPROC, glDepthRange) \
+    X(PFNGLVIEWPORTPROC, glViewport) \
+    /* 1.1 */ \
+    X(PFNGLDRAWARRAYSPROC, glDrawArrays) \
+    X(PFNGLDRAWELEMENTSPROC, glDrawElements) \
+    X(PFNGLGETPOINTERVPROC, glGetPointerv) \
+    X(PFNGLPOLYGONOFFSETPROC, glPolygonOffset) \
+    X(PFNGLCOPYTEXIMAGE1DPROC, glCopyTexImage1D) \
+    X(PFNGLCOPYTEXIMAGE2DPROC, glCopyTexImage2D) \
+    X(PFNGLCOPYTEXSUBIMAGE1DPROC, glCopyTexSubImage1D) \
+    X(PFNGLCOPYTEXSUBIMAGE2DPROC, glCopyTexSubImage2D) \
+    X(PFNGLTEXSUBIMAGE1DPROC, glTexSubImage1D) \
+    X(PFNGLTEXSUBIMAGE2DPROC, glTexSubImage2D) \
+    X(PFNGLBINDTEXTUREPROC, glBindTexture) \
+    X(PFNGLDELETETEXTURESPROC, glDeleteTextures) \
+    X(PFNGLGENTEXTURESPROC, glGenTextures) \
+    X(PFNGLISTEXTUREPROC, glIsTexture) \
+    /* 1.2 */ \
+    X(PFNGLDRAWRANGEELEMENTSPROC, glDrawRangeElements) \
+    X(PFNGLTEXIMAGE3DPROC, glTexImage3D) \
+    X(PFNGLTEXSUBIMAGE3DPROC, glTexSubImage3D) \
+    X(PFNGLCOPYTEXSUBIMAGE3DPROC, glCopyTexSubImage3D) \
+    /* 1.3 */ \
+    X(PFNGLACTIVETEXTUREPROC, glActiveTexture) \
+    X(PFNGLSAMPLECOVERAGEPROC, glSampleCoverage) \
+    X(PFNGLCOMPRESSEDTEXIMAGE3DPROC, glCompressedTexImage3D) \
+    X(PFNGLCOMPRESSEDTEXIMAGE2DPROC, glCompressedTexImage2D) \
+    X(PFNGLCOMPRESSEDTEXIMAGE1DPROC, glCompressedTexImage1D) \
+    X(PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC, glCompressedTexSubImage3D) \
+    X(PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC, glCompressedTexSubImage2D) \
+    X(PFNGLCOMPRESSEDTEXSUBIMAGE1DPROC, glCompressedTexSubImage1D) \
+    X(PFNGLGETCOMPRESSEDTEXIMAGEPROC, glGetCompressedTexImage) \
+    /* 1.4 */ \
+    X(PFNGLBLENDFUNCSEPARATEPROC, glBlendFuncSeparate) \
+    X(PFNGLMULTIDRAWARRAYSPROC, glMultiDrawArrays) \
+    X(PFNGLMULTIDRAWELEMENTSPROC, glMultiDrawElements) \
+    X(PFNGLPOINTPARAMETERFPROC, glPointParameterf) \
+    X(PFNGLPOINTPARAMETERFVPROC, glPointParameterfv) \
+    X(PFNGLPOINTPARAMETERIPROC, glPointParameteri) \
+    X(PFNGLPOINTPARAMETERIVPROC, glPointParameteriv) \
+    X(PFNGLBLENDCOLORPROC, glBlendColor) \
+    X(PFNGLBLENDEQUATIONPROC, glBlendEquation) \
+    /* 1.5 */ \
+    X(PFNGLGENQUERIESPROC, glGenQueries) \
+    X(PFNGLDELETEQUERIESPROC, glDeleteQueries) \
+    X(PFNGLISQUERYPROC, glIsQuery) \
+    X(PFNGLBEGINQUERYPROC, glBeginQuery) \
+    X(PFNGLENDQUERYPROC, glEndQuery) \
+    X(PFNGLGETQUERYIVPROC, glGetQueryiv) \
+    X(PFNGLGETQUERYOBJECTIVPROC, glGetQueryObjectiv) \
+    X(PFNGLGETQUERYOBJECTUIVPROC, glGetQueryObjectuiv) \
+    X(PFNGLBINDBUFFERPROC, glBindBuffer) \
+    X(PFNGLDELETEBUFFERSPROC, glDeleteBuffers) \
+    X(PFNGLGENBUFFERSPROC, glGenBuffers) \
+    X(PFNGLISBUFFERPROC, glIsBuffer) \
+    X(PFNGLBUFFERDATAPROC, glBufferData) \
+    X(PFNGLBUFFERSUBDATAPROC, glBufferSubData) \
+    X(PFNGLGETBUFFERSUBDATAPROC, glGetBufferSubData) \
+    X(PFNGLMAPBUFFERPROC, glMapBuffer) \
+    X(PFNGLUNMAPBUFFERPROC, glUnmapBuffer) \
+    X(PFNGLGETBUFFERPARAMETERIVPROC, glGetBufferParameteriv) \
+    X(PFNGLGETBUFFERPOINTERVPROC, glGetBufferPointerv) \
+    /* 2.0 */ \
+    X(PFNGLBLENDEQUATIONSEPARATEPROC, glBlendEquationSeparate) \
+    X(PFNGLDRAWBUFFERSPROC, glDrawBuffers) \
+    X(PFNGLSTENCILOPSEPARATEPROC, glStencilOpSeparate) \
+    X(PFNGLSTENCILFUNCSEPARATEPROC, glStencilFuncSeparate) \
+    X(PFNGLSTENCILMASKSEPARATEPROC, glStencilMaskSeparate) \
+    X(PFNGLATTACHSHADERPROC, glAttachShader) \
+    X(PFNGLBINDATTRIBLOCATIONPROC, glBindAttribLocation) \
+    X(PFNGLCOMPILESHADERPROC, glCompileShader) \
+    X(PFNGLCREATEPROGRAMPROC, glCreateProgram) \
+    X(PFNGLCREATESHADERPROC, glCreateShader) \
+    X(PFNGLDELETEPROGRAMPROC, glDeleteProgram) \
+    X(PFNGLDELETESHADERPROC, glDeleteShader) \
+    X(PFNGLDETACHSHADERPROC, glDetachShader) \
+    X(PFNGLDISABLEVERTEXATTRIBARRAYPROC, glDisableVertexAttribArray) \
+    X(PFNGLENABLEVERTEXATTRIBARRAYPROC, glEnableVertexAttribArray) \
+    X(PFNGLGETACTIVEATTRIBPROC, glGetActiveAttrib) \
+    X(PFNGLGETACTIVEUNIFORMPROC, glGetActiveUniform) \
+    X(PFNGLGETATTACHEDSHADERSPROC, glGetAttachedShaders) \
+    X(PFNGLGETATTRIBLOCATIONPROC, glGetAttribLocation) \
+    X(PFNGLGETPROGRAMIVPROC, glGetProgramiv) \
+    X(PFNGLGETPROGRAMINFOLOGPROC, glGetProgramInfoLog) \
+    X(PFNGLGETSHADERIVPROC, glGetShaderiv) \
+    X(PFNGLGETSHADERINFOLOGPROC, glGetShaderInfoLog) \
+    X(PFNGLGETSHADERSOURCEPROC, glGetShaderSource) \
+    X(PFNGLGETUNIFORMLOCATIONPROC, glGetUniformLocation) \
+    X(PFNGLGETUNIFORMFVPROC, glGetUniformfv) \
+    X(PFNGLGETUNIFORMIVPROC, glGetUniformiv) \
+    X(PFNGLGETVERTEXATTRIBDVPROC, glGetVertexAttribdv) \
+    X(PFNGLGETVERTEXATTRIBFVPROC, glGetVertexAttribfv) \
+    X(PFNGLGETVERTEXATTRIBIVPROC, glGetVertexAttribiv) \
+    X(PFNGLGETVERTEXATTRIBPOINTERVPROC, glGetVertexAttribPointerv) \
+    X(PFNGLISPROGRAMPROC, glIsProgram) \
+    X(PFNGLISSHADERPROC, glIsShader) \
+    X(PFNGLLINKPROGRAMPROC, glLinkProgram) \
+    X(PFNGLSHADERSOURCEPROC, glShaderSource) \
+    X(PFNGLUSEPROGRAMPROC, glUseProgram) \
+    X(PFNGLUNIFORM1FPROC, glUniform1f) \
+    X(PFNGLUNIFORM2FPROC, glUniform2f) \
+    X(PFNGLUNIFORM3FPROC, glUniform3f) \
+    X(PFNGLUNIFORM4FPROC, glUniform4f) \
+    X(PFNGLUNIFORM1IPROC, glUniform1i) \
+    X(PFNGLUNIFORM2IPROC, glUniform2i) \
+    X(PFNGLUNIFORM3IPROC, glUniform3i) \
+    X(PFNGLUNIFORM4IPROC, glUniform4i) \
+    X(PFNGLUNIFORM1FVPROC, glUniform1fv) \
+    X(PFNGLUNIFORM2FVPROC, glUniform2fv) \
+    X(PFNGLUNIFORM3FVPROC, glUniform3fv) \
+    X(PFNGLUNIFORM4FVPROC, glUniform4fv) \
+    X(PFNGLUNIFORM1IVPROC, glUniform1iv) \
+    X(PFNGLUNIFORM2IVPROC, glUniform2iv) \
+    X(PFNGLUNIFORM3IVPROC, glUniform3iv) \
+    X(PFNGLUNIFORM4IVPROC, glUniform4iv) \
+    X(PFNGLUNIFORMMATRIX2FVPROC, glUniformMatrix2fv) \
+    X(PFNGLUNIFORMMATRIX3FVPROC, glUniformMatrix3fv) \
+    X(PFNGLUNIFORMMATRIX4FVPROC, glUniformMatrix4fv) \
+    X(PFNGLVALIDATEPROGRAMPROC, glValidateProgram) \
+    X(PFNGLVERTEXATTRIB1DPROC, glVertexAttrib1d) \
+    X(PFNGLVERTEXATTRIB1DVPROC, glVertexAttrib1dv) \
+    X(PFNGLVERTEXATTRIB1FPROC, glVertexAttrib1f) \
+    X(PFNGLVERTEXATTRIB1FVPROC, glVertexAttrib1fv) \
+    X(PFNGLVERTEXATTRIB1SPROC, glVertexAttrib1s) \
+    X(PFNGLVERTEXATTRIB1SVPROC, glVertexAttrib1sv) \
+    X(PFNGLVERTEXATTRIB2DPROC, glVertexAttrib2d) \
+    X(PFNGLVERTEXATTRIB2DVPROC, glVertexAttrib2dv) \
+    X(PFNGLVERTEXATTRIB2FPROC, glVertexAttrib2f) \
+    X(PFNGLVERTEXATTRIB2FVPROC, glVertexAttrib2fv) \
+    X(PFNGLVERTEXATTRIB2SPROC, glVertexAttrib2s) \
+    X(PFNGLVERTEXATTRIB2SVPROC, glVertexAttrib2sv) \
+    X(PFNGLVERTEXATTRIB3DPROC, glVertexAttrib3d) \
+    X(PFNGLVERTEXATTRIB3DVPROC, glVertexAttrib3dv) \
+    X(PFNGLVERTEXATTRIB3FPROC, glVertexAttrib3f) \
+    X(PFNGLVERTEXATTRIB3FVPROC, glVertexAttrib3fv) \
+    X(PFNGLVERTEXATTRIB3SPROC, glVertexAttrib3s) \
+    X(PFNGLVERTEXATTRIB3SVPROC, glVertexAttrib3sv) \
+    X(PFNGLVERTEXATTRIB4NBVPROC, glVertexAttrib4Nbv) \
+    X(PFNGLVERTEXATTRIB4NIVPROC, glVertexAttrib4Niv) \
+    X(PFNGLVERTEXATTRIB4NSVPROC, glVertexAttrib4Nsv) \
+    X(PFNGLVERTEXATTRIB4NUBPROC, glVertexAttrib4Nub) \
+    X(PFNGLVERTEXATTRIB4NUBVPROC, glVertexAttrib4Nubv) \
+    X(PFNGLVERTEXATTRIB4NUIVPROC, glVertexAttrib4Nuiv) \
+    X(PFNGLVERTEXATTRIB4NUSVPROC, glVertexAttrib4Nusv) \
+    X(PFNGLVERTEXATTRIB4BVPROC, glVertexAttrib4bv) \
+    X(PFNGLVERTEXATTRIB4DPROC, glVertexAttrib4d) \
+    X(PFNGLVERTEXATTRIB4DVPROC, glVertexAttrib4dv) \
+    X(PFNGLVERTEXATTRIB4FPROC, glVertexAttrib4f) \
+    X(PFNGLVERTEXATTRIB4FVPROC, glVertexAttrib4fv) \
+    X(PFNGLVERTEXATTRIB4IVPROC, glVertexAttrib4iv) \
+    X(PFNGLVERTEXATTRIB4SPROC, glVertexAttrib4s) \
+    X(PFNGLVERTEXATTRIB4SVPROC, glVertexAttrib4sv) \
+    X(PFNGLVERTEXATTRIB4UBVPROC, glVertexAttrib4ubv) \
+    X(PFNGLVERTEXATTRIB4UIVPROC, glVertexAttrib4uiv) \
+    X(PFNGLVERTEXATTRIB4USVPROC, glVertexAttrib4usv) \
+    X(PFNGLVERTEXATTRIBPOINTERPROC, glVertexAttribPointer) \
+    /* 2.1 */ \
+    X(PFNGLUNIFORMMATRIX2X3FVPROC, glUniformMatrix2x3fv) \
+    X(PFNGLUNIFORMMATRIX3X2FVPROC, glUniformMatrix3x2fv) \
+    X(PFNGLUNIFORMMATRIX2X4FVPROC, glUniformMatrix2x4fv) \
+    X(PFNGLUNIFORMMATRIX4X2FVPROC, glUniformMatrix4x2fv) \
+    X(PFNGLUNIFORMMATRIX3X4FVPROC, glUniformMatrix3x4fv) \
+    X(PFNGLUNIFORMMATRIX4X3FVPROC, glUniformMatrix4x3fv) \
+    /* 3.0 */ \
+    X(PFNGLCOLORMASKIPROC, glColorMaski) \
+    X(PFNGLGETBOOLEANI_VPROC, glGetBooleani_v) \
+    X(PFNGLGETINTEGERI_VPROC, glGetIntegeri_v) \
+    X(PFNGLENABLEIPROC, glEnablei) \
+    X(PFNGLDISABLEIPROC, glDisablei) \
+    X(PFNGLISENABLEDIPROC, glIsEnabledi) \
+    X(PFNGLBEGINTRANSFORMFEEDBACKPROC, glBeginTransformFeedback) \
+    X(PFNGLENDTRANSFORMFEEDBACKPROC, glEndTransformFeedback) \
+    X(PFNGLBINDBUFFERRANGEPROC, glBindBufferRange) \
+    X(PFNGLBINDBUFFERBASEPROC, glBindBufferBase) \
+    X(PFNGLTRANSFORMFEEDBACKVARYINGSPROC, glTransformFeedbackVaryings) \
+    X(PFNGLGETTRANSFORMFEEDBACKVARYINGPROC, glGetTransformFeedbackVarying) \
+    X(PFNGLCLAMPCOLORPROC, glClampColor) \
+    X(PFNGLBEGINCONDITIONALRENDERPROC, glBeginConditionalRender) \
+    X(PFNGLENDCONDITIONALRENDERPROC, glEndConditionalRender) \
+    X(PFNGLVERTEXATTRIBIPOINTERPROC, glVertexAttribIPointer) \
+    X(PFNGLGETVERTEXATTRIBIIVPROC, glGetVertexAttribIiv) \
+    X(PFNGLGETVERTEXATTRIBIUIVPROC, glGetVertexAttribIuiv) \
+    X(PFNGLVERTEXATTRIBI1IPROC, glVertexAttribI1i) \
+    X(PFNGLVERTEXATTRIBI2IPROC, glVertexAttribI2i) \
+    X(PFNGLVERTEXATTRIBI3IPROC, glVertexAttribI3i) \
+    X(PFNGLVERTEXATTRIBI4IPROC, glVertexAttribI4i) \
+    X(PFNGLVERTEXATTRIBI1UIPROC, glVertexAttribI1ui) \
+    X(PFNGLVERTEXATTRIBI2UIPROC, glVertexAttribI2ui) \
+    X(PFNGLVERTEXATTRIBI3UIPROC, glVertexAttribI3ui) \
+    X(PFNGLVERTEXATTRIBI4UIPROC, glVertexAttribI4ui) \
+    X(PFNGLVERTEXATTRIBI1IVPROC, glVertexAttribI1iv) \
+    X(PFNGLVERTEXATTRIBI2IVPROC, glVertexAttribI2iv) \
+    X(PFNGLVERTEXATTRIBI3IVPROC, glVertexAttribI3iv) \
+    X(PFNGLVERTEXATTRIBI4IVPROC, glVertexAttribI4iv) \
+    X(PFNGLVERTEXATTRIBI1UIVPROC, glVertexAttribI1uiv) \
+    X(PFNGLVERTEXATTRIBI2UIVPROC, glVertexAttribI2uiv) \
+    X(PFNGLVERTEXATTRIBI3UIVPROC, glVertexAttribI3uiv) \
+    X(PFNGLVERTEXATTRIBI4UIVPROC, glVertexAttribI4uiv) \
+    X(PFNGLVERTEXATTRIBI4BVPROC, glVertexAttribI4bv) \
+    X(PFNGLVERTEXATTRIBI4SVPROC, glVertexAttribI4sv) \
+    X(PFNGLVERTEXATTRIBI4UBVPROC, glVertexAttribI4ubv) \
+    X(PFNGLVERTEXATTRIBI4USVPROC, glVertexAttribI4usv) \
+    X(PFNGLGETUNIFORMUIVPROC, glGetUniformuiv) \
+    X(PFNGLBINDFRAGDATALOCATIONPROC, glBindFragDataLocation) \
+    X(PFNGLGETFRAGDATALOCATIONPROC, glGetFragDataLocation) \
+    X(PFNGLUNIFORM1UIPROC, glUniform1ui) \
+    X(PFNGLUNIFORM2UIPROC, glUniform2ui) \
+    X(PFNGLUNIFORM3UIPROC, glUniform3ui) \
+    X(PFNGLUNIFORM4UIPROC, glUniform4ui) \
+    X(PFNGLUNIFORM1UIVPROC, glUniform1uiv) \
+    X(PFNGLUNIFORM2UIVPROC, glUniform2uiv) \
+    X(PFNGLUNIFORM3UIVPROC, glUniform3uiv) \
+    X(PFNGLUNIFORM4UIVPROC, glUniform4uiv) \
+    X(PFNGLTEXPARAMETERIIVPROC, glTexParameterIiv) \
+    X(PFNGLTEXPARAMETERIUIVPROC, glTexParameterIuiv) \
+    X(PFNGLGETTEXPARAMETERIIVPROC, glGetTexParameterIiv) \
+    X(PFNGLGETTEXPARAMETERIUIVPROC, glGetTexParameterIuiv) \
+    X(PFNGLCLEARBUFFERIVPROC, glClearBufferiv) \
+    X(PFNGLCLEARBUFFERUIVPROC, glClearBufferuiv) \
+    X(PFNGLCLEARBUFFERFVPROC, glClearBufferfv) \
+    X(PFNGLCLEARBUFFERFIPROC, glClearBufferfi) \
+    X(PFNGLGETSTRINGIPROC, glGetStringi) \
+    X(PFNGLISRENDERBUFFERPROC, glIsRenderbuffer) \
+    X(PFNGLBINDRENDERBUFFERPROC, glBindRenderbuffer) \
+    X(PFNGLDELETERENDERBUFFERSPROC, glDeleteRenderbuffers) \
+    X(PFNGLGENRENDERBUFFERSPROC, glGenRenderbuffers) \
+    X(PFNGLRENDERBUFFERSTORAGEPROC, glRenderbufferStorage) \
+    X(PFNGLGETRENDERBUFFERPARAMETERIVPROC, glGetRenderbufferParameteriv) \
+    X(PFNGLISFRAMEBUFFERPROC, glIsFramebuffer) \
+    X(PFNGLBINDFRAMEBUFFERPROC, glBindFramebuffer) \
+    X(PFNGLDELETEFRAMEBUFFERSPROC, glDeleteFramebuffers) \
+    X(PFNGLGENFRAMEBUFFERSPROC, glGenFramebuffers) \
+    X(PFNGLCHECKFRAMEBUFFERSTATUSPROC, glCheckFramebufferStatus) \
+    X(PFNGLFRAMEBUFFERTEXTURE1DPROC, glFramebufferTexture1D) \
+    X(PFNGLFRAMEBUFFERTEXTURE2DPROC, glFramebufferTexture2D) \
+    X(PFNGLFRAMEBUFFERTEXTURE3DPROC, glFramebufferTexture3D) \
+    X(PFNGLFRAMEBUFFERRENDERBUFFERPROC, glFramebufferRenderbuffer) \
+    X(PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC, glGetFramebufferAttachmentParameteriv) \
+    X(PFNGLGENERATEMIPMAPPROC, glGenerateMipmap) \
+    X(PFNGLBLITFRAMEBUFFERPROC, glBlitFramebuffer) \
+    X(PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC, glRenderbufferStorageMultisample) \
+    X(PFNGLFRAMEBUFFERTEXTURELAYERPROC, glFramebufferTextureLayer) \
+    X(PFNGLMAPBUFFERRANGEPROC, glMapBufferRange) \
+    X(PFNGLFLUSHMAPPEDBUFFERRANGEPROC, glFlushMappedBufferRange) \
+    X(PFNGLBINDVERTEXARRAYPROC, glBindVertexArray) \
+    X(PFNGLDELETEVERTEXARRAYSPROC, glDeleteVertexArrays) \
+    X(PFNGLGENVERTEXARRAYSPROC, glGenVertexArrays) \
+    X(PFNGLISVERTEXARRAYPROC, glIsVertexArray) \
+    /* 3.1 */ \
+    X(PFNGLDRAWARRAYSINSTANCEDPROC, glDrawArraysInstanced) \
+    X(PFNGLDRAWELEMENTSINSTANCEDPROC, glDrawElementsInstanced) \
+    X(PFNGLTEXBUFFERPROC, glTexBuffer) \
+    X(PFNGLPRIMITIVERESTARTINDEXPROC, glPrimitiveRestartIndex) \
+    X(PFNGLCOPYBUFFERSUBDATAPROC, glCopyBufferSubData) \
+    X(PFNGLGETUNIFORMINDICESPROC, glGetUniformIndices) \
+    X(PFNGLGETACTIVEUNIFORMSIVPROC, glGetActiveUniformsiv) \
+    X(PFNGLGETACTIVEUNIFORMNAMEPROC, glGetActiveUniformName) \
+    X(PFNGLGETUNIFORMBLOCKINDEXPROC, glGetUniformBlockIndex) \
+    X(PFNGLGETACTIVEUNIFORMBLOCKIVPROC, glGetActiveUniformBlockiv) \
+    X(PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC, glGetActiveUniformBlockName) \
+    X(PFNGLUNIFORMBLOCKBINDINGPROC, glUniformBlockBinding) \
+    /* 3.2 */ \
+    X(PFNGLDRAWELEMENTSBASEVERTEXPROC, glDrawElementsBaseVertex) \
+    X(PFNGLDRAWRANGEELEMENTSBASEVERTEXPROC, glDrawRangeElementsBaseVertex) \
+    X(PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC, glDrawElementsInstancedBaseVertex) \
+    X(PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC, glMultiDrawElementsBaseVertex) \
+    X(PFNGLPROVOKINGVERTEXPROC, glProvokingVertex) \
+    X(PFNGLFENCESYNCPROC, glFenceSync) \
+    X(PFNGLISSYNCPROC, glIsSync) \
+    X(PFNGLDELETESYNCPROC, glDeleteSync) \
+    X(PFNGLCLIENTWAITSYNCPROC, glClientWaitSync) \
+    X(PFNGLWAITSYNCPROC, glWaitSync) \
+    X(PFNGLGETINTEGER64VPROC, glGetInteger64v) \
+    X(PFNGLGETSYNCIVPROC, glGetSynciv) \
+    X(PFNGLGETINTEGER64I_VPROC, glGetInteger64i_v) \
+    X(PFNGLGETBUFFERPARAMETERI64VPROC, glGetBufferParameteri64v) \
+    X(PFNGLFRAMEBUFFERTEXTUREPROC, glFramebufferTexture) \
+    X(PFNGLTEXIMAGE2DMULTISAMPLEPROC, glTexImage2DMultisample) \
+    X(PFNGLTEXIMAGE3DMULTISAMPLEPROC, glTexImage3DMultisample) \
+    X(PFNGLGETMULTISAMPLEFVPROC, glGetMultisamplefv) \
+    X(PFNGLSAMPLEMASKIPROC, glSampleMaski) \
+    /* 3.3 */ \
+    X(PFNGLBINDFRAGDATALOCATIONINDEXEDPROC, glBindFragDataLocationIndexed) \
+    X(PFNGLGETFRAGDATAINDEXPROC, glGetFragDataIndex) \
+    X(PFNGLGENSAMPLERSPROC, glGenSamplers) \
+    X(PFNGLDELETESAMPLERSPROC, glDeleteSamplers) \
+    X(PFNGLISSAMPLERPROC, glIsSampler) \
+    X(PFNGLBINDSAMPLERPROC, glBindSampler) \
+    X(PFNGLSAMPLERPARAMETERIPROC, glSamplerParameteri) \
+    X(PFNGLSAMPLERPARAMETERIVPROC, glSamplerParameteriv) \
+    X(PFNGLSAMPLERPARAMETERFPROC, glSamplerParameterf) \
+    X(PFNGLSAMPLERPARAMETERFVPROC, glSamplerParameterfv) \
+    X(PFNGLSAMPLERPARAMETERIIVPROC, glSamplerParameterIiv) \
+    X(PFNGLSAMPLERPARAMETERIUIVPROC, glSamplerParameterIuiv) \
+    X(PFNGLGETSAMPLERPARAMETERIVPROC, glGetSamplerParameteriv) \
+    X(PFNGLGETSAMPLERPARAMETERIIVPROC, glGetSamplerParameterIiv) \
+    X(PFNGLGETSAMPLERPARAMETERFVPROC, glGetSamplerParameterfv) \
+    X(PFNGLGETSAMPLERPARAMETERIUIVPROC, glGetSamplerParameterIuiv) \
+    X(PFNGLQUERYCOUNTERPROC, glQueryCounter) \
+    X(PFNGLGETQUERYOBJECTI64VPROC, glGetQueryObjecti64v) \
+    X(PFNGLGETQUERYOBJECTUI64VPROC, glGetQueryObjectui64v) \
+    X(PFNGLVERTEXATTRIBDIVISORPROC, glVertexAttribDivisor) \
+    X(PFNGLVERTEXATTRIBP1UIPROC, glVertexAttribP1ui) \
+    X(PFNGLVERTEXATTRIBP1UIVPROC, glVertexAttribP1uiv) \
+    X(PFNGLVERTEXATTRIBP2UIPROC, glVertexAttribP2ui) \
+    X(PFNGLVERTEXATTRIBP2UIVPROC, glVertexAttribP2uiv) \
+    X(PFNGLVERTEXATTRIBP3UIPROC, glVertexAttribP3ui) \
+    X(PFNGLVERTEXATTRIBP3UIVPROC, glVertexAttribP3uiv) \
+    X(PFNGLVERTEXATTRIBP4UIPROC, glVertexAttribP4ui) \
+    X(PFNGLVERTEXATTRIBP4UIVPROC, glVertexAttribP4uiv)
+
+// NOTE: Missing ones don't fail the loading. They may be null, check extension flags before use
+#define OPENGL_OPTIONAL_FUNCTIONS(X) \
+    /* ARB_get_program_binary */ \
+    X(PFNGLGETPROGRAMBINARYPROC, glGetProgramBinary) \
+    X(PFNGLPROGRAMBINARYPROC, glProgramBinary) \
+    X(PFNGLPROGRAMPARAMETERIPROC, glProgramParameteri) \
+    /* KHR_parallel_shader_compile */ \
+    X(PFNGLMAXSHADERCOMPILERTHREADSKHRPROC, glMaxShaderCompilerThreadsKHR)
+
+#define OPENGL_DECLARE_FUNCTION(type, name) type name;
+#define OPENGL_COUNT_FUNCTION(type, name) + 1
+#define OPENGL_FUNCTION_NAME(type, name) #name,
+
 struct OpenGL
 {
     union Functions
     {
         struct _Functions
         {
-            // 1.0
-            PFNGLCULLFACEPROC glCullFace;
-            PFNGLFRONTFACEPROC glFrontFace;
-            PFNGLHINTPROC glHint;
-            PFNGLLINEWIDTHPROC glLineWidth;
-            PFNGLPOINTSIZEPROC glPointSize;
-            PFNGLPOLYGONMODEPROC glPolygonMode;
-            PFNGLSCISSORPROC glScissor;
-            PFNGLTEXPARAMETERFPROC glTexParameterf;
-            PFNGLTEXPARAMETERFVPROC glTexParameterfv;
-            PFNGLTEXPARAMETERIPROC glTexParameteri;
-            PFNGLTEXPARAMETERIVPROC glTexParameteriv;
-            PFNGLTEXIMAGE1DPROC glTexImage1D;
-            PFNGLTEXIMAGE2DPROC glTexImage2D;
-            PFNGLDRAWBUFFERPROC glDrawBuffer;
-            PFNGLCLEARPROC glClear;
-            PFNGLCLEARCOLORPROC glClearColor;
-            PFNGLCLEARSTENCILPROC glClearStencil;
-            PFNGLCLEARDEPTHPROC glClearDepth;
-            PFNGLSTENCILMASKPROC glStencilMask;
-            PFNGLCOLORMASKPROC glColorMask;
-            PFNGLDEPTHMASKPROC glDepthMask;
-            PFNGLDISABLEPROC glDisable;
-            PFNGLENABLEPROC glEnable;
-            PFNGLFINISHPROC glFinish;
-            PFNGLFLUSHPROC glFlush;
-            PFNGLBLENDFUNCPROC glBlendFunc;
-            PFNGLLOGICOPPROC glLogicOp;
-            PFNGLSTENCILFUNCPROC glStencilFunc;
-            PFNGLSTENCILOPPROC glStencilOp;
-            PFNGLDEPTHFUNCPROC glDepthFunc;
-            PFNGLPIXELSTOREFPROC glPixelStoref;
-            PFNGLPIXELSTOREIPROC glPixelStorei;
-            PFNGLREADBUFFERPROC glReadBuffer;
-            PFNGLREADPIXELSPROC glReadPixels;
-            PFNGLGETBOOLEANVPROC glGetBooleanv;
-            PFNGLGETDOUBLEVPROC glGetDoublev;
-            PFNGLGETERRORPROC glGetError;
-            PFNGLGETFLOATVPROC glGetFloatv;
-            PFNGLGETINTEGERVPROC glGetIntegerv;
-            PFNGLGETSTRINGPROC glGetString;
-            PFNGLGETTEXIMAGEPROC glGetTexImage;
-            PFNGLGETTEXPARAMETERFVPROC glGetTexParameterfv;
-            PFNGLGETTEXPARAMETERIVPROC glGetTexParameteriv;
-            PFNGLGETTEXLEVELPARAMETERFVPROC glGetTexLevelParameterfv;
-            PFNGLGETTEXLEVELPARAMETERIVPROC glGetTexLevelParameteriv;
-            PFNGLISENABLEDPROC glIsEnabled;
-            PFNGLDEPTHRANGEPROC glDepthRange;
-            PFNGLVIEWPORTPROC glViewport;
-            //  11
-            PFNGLDRAWARRAYSPROC glDrawArrays;
-            PFNGLDRAWELEMENTSPROC glDrawElements;
-            PFNGLGETPOINTERVPROC glGetPointerv;
-            PFNGLPOLYGONOFFSETPROC glPolygonOffset;
-            PFNGLCOPYTEXIMAGE1DPROC glCopyTexImage1D;
-            PFNGLCOPYTEXIMAGE2DPROC glCopyTexImage2D;
-            PFNGLCOPYTEXSUBIMAGE1DPROC glCopyTexSubImage1D;
-            PFNGLCOPYTEXSUBIMAGE2DPROC glCopyTexSubImage2D;
-            PFNGLTEXSUBIMAGE1DPROC glTexSubImage1D;
-            PFNGLTEXSUBIMAGE2DPROC glTexSubImage2D;
-            PFNGLBINDTEXTUREPROC glBindTexture;
-            PFNGLDELETETEXTURESPROC glDeleteTextures;
-            PFNGLGENTEXTURESPROC glGenTextures;
-            PFNGLISTEXTUREPROC glIsTexture;
-            //  12
-            PFNGLDRAWRANGEELEMENTSPROC glDrawRangeElements;
-            PFNGLTEXIMAGE3DPROC glTexImage3D;
-            PFNGLTEXSUBIMAGE3DPROC glTexSubImage3D;
-            PFNGLCOPYTEXSUBIMAGE3DPROC glCopyTexSubImage3D;
-            //  13
-            PFNGLACTIVETEXTUREPROC glActiveTexture;
-            PFNGLSAMPLECOVERAGEPROC glSampleCoverage;
-            PFNGLCOMPRESSEDTEXIMAGE3DPROC glCompressedTexImage3D;
-            PFNGLCOMPRESSEDTEXIMAGE2DPROC glCompressedTexImage2D;
-            PFNGLCOMPRESSEDTEXIMAGE1DPROC glCompressedTexImage1D;
-            PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC glCompressedTexSubImage3D;
-            PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC glCompressedTexSubImage2D;
-            PFNGLCOMPRESSEDTEXSUBIMAGE1DPROC glCompressedTexSubImage1D;
-            PFNGLGETCOMPRESSEDTEXIMAGEPROC glGetCompressedTexImage;
-            //  14
-            PFNGLBLENDFUNCSEPARATEPROC glBlendFuncSeparate;
-            PFNGLMULTIDRAWARRAYSPROC glMultiDrawArrays;
-            PFNGLMULTIDRAWELEMENTSPROC glMultiDrawElements;
-            PFNGLPOINTPARAMETERFPROC glPointParameterf;
-            PFNGLPOINTPARAMETERFVPROC glPointParameterfv;
-            PFNGLPOINTPARAMETERIPROC glPointParameteri;
-            PFNGLPOINTPARAMETERIVPROC glPointParameteriv;
-            PFNGLBLENDCOLORPROC glBlendColor;
-            PFNGLBLENDEQUATIONPROC glBlendEquation;
-            // 15
-            PFNGLGENQUERIESPROC glGenQueries;
-            PFNGLDELETEQUERIESPROC glDeleteQueries;
-            PFNGLISQUERYPROC glIsQuery;
-            PFNGLBEGINQUERYPROC glBeginQuery;
-            PFNGLENDQUERYPROC glEndQuery;
-            PFNGLGETQUERYIVPROC glGetQueryiv;
-            PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv;
-            PFNGLGETQUERYOBJECTUIVPROC glGetQueryObjectuiv;
-            PFNGLBINDBUFFERPROC glBindBuffer;
-            PFNGLDELETEBUFFERSPROC glDeleteBuffers;
-            PFNGLGENBUFFERSPROC glGenBuffers;
-            PFNGLISBUFFERPROC glIsBuffer;
-            PFNGLBUFFERDATAPROC glBufferData;
-            PFNGLBUFFERSUBDATAPROC glBufferSubData;
-            PFNGLGETBUFFERSUBDATAPROC glGetBufferSubData;
-            PFNGLMAPBUFFERPROC glMapBuffer;
-            PFNGLUNMAPBUFFERPROC glUnmapBuffer;
-            PFNGLGETBUFFERPARAMETERIVPROC glGetBufferParameteriv;
-            PFNGLGETBUFFERPOINTERVPROC glGetBufferPointerv;
-            //  20
-            PFNGLBLENDEQUATIONSEPARATEPROC glBlendEquationSeparate;
-            PFNGLDRAWBUFFERSPROC glDrawBuffers;
-            PFNGLSTENCILOPSEPARATEPROC glStencilOpSeparate;
-            PFNGLSTENCILFUNCSEPARATEPROC glStencilFuncSeparate;
-            PFNGLSTENCILMASKSEPARATEPROC glStencilMaskSeparate;
-            PFNGLATTACHSHADERPROC glAttachShader;
-            PFNGLBINDATTRIBLOCATIONPROC glBindAttribLocation;
-            PFNGLCOMPILESHADERPROC glCompileShader;
-            PFNGLCREATEPROGRAMPROC glCreateProgram;
-            PFNGLCREATESHADERPROC glCreateShader;
-            PFNGLDELETEPROGRAMPROC glDeleteProgram;
-            PFNGLDELETESHADERPROC glDeleteShader;
-            PFNGLDETACHSHADERPROC glDetachShader;
-            PFNGLDISABLEVERTEXATTRIBARRAYPROC glDisableVertexAttribArray;
-            PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArray;
-            PFNGLGETACTIVEATTRIBPROC glGetActiveAttrib;
-            PFNGLGETACTIVEUNIFORMPROC glGetActiveUniform;
-            PFNGLGETATTACHEDSHADERSPROC glGetAttachedShaders;
-            PFNGLGETATTRIBLOCATIONPROC glGetAttribLocation;
-            PFNGLGETPROGRAMIVPROC glGetProgramiv;
-            PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
-            PFNGLGETSHADERIVPROC glGetShaderiv;
-            PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog;
-            PFNGLGETSHADERSOURCEPROC glGetShaderSource;
-            PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation;
-            PFNGLGETUNIFORMFVPROC glGetUniformfv;
-            PFNGLGETUNIFORMIVPROC glGetUniformiv;
-            PFNGLGETVERTEXATTRIBDVPROC glGetVertexAttribdv;
-            PFNGLGETVERTEXATTRIBFVPROC glGetVertexAttribfv;
-            PFNGLGETVERTEXATTRIBIVPROC glGetVertexAttribiv;
-            PFNGLGETVERTEXATTRIBPOINTERVPROC glGetVertexAttribPointerv;
-            PFNGLISPROGRAMPROC glIsProgram;
-            PFNGLISSHADERPROC glIsShader;
-            PFNGLLINKPROGRAMPROC glLinkProgram;
-            PFNGLSHADERSOURCEPROC glShaderSource;
-            PFNGLUSEPROGRAMPROC glUseProgram;
-            PFNGLUNIFORM1FPROC glUniform1f;
-            PFNGLUNIFORM2FPROC glUniform2f;
-            PFNGLUNIFORM3FPROC glUniform3f;
-            PFNGLUNIFORM4FPROC glUniform4f;
-            PFNGLUNIFORM1IPROC glUniform1i;
-            PFNGLUNIFORM2IPROC glUniform2i;
-            PFNGLUNIFORM3IPROC glUniform3i;
-            PFNGLUNIFORM4IPROC glUniform4i;
-            PFNGLUNIFORM1FVPROC glUniform1fv;
-            PFNGLUNIFORM2FVPROC glUniform2fv;
-            PFNGLUNIFORM3FVPROC glUniform3fv;
-            PFNGLUNIFORM4FVPROC glUniform4fv;
-            PFNGLUNIFORM1IVPROC glUniform1iv;
-            PFNGLUNIFORM2IVPROC glUniform2iv;
-            PFNGLUNIFORM3IVPROC glUniform3iv;
-            PFNGLUNIFORM4IVPROC glUniform4iv;
-            PFNGLUNIFORMMATRIX2FVPROC glUniformMatrix2fv;
-            PFNGLUNIFORMMATRIX3FVPROC glUniformMatrix3fv;
-            PFNGLUNIFORMMATRIX4FVPROC glUniformMatrix4fv;
-            PFNGLVALIDATEPROGRAMPROC glValidateProgram;
-            PFNGLVERTEXATTRIB1DPROC glVertexAttrib1d;
-            PFNGLVERTEXATTRIB1DVPROC glVertexAttrib1dv;
-            PFNGLVERTEXATTRIB1FPROC glVertexAttrib1f;
-            PFNGLVERTEXATTRIB1FVPROC glVertexAttrib1fv;
-            PFNGLVERTEXATTRIB1SPROC glVertexAttrib1s;
-            PFNGLVERTEXATTRIB1SVPROC glVertexAttrib1sv;
-            PFNGLVERTEXATTRIB2DPROC glVertexAttrib2d;
-            PFNGLVERTEXATTRIB2DVPROC glVertexAttrib2dv;
-            PFNGLVERTEXATTRIB2FPROC glVertexAttrib2f;
-            PFNGLVERTEXATTRIB2FVPROC glVertexAttrib2fv;
-            PFNGLVERTEXATTRIB2SPROC glVertexAttrib2s;
-            PFNGLVERTEXATTRIB2SVPROC glVertexAttrib2sv;
-            PFNGLVERTEXATTRIB3DPROC glVertexAttrib3d;
-            PFNGLVERTEXATTRIB3DVPROC glVertexAttrib3dv;
-            PFNGLVERTEXATTRIB3FPROC glVertexAttrib3f;
-            PFNGLVERTEXATTRIB3FVPROC glVertexAttrib3fv;
-            PFNGLVERTEXATTRIB3SPROC glVertexAttrib3s;
-            PFNGLVERTEXATTRIB3SVPROC glVertexAttrib3sv;
-            PFNGLVERTEXATTRIB4NBVPROC glVertexAttrib4Nbv;
-            PFNGLVERTEXATTRIB4NIVPROC glVertexAttrib4Niv;
-            PFNGLVERTEXATTRIB4NSVPROC glVertexAttrib4Nsv;
-            PFNGLVERTEXATTRIB4NUBPROC glVertexAttrib4Nub;
-            PFNGLVERTEXATTRIB4NUBVPROC glVertexAttrib4Nubv;
-            PFNGLVERTEXATTRIB4NUIVPROC glVertexAttrib4Nuiv;
-            PFNGLVERTEXATTRIB4NUSVPROC glVertexAttrib4Nusv;
-            PFNGLVERTEXATTRIB4BVPROC glVertexAttrib4bv;
-            PFNGLVERTEXATTRIB4DPROC glVertexAttrib4d;
-            PFNGLVERTEXATTRIB4DVPROC glVertexAttrib4dv;
-            PFNGLVERTEXATTRIB4FPROC glVertexAttrib4f;
-            PFNGLVERTEXATTRIB4FVPROC glVertexAttrib4fv;
-            PFNGLVERTEXATTRIB4IVPROC glVertexAttrib4iv;
-            PFNGLVERTEXATTRIB4SPROC glVertexAttrib4s;
-            PFNGLVERTEXATTRIB4SVPROC glVertexAttrib4sv;
-            PFNGLVERTEXATTRIB4UBVPROC glVertexAttrib4ubv;
-            PFNGLVERTEXATTRIB4UIVPROC glVertexAttrib4uiv;
-            PFNGLVERTEXATTRIB4USVPROC glVertexAttrib4usv;
-            PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer;
-            //  21
-            PFNGLUNIFORMMATRIX2X3FVPROC glUniformMatrix2x3fv;
-            PFNGLUNIFORMMATRIX3X2FVPROC glUniformMatrix3x2fv;
-            PFNGLUNIFORMMATRIX2X4FVPROC glUniformMatrix2x4fv;
-            PFNGLUNIFORMMATRIX4X2FVPROC glUniformMatrix4x2fv;
-            PFNGLUNIFORMMATRIX3X4FVPROC glUniformMatrix3x4fv;
-            PFNGLUNIFORMMATRIX4X3FVPROC glUniformMatrix4x3fv;
-            //  30
-            PFNGLCOLORMASKIPROC glColorMaski;
-            PFNGLGETBOOLEANI_VPROC glGetBooleani_v;
-            PFNGLGETINTEGERI_VPROC glGetIntegeri_v;
-            PFNGLENABLEIPROC glEnablei;
-            PFNGLDISABLEIPROC glDisablei;
-            PFNGLISENABLEDIPROC glIsEnabledi;
-            PFNGLBEGINTRANSFORMFEEDBACKPROC glBeginTransformFeedback;
-            PFNGLENDTRANSFORMFEEDBACKPROC glEndTransformFeedback;
-            PFNGLBINDBUFFERRANGEPROC glBindBufferRange;
-            PFNGLBINDBUFFERBASEPROC glBindBufferBase;
-            PFNGLTRANSFORMFEEDBACKVARYINGSPROC glTransformFeedbackVaryings;
-            PFNGLGETTRANSFORMFEEDBACKVARYINGPROC glGetTransformFeedbackVarying;
-            PFNGLCLAMPCOLORPROC glClampColor;
-            PFNGLBEGINCONDITIONALRENDERPROC glBeginConditionalRender;
-            PFNGLENDCONDITIONALRENDERPROC glEndConditionalRender;
-            PFNGLVERTEXATTRIBIPOINTERPROC glVertexAttribIPointer;
-            PFNGLGETVERTEXATTRIBIIVPROC glGetVertexAttribIiv;
-            PFNGLGETVERTEXATTRIBIUIVPROC glGetVertexAttribIuiv;
-            PFNGLVERTEXATTRIBI1IPROC glVertexAttribI1i;
-            PFNGLVERTEXATTRIBI2IPROC glVertexAttribI2i;
-            PFNGLVERTEXATTRIBI3IPROC glVertexAttribI3i;
-            PFNGLVERTEXATTRIBI4IPROC glVertexAttribI4i;
-            PFNGLVERTEXATTRIBI1UIPROC glVertexAttribI1ui;
-            PFNGLVERTEXATTRIBI2UIPROC glVertexAttribI2ui;
-            PFNGLVERTEXATTRIBI3UIPROC glVertexAttribI3ui;
-            PFNGLVERTEXATTRIBI4UIPROC glVertexAttribI4ui;
-            PFNGLVERTEXATTRIBI1IVPROC glVertexAttribI1iv;
-            PFNGLVERTEXATTRIBI2IVPROC glVertexAttribI2iv;
-            PFNGLVERTEXATTRIBI3IVPROC glVertexAttribI3iv;
-            PFNGLVERTEXATTRIBI4IVPROC glVertexAttribI4iv;
-            PFNGLVERTEXATTRIBI1UIVPROC glVertexAttribI1uiv;
-            PFNGLVERTEXATTRIBI2UIVPROC glVertexAttribI2uiv;
-            PFNGLVERTEXATTRIBI3UIVPROC glVertexAttribI3uiv;
-            PFNGLVERTEXATTRIBI4UIVPROC glVertexAttribI4uiv;
-            PFNGLVERTEXATTRIBI4BVPROC glVertexAttribI4bv;
-            PFNGLVERTEXATTRIBI4SVPROC glVertexAttribI4sv;
-            PFNGLVERTEXATTRIBI4UBVPROC glVertexAttribI4ubv;
-            PFNGLVERTEXATTRIBI4USVPROC glVertexAttribI4usv;
-            PFNGLGETUNIFORMUIVPROC glGetUniformuiv;
-            PFNGLBINDFRAGDATALOCATIONPROC glBindFragDataLocation;
-            PFNGLGETFRAGDATALOCATIONPROC glGetFragDataLocation;
-            PFNGLUNIFORM1UIPROC glUniform1ui;
-            PFNGLUNIFORM2UIPROC glUniform2ui;
-            PFNGLUNIFORM3UIPROC glUniform3ui;
-            PFNGLUNIFORM4UIPROC glUniform4ui;
-            PFNGLUNIFORM1UIVPROC glUniform1uiv;
-            PFNGLUNIFORM2UIVPROC glUniform2uiv;
-            PFNGLUNIFORM3UIVPROC glUniform3uiv;
-            PFNGLUNIFORM4UIVPROC glUniform4uiv;
-            PFNGLTEXPARAMETERIIVPROC glTexParameterIiv;
-            PFNGLTEXPARAMETERIUIVPROC glTexParameterIuiv;
-            PFNGLGETTEXPARAMETERIIVPROC glGetTexParameterIiv;
-            PFNGLGETTEXPARAMETERIUIVPROC glGetTexParameterIuiv;
-            PFNGLCLEARBUFFERIVPROC glClearBufferiv;
-            PFNGLCLEARBUFFERUIVPROC glClearBufferuiv;
-            PFNGLCLEARBUFFERFVPROC glClearBufferfv;
-            PFNGLCLEARBUFFERFIPROC glClearBufferfi;
-            PFNGLGETSTRINGIPROC glGetStringi;
-            PFNGLISRENDERBUFFERPROC glIsRenderbuffer;
-            PFNGLBINDRENDERBUFFERPROC glBindRenderbuffer;
-            PFNGLDELETERENDERBUFFERSPROC glDeleteRenderbuffers;
-            PFNGLGENRENDERBUFFERSPROC glGenRenderbuffers;
-            PFNGLRENDERBUFFERSTORAGEPROC glRenderbufferStorage;
-            PFNGLGETRENDERBUFFERPARAMETERIVPROC glGetRenderbufferParameteriv;
-            PFNGLISFRAMEBUFFERPROC glIsFramebuffer;
-            PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer;
-            PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers;
-            PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers;
-            PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus;
-            PFNGLFRAMEBUFFERTEXTURE1DPROC glFramebufferTexture1D;
-            PFNGLFRAMEBUFFERTEXTURE2DPROC glFramebufferTexture2D;
-            PFNGLFRAMEBUFFERTEXTURE3DPROC glFramebufferTexture3D;
-            PFNGLFRAMEBUFFERRENDERBUFFERPROC glFramebufferRenderbuffer;
-            PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC glGetFramebufferAttachmentParameteriv;
-            PFNGLGENERATEMIPMAPPROC glGenerateMipmap;
-            PFNGLBLITFRAMEBUFFERPROC glBlitFramebuffer;
-            PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC glRenderbufferStorageMultisample;
-            PFNGLFRAMEBUFFERTEXTURELAYERPROC glFramebufferTextureLayer;
-            PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
-            PFNGLFLUSHMAPPEDBUFFERRANGEPROC glFlushMappedBufferRange;
-            PFNGLBINDVERTEXARRAYPROC glBindVertexArray;
-            PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays;
-            PFNGLGENVERTEXARRAYSPROC glGenVertexArrays;
-            PFNGLISVERTEXARRAYPROC glIsVertexArray;
-            //  31
-            PFNGLDRAWARRAYSINSTANCEDPROC glDrawArraysInstanced;
-            PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced;
-            PFNGLTEXBUFFERPROC glTexBuffer;
-            PFNGLPRIMITIVERESTARTINDEXPROC glPrimitiveRestartIndex;
-            PFNGLCOPYBUFFERSUBDATAPROC glCopyBufferSubData;
-            PFNGLGETUNIFORMINDICESPROC glGetUniformIndices;
-            PFNGLGETACTIVEUNIFORMSIVPROC glGetActiveUniformsiv;
-            PFNGLGETACTIVEUNIFORMNAMEPROC glGetActiveUniformName;
-            PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndex;
-            PFNGLGETACTIVEUNIFORMBLOCKIVPROC glGetActiveUniformBlockiv;
-            PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC glGetActiveUniformBlockName;
-            PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding;
-            //  32
-            PFNGLDRAWELEMENTSBASEVERTEXPROC glDrawElementsBaseVertex;
-            PFNGLDRAWRANGEELEMENTSBASEVERTEXPROC glDrawRangeElementsBaseVertex;
-            PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC glDrawElementsInstancedBaseVertex;
-            PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC glMultiDrawElementsBaseVertex;
-            PFNGLPROVOKINGVERTEXPROC glProvokingVertex;
-            PFNGLFENCESYNCPROC glFenceSync;
-            PFNGLISSYNCPROC glIsSync;
-            PFNGLDELETESYNCPROC glDeleteSync;
-            PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
-            PFNGLWAITSYNCPROC glWaitSync;
-            PFNGLGETINTEGER64VPROC glGetInteger64v;
-            PFNGLGETSYNCIVPROC glGetSynciv;
-            PFNGLGETINTEGER64I_VPROC glGetInteger64i_v;
-            PFNGLGETBUFFERPARAMETERI64VPROC glGetBufferParameteri64v;
-            PFNGLFRAMEBUFFERTEXTUREPROC glFramebufferTexture;
-            PFNGLTEXIMAGE2DMULTISAMPLEPROC glTexImage2DMultisample;
-            PFNGLTEXIMAGE3DMULTISAMPLEPROC glTexImage3DMultisample;
-            PFNGLGETMULTISAMPLEFVPROC glGetMultisamplefv;
-            PFNGLSAMPLEMASKIPROC glSampleMaski;
-            //  33
-            PFNGLBINDFRAGDATALOCATIONINDEXEDPROC glBindFragDataLocationIndexed;
-            PFNGLGETFRAGDATAINDEXPROC glGetFragDataIndex;
-            PFNGLGENSAMPLERSPROC glGenSamplers;
-            PFNGLDELETESAMPLERSPROC glDeleteSamplers;
-            PFNGLISSAMPLERPROC glIsSampler;
-            PFNGLBINDSAMPLERPROC glBindSampler;
-            PFNGLSAMPLERPARAMETERIPROC glSamplerParameteri;
-            PFNGLSAMPLERPARAMETERIVPROC glSamplerParameteriv;
-            PFNGLSAMPLERPARAMETERFPROC glSamplerParameterf;
-            PFNGLSAMPLERPARAMETERFVPROC glSamplerParameterfv;
-            PFNGLSAMPLERPARAMETERIIVPROC glSamplerParameterIiv;
-            PFNGLSAMPLERPARAMETERIUIVPROC glSamplerParameterIuiv;
-            PFNGLGETSAMPLERPARAMETERIVPROC glGetSamplerParameteriv;
-            PFNGLGETSAMPLERPARAMETERIIVPROC glGetSamplerParameterIiv;
-            PFNGLGETSAMPLERPARAMETERFVPROC glGetSamplerParameterfv;
-            PFNGLGETSAMPLERPARAMETERIUIVPROC glGetSamplerParameterIuiv;
-            PFNGLQUERYCOUNTERPROC glQueryCounter;
-            PFNGLGETQUERYOBJECTI64VPROC glGetQueryObjecti64v;
-            PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
-            PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor;
-            PFNGLVERTEXATTRIBP1UIPROC glVertexAttribP1ui;
-            PFNGLVERTEXATTRIBP1UIVPROC glVertexAttribP1uiv;
-            PFNGLVERTEXATTRIBP2UIPROC glVertexAttribP2ui;
-            PFNGLVERTEXATTRIBP2UIVPROC glVertexAttribP2uiv;
-            PFNGLVERTEXATTRIBP3UIPROC glVertexAttribP3ui;
-            PFNGLVERTEXATTRIBP3UIVPROC glVertexAttribP3uiv;
-            PFNGLVERTEXATTRIBP4UIPROC glVertexAttribP4ui;
-            PFNGLVERTEXATTRIBP4UIVPROC glVertexAttribP4uiv;
+            OPENGL_FUNCTIONS(OPENGL_DECLARE_FUNCTION)
+            // Optional functions go last
+            OPENGL_OPTIONAL_FUNCTIONS(OPENGL_DECLARE_FUNCTION)
         } fn;
         void* raw[sizeof(Functions::_Functions) / sizeof(void*)];
     } functions;
 
     static const uint32_t FunctionCount = sizeof(Functions::_Functions) / sizeof(void*);
+    // Functions after these ones don't fail the loading if missing
+    static const uint32_t RequiredFunctionCount = 0 OPENGL_FUNCTIONS(OPENGL_COUNT_FUNCTION);
+
+    // NOTE: Set by the platform if an extension and all of its functions are available
+    struct Extensions {
+        b32 getProgramBinary;
+        b32 parallelShaderCompile;
+    } extensions;
 
     static const inline  char* FunctionNames[] =
     {
-        "glCullFace",
-        "glFrontFace",
-        "glHint",
-        "glLineWidth",
-        "glPointSize",
-        "glPolygonMode",
-        "glScissor",
-        "glTexParameterf",
-        "glTexParameterfv",
-        "glTexParameteri",
-        "glTexParameteriv",
-        "glTexImage1D",
-        "glTexImage2D",
-        "glDrawBuffer",
-        "glClear",
-        "glClearColor",
-        "glClearStencil",
-        "glClearDepth",
-        "glStencilMask",
-        "glColorMask",
-        "glDepthMask",
-        "glDisable",
-        "glEnable",
-        "glFinish",
-        "glFlush",
-        "glBlendFunc",
-        "glLogicOp",
-        "glStencilFunc",
-        "glStencilOp",
-        "glDepthFunc",
-        "glPixelStoref",
-        "glPixelStorei",
-        "glReadBuffer",
-        "glReadPixels",
-        "glGetBooleanv",
-        "glGetDoublev",
-        "glGetError",
-        "glGetFloatv",
-        "glGetIntegerv",
-        "glGetString",
-        "glGetTexImage",
-        "glGetTexParameterfv",
-        "glGetTexParameteriv",
-        "glGetTexLevelParameterfv",
-        "glGetTexLevelParameteriv",
-        "glIsEnabled",
-        "glDepthRange",
-        "glViewport",
-        //  11
-        "glDrawArrays",
-        "glDrawElements",
-        "glGetPointerv",
-        "glPolygonOffset",
-        "glCopyTexImage1D",
-        "glCopyTexImage2D",
-        "glCopyTexSubImage1D",
-        "glCopyTexSubImage2D",
-        "glTexSubImage1D",
-        "glTexSubImage2D",
-        "glBindTexture",
-        "glDeleteTextures",
-        "glGenTextures",
-        "glIsTexture",
-        //  12
-        "glDrawRangeElements",
-        "glTexImage3D",
-        "glTexSubImage3D",
-        "glCopyTexSubImage3D",
-        //  13
-        "glActiveTexture",
-        "glSampleCoverage",
-        "glCompressedTexImage3D",
-        "glCompressedTexImage2D",
-        "glCompressedTexImage1D",
-        "glCompressedTexSubImage3D",
-        "glCompressedTexSubImage2D",
-        "glCompressedTexSubImage1D",
-        "glGetCompressedTexImage",
-        //  14
-        "glBlendFuncSeparate",
-        "glMultiDrawArrays",
-        "glMultiDrawElements",
-        "glPointParameterf",
-        "glPointParameterfv",
-        "glPointParameteri",
-        "glPointParameteriv",
-        "glBlendColor",
-        "glBlendEquation",
-        // 15
-        "glGenQueries",
-        "glDeleteQueries",
-        "glIsQuery",
-        "glBeginQuery",
-        "glEndQuery",
-        "glGetQueryiv",
-        "glGetQueryObjectiv",
-        "glGetQueryObjectuiv",
-        "glBindBuffer",
-        "glDeleteBuffers",
-        "glGenBuffers",
-        "glIsBuffer",
-        "glBufferData",
-        "glBufferSubData",
-        "glGetBufferSubData",
-        "glMapBuffer",
-        "glUnmapBuffer",
-        "glGetBufferParameteriv",
-        "glGetBufferPointerv",
-        //  20
-        "glBlendEquationSeparate",
-        "glDrawBuffers",
-        "glStencilOpSeparate",
-        "glStencilFuncSeparate",
-        "glStencilMaskSeparate",
-        "glAttachShader",
-        "glBindAttribLocation",
-        "glCompileShader",
-        "glCreateProgram",
-        "glCreateShader",
-        "glDeleteProgram",
-        "glDeleteShader",
-        "glDetachShader",
-        "glDisableVertexAttribArray",
-        "glEnableVertexAttribArray",
-        "glGetActiveAttrib",
-        "glGetActiveUniform",
-        "glGetAttachedShaders",
-        "glGetAttribLocation",
-        "glGetProgramiv",
-        "glGetProgramInfoLog",
-        "glGetShaderiv",
-        "glGetShaderInfoLog",
-        "glGetShaderSource",
-        "glGetUniformLocation",
-        "glGetUniformfv",
-        "glGetUniformiv",
-        "glGetVertexAttribdv",
-        "glGetVertexAttribfv",
-        "glGetVertexAttribiv",
-        "glGetVertexAttribPointerv",
-        "glIsProgram",
-        "glIsShader",
-        "glLinkProgram",
-        "glShaderSource",
-        "glUseProgram",
-        "glUniform1f",
-        "glUniform2f",
-        "glUniform3f",
-        "glUniform4f",
-        "glUniform1i",
-        "glUniform2i",
-        "glUniform3i",
-        "glUniform4i",
-        "glUniform1fv",
-        "glUniform2fv",
-        "glUniform3fv",
-        "glUniform4fv",
-        "glUniform1iv",
-        "glUniform2iv",
-        "glUniform3iv",
-        "glUniform4iv",
-        "glUniformMatrix2fv",
-        "glUniformMatrix3fv",
-        "glUniformMatrix4fv",
-        "glValidateProgram",
-        "glVertexAttrib1d",
-        "glVertexAttrib1dv",
-        "glVertexAttrib1f",
-        "glVertexAttrib1fv",
-        "glVertexAttrib1s",
-        "glVertexAttrib1sv",
-        "glVertexAttrib2d",
-        "glVertexAttrib2dv",
-        "glVertexAttrib2f",
-        "glVertexAttrib2fv",
-        "glVertexAttrib2s",
-        "glVertexAttrib2sv",
-        "glVertexAttrib3d",
-        "glVertexAttrib3dv",
-        "glVertexAttrib3f",
-        "glVertexAttrib3fv",
-        "glVertexAttrib3s",
-        "glVertexAttrib3sv",
-        "glVertexAttrib4Nbv",
-        "glVertexAttrib4Niv",
-        "glVertexAttrib4Nsv",
-        "glVertexAttrib4Nub",
-        "glVertexAttrib4Nubv",
-        "glVertexAttrib4Nuiv",
-        "glVertexAttrib4Nusv",
-        "glVertexAttrib4bv",
-        "glVertexAttrib4d",
-        "glVertexAttrib4dv",
-        "glVertexAttrib4f",
-        "glVertexAttrib4fv",
-        "glVertexAttrib4iv",
-        "glVertexAttrib4s",
-        "glVertexAttrib4sv",
-        "glVertexAttrib4ubv",
-        "glVertexAttrib4uiv",
-        "glVertexAttrib4usv",
-        "glVertexAttribPointer",
-        //  21
-        "glUniformMatrix2x3fv",
-        "glUniformMatrix3x2fv",
-        "glUniformMatrix2x4fv",
-        "glUniformMatrix4x2fv",
-        "glUniformMatrix3x4fv",
-        "glUniformMatrix4x3fv",
-        //  30
-        "glColorMaski",
-        "glGetBooleani_v",
-        "glGetIntegeri_v",
-        "glEnablei",
-        "glDisablei",
-        "glIsEnabledi",
-        "glBeginTransformFeedback",
-        "glEndTransformFeedback",
-        "glBindBufferRange",
-        "glBindBufferBase",
-        "glTransformFeedbackVaryings",
-        "glGetTransformFeedbackVarying",
-        "glClampColor",
-        "glBeginConditionalRender",
-        "glEndConditionalRender",
-        "glVertexAttribIPointer",
-        "glGetVertexAttribIiv",
-        "glGetVertexAttribIuiv",
-        "glVertexAttribI1i",
-        "glVertexAttribI2i",
-        "glVertexAttribI3i",
-        "glVertexAttribI4i",
-        "glVertexAttribI1ui",
-        "glVertexAttribI2ui",
-        "glVertexAttribI3ui",
-        "glVertexAttribI4ui",
-        "glVertexAttribI1iv",
-        "glVertexAttribI2iv",
-        "glVertexAttribI3iv",
-        "glVertexAttribI4iv",
-        "glVertexAttribI1uiv",
-        "glVertexAttribI2uiv",
-        "glVertexAttribI3uiv",
-        "glVertexAttribI4uiv",
-        "glVertexAttribI4bv",
-        "glVertexAttribI4sv",
-        "glVertexAttribI4ubv",
-        "glVertexAttribI4usv",
-        "glGetUniformuiv",
-        "glBindFragDataLocation",
-        "glGetFragDataLocation",
-        "glUniform1ui",
-        "glUniform2ui",
-        "glUniform3ui",
-        "glUniform4ui",
-        "glUniform1uiv",
-        "glUniform2uiv",
-        "glUniform3uiv",
-        "glUniform4uiv",
-        "glTexParameterIiv",
-        "glTexParameterIuiv",
-        "glGetTexParameterIiv",
-        "glGetTexParameterIuiv",
-        "glClearBufferiv",
-        "glClearBufferuiv",
-        "glClearBufferfv",
-        "glClearBufferfi",
-        "glGetStringi",
-        "glIsRenderbuffer",
-        "glBindRenderbuffer",
-        "glDeleteRenderbuffers",
-        "glGenRenderbuffers",
-        "glRenderbufferStorage",
-        "glGetRenderbufferParameteriv",
-        "glIsFramebuffer",
-        "glBindFramebuffer",
-        "glDeleteFramebuffers",
-        "glGenFramebuffers",
-        "glCheckFramebufferStatus",
-        "glFramebufferTexture1D",
-        "glFramebufferTexture2D",
-        "glFramebufferTexture3D",
-        "glFramebufferRenderbuffer",
-        "glGetFramebufferAttachmentParameteriv",
-        "glGenerateMipmap",
-        "glBlitFramebuffer",
-        "glRenderbufferStorageMultisample",
-        "glFramebufferTextureLayer",
-        "glMapBufferRange",
-        "glFlushMappedBufferRange",
-        "glBindVertexArray",
-        "glDeleteVertexArrays",
-        "glGenVertexArrays",
-        "glIsVertexArray",
-        //  31
-        "glDrawArraysInstanced",
-        "glDrawElementsInstanced",
-        "glTexBuffer",
-        "glPrimitiveRestartIndex",
-        "glCopyBufferSubData",
-        "glGetUniformIndices",
-        "glGetActiveUniformsiv",
-        "glGetActiveUniformName",
-        "glGetUniformBlockIndex",
-        "glGetActiveUniformBlockiv",
-        "glGetActiveUniformBlockName",
-        "glUniformBlockBinding",
-        //  32
-        "glDrawElementsBaseVertex",
-        "glDrawRangeElementsBaseVertex",
-        "glDrawElementsInstancedBaseVertex",
-        "glMultiDrawElementsBaseVertex",
-        "glProvokingVertex",
-        "glFenceSync",
-        "glIsSync",
-        "glDeleteSync",
-        "glClientWaitSync",
-        "glWaitSync",
-        "glGetInteger64v",
-        "glGetSynciv",
-        "glGetInteger64i_v",
-        "glGetBufferParameteri64v",
-        "glFramebufferTexture",
-        "glTexImage2DMultisample",
-        "glTexImage3DMultisample",
-        "glGetMultisamplefv",
-        "glSampleMaski",
-        //  33
-        "glBindFragDataLocationIndexed",
-        "glGetFragDataIndex",
-        "glGenSamplers",
-        "glDeleteSamplers",
-        "glIsSampler",
-        "glBindSampler",
-        "glSamplerParameteri",
-        "glSamplerParameteriv",
-        "glSamplerParameterf",
-        "glSamplerParameterfv",
-        "glSamplerParameterIiv",
-        "glSamplerParameterIuiv",
-        "glGetSamplerParameteriv",
-        "glGetSamplerParameterIiv",
-        "glGetSamplerParameterfv",
-        "glGetSamplerParameterIuiv",
-        "glQueryCounter",
-        "glGetQueryObjecti64v",
-        "glGetQueryObjectui64v",
-        "glVertexAttribDivisor",
-        "glVertexAttribP1ui",
-        "glVertexAttribP1uiv",
-        "glVertexAttribP2ui",
-        "glVertexAttribP2uiv",
-        "glVertexAttribP3ui",
-        "glVertexAttribP3uiv",
-        "glVertexAttribP4ui",
-        "glVertexAttribP4uiv",
+        OPENGL_FUNCTIONS(OPENGL_FUNCTION_NAME)
+        OPENGL_OPTIONAL_FUNCTIONS(OPENGL_FUNCTION_NAME)
     };
 };
+
+// Position of the function in the table
+#define OPENGL_FUNCTION_INDEX(name) (u32)(offsetof(OpenGL::Functions::_Functions, name) / sizeof(void*))
+
+// NOTE: Calls made through the function table during the last complete frame. Collected by the platform if
+// statistics are enabled. Cycles are counted on the CPU around the call, so they are the driver time, not the GPU one
+struct OpenGLFrameStats {
+    u32 callCount;
+    u32 drawCount;
+    // Binds, capabilities, blending, depth, viewport and the like
+    u32 stateChangeCount;
+    u32 uniformCount;
+    u64 cycleCount;
+    // Measured over the frame. Converts cycles to seconds
+    f64 cyclesPerSecond;
+    u32 calls[OpenGL::FunctionCount];
+    u64 cycles[OpenGL::FunctionCount];
+};
+
+#undef OPENGL_DECLARE_FUNCTION
+#undef OPENGL_COUNT_FUNCTION
+#undef OPENGL_FUNCTION_NAME
@@ -0,0 +1,87 @@
+#pragma once
+
+// NOTE: Generated by gen_opengl_used.sh. Do not edit
+// OpenGL functions referenced by the code. They are resolved at startup, the rest are resolved on the first call
+#define OPENGL_USED_FUNCTIONS(X) \
+    X(glActiveTexture) \
+    X(glAttachShader) \
+    X(glBeginQuery) \
+    X(glBindBuffer) \
+    X(glBindBufferBase) \
+    X(glBindFramebuffer) \
+    X(glBindRenderbuffer) \
+    X(glBindTexture) \
+    X(glBindVertexArray) \
+    X(glBlendFunc) \
+    X(glBlendFuncSeparate) \
+    X(glBufferData) \
+    X(glBufferSubData) \
+    X(glCheckFramebufferStatus) \
+    X(glClear) \
+    X(glClearColor) \
+    X(glClearDepth) \
+    X(glClientWaitSync) \
+    X(glCompileShader) \
+    X(glCreateProgram) \
+    X(glCreateShader) \
+    X(glCullFace) \
+    X(glDeleteBuffers) \
+    X(glDeleteProgram) \
+    X(glDeleteQueries) \
+    X(glDeleteShader) \
+    X(glDeleteSync) \
+    X(glDepthFunc) \
+    X(glDisable) \
+    X(glDisableVertexAttribArray) \
+    X(glDrawArrays) \
+    X(glDrawArraysInstanced) \
+    X(glDrawElements) \
+    X(glEnable) \
+    X(glEnableVertexAttribArray) \
+    X(glEndQuery) \
+    X(glFenceSync) \
+    X(glFinish) \
+    X(glFramebufferRenderbuffer) \
+    X(glFramebufferTexture2D) \
+    X(glFrontFace) \
+    X(glGenBuffers) \
+    X(glGenFramebuffers) \
+    X(glGenQueries) \
+    X(glGenRenderbuffers) \
+    X(glGenTextures) \
+    X(glGenVertexArrays) \
+    X(glGetBufferParameteriv) \
+    X(glGetIntegerv) \
+    X(glGetProgramBinary) \
+    X(glGetProgramInfoLog) \
+    X(glGetProgramiv) \
+    X(glGetQueryObjectui64v) \
+    X(glGetShaderInfoLog) \
+    X(glGetShaderiv) \
+    X(glGetString) \
+    X(glGetUniformBlockIndex) \
+    X(glGetUniformLocation) \
+    X(glLinkProgram) \
+    X(glMapBuffer) \
+    X(glMapBufferRange) \
+    X(glMaxShaderCompilerThreadsKHR) \
+    X(glProgramBinary) \
+    X(glProgramParameteri) \
+    X(glRenderbufferStorage) \
+    X(glShaderSource) \
+    X(glTexImage2D) \
+    X(glTexImage3D) \
+    X(glTexParameteri) \
+    X(glTexSubImage2D) \
+    X(glTexSubImage3D) \
+    X(glUniform1f) \
+    X(glUniform1i) \
+    X(glUniformBlockBinding) \
+    X(glUniformMatrix4fv) \
+    X(glUnmapBuffer) \
+    X(glUseProgram) \
+    X(glVertexAttribDivisor) \
+    X(glVertexAttribIPointer) \
+    X(glVertexAttribPointer) \
+    X(glViewport) \
+
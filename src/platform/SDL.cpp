@@ -9,30 +9,98 @@ typedef void (APIENTRYP PFNGLDEBUGMESSAGECALLBACKPROC) (GLDEBUGPROC callback, co
 typedef void (APIENTRYP PFNGLDEBUGMESSAGECONTROLPROC) (GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled);
 void OpenglDebugCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const GLvoid* userParam);
 
-OpenGLLoadResult SDLLoadOpenGL() {
-    OpenGL* context = (OpenGL*)malloc(sizeof(OpenGL));
-    if (!context) {
-        panic("Failed to allocate memory for OpenGL function table");
+// NOTE: The function table lives in static storage, so the statically linked game can reach it without going through PlatformState
+static OpenGL SDLGlobalOpenGL;
+
+void* SDLResolveOpenGLFunction(u32 index) {
+    void* function = SDL_GL_GetProcAddress(OpenGL::FunctionNames[index]);
+    if (!function) {
+        panic("[OpenGL] Failed to load function: %s", OpenGL::FunctionNames[index]);
     }
+    // NOTE(swarzzy): Several threads may resolve the same function at once, they all write the same pointer
+    SDLGlobalOpenGL.functions.raw[index] = function;
+    log_print("[OpenGL] Function %s was resolved on the first call. Run gen_opengl_used.sh to load it at startup\n", OpenGL::FunctionNames[index]);
+    return function;
+}
+
+// NOTE: Initial value of functions which are not resolved at startup. Resolves the function, replaces itself in the table and forwards the call
+template<u32 Index, typename Fn>
+struct OpenGLTrampoline;
+
+template<u32 Index, typename R, typename... Args>
+struct OpenGLTrampoline<Index, R (APIENTRYP)(Args...)> {
+    static R APIENTRY Call(Args... args) {
+        auto function = (R (APIENTRYP)(Args...))SDLResolveOpenGLFunction(Index);
+        return function(args...);
+    }
+};
+
+// NOTE: Resolves the functions which are still bound to trampolines. Has to be done before entries of the table
+// are wrapped, otherwise the trampoline would overwrite the wrapper on the first call
+void SDLResolveAllOpenGLFunctions(OpenGL* gl) {
+#define OPENGL_RESOLVE_TRAMPOLINE(type, name) \
+    if (gl->functions.fn.name == OpenGLTrampoline<OPENGL_FUNCTION_INDEX(name), type>::Call) { \
+        void* function = SDL_GL_GetProcAddress(#name); \
+        if (function) { gl->functions.raw[OPENGL_FUNCTION_INDEX(name)] = function; } \
+    }
+    OPENGL_FUNCTIONS(OPENGL_RESOLVE_TRAMPOLINE)
+#undef OPENGL_RESOLVE_TRAMPOLINE
+}
+
+OpenGLLoadResult SDLLoadOpenGL() {
+    u64 startTime = SDL_GetPerformanceCounter();
+
+    OpenGL* context = &SDLGlobalOpenGL;
 
     log_print("[OpenGL] Loading functions...\n");
     log_print("[OpenGL] Functions defined: %d\n", (int)OpenGL::FunctionCount);
 
-    b32 success = true;
-    for (u32 i = 0; i < OpenGL::FunctionCount; i++) {
+#define OPENGL_SET_TRAMPOLINE(type, name) context->functions.fn.name = OpenGLTrampoline<OPENGL_FUNCTION_INDEX(name), type>::Call;
+    OPENGL_FUNCTIONS(OPENGL_SET_TRAMPOLINE)
+#undef OPENGL_SET_TRAMPOLINE
 
-        // NOTE(swarzzy): SDL_GL_GetProcAddress by itself tries to load a functions
-        // using wglGetProcAddress or GetProcAddress if the first fails
+    // NOTE(swarzzy): SDL_GL_GetProcAddress by itself tries to load a functions
+    // using wglGetProcAddress or GetProcAddress if the first fails
+    static const u32 UsedFunctions[] = {
+#define OPENGL_USED_FUNCTION_INDEX(name) OPENGL_FUNCTION_INDEX(name),
+        OPENGL_USED_FUNCTIONS(OPENGL_USED_FUNCTION_INDEX)
+#undef OPENGL_USED_FUNCTION_INDEX
+    };
 
-        context->functions.raw[i] = SDL_GL_GetProcAddress(OpenGL::FunctionNames[i]);
-        if (!context->functions.raw[i]) {
-            log_print("[OpenGL]: Failed to load function: %s\n", OpenGL::FunctionNames[i]);
-            success = false;
+    b32 success = true;
+    u32 functionsLoaded = 0;
+    for (u32 i = 0; i < array_count(UsedFunctions); i++) {
+        u32 index = UsedFunctions[i];
+        // NOTE(swarzzy): Optional functions are loaded below
+        if (index < OpenGL::RequiredFunctionCount) {
+            context->functions.raw[index] = SDL_GL_GetProcAddress(OpenGL::FunctionNames[index]);
+            functionsLoaded++;
+            if (!context->functions.raw[index]) {
+                log_print("[OpenGL]: Failed to load function: %s\n", OpenGL::FunctionNames[index]);
+                success = false;
+            }
         }
     }
 
+    // NOTE(swarzzy): Optional functions are never lazy. Null is how their absence is detected
+    for (u32 i = OpenGL::RequiredFunctionCount; i < OpenGL::FunctionCount; i++) {
+        context->functions.raw[i] = SDL_GL_GetProcAddress(OpenGL::FunctionNames[i]);
+        functionsLoaded++;
+    }
+
+    // NOTE(swarzzy): Extension functions may be exported even if the extension is not supported, so both are checked
+    context->extensions = {};
+    context->extensions.getProgramBinary = SDL_GL_ExtensionSupported("GL_ARB_get_program_binary") &&
+        context->functions.fn.glGetProgramBinary && context->functions.fn.glProgramBinary && context->functions.fn.glProgramParameteri;
+    context->extensions.parallelShaderCompile = SDL_GL_ExtensionSupported("GL_KHR_parallel_shader_compile") &&
+        context->functions.fn.glMaxShaderCompilerThreadsKHR;
+    log_print("[OpenGL] Program binaries: %s, parallel shader compile: %s\n",
+              context->extensions.getProgramBinary ? "yes" : "no", context->extensions.parallelShaderCompile ? "yes" : "no");
+
+    f64 loadTime = (f64)(SDL_GetPerformanceCounter() - startTime) / (f64)SDL_GetPerformanceFrequency();
     if (success) {
-        log_print("[OpenGL] Done\n");
+        log_print("[OpenGL] Done in %.3f ms. %u functions loaded, %u left to load on the first call\n",
+                  loadTime * 1000.0, functionsLoaded, OpenGL::FunctionCount - functionsLoaded);
     } else {
         log_print("[OpenGL] Failed to load some of OpenGL functions\n");
     }
@@ -41,7 +109,7 @@ OpenGLLoadResult SDLLoadOpenGL() {
         PFNGLDEBUGMESSAGECALLBACKPROC glDebugMessageCallbackARB = (PFNGLDEBUGMESSAGECALLBACKPROC)SDL_GL_GetProcAddress("glDebugMessageCallbackARB");
         PFNGLDEBUGMESSAGECONTROLPROC glDebugMessageControlARB = (PFNGLDEBUGMESSAGECONTROLPROC)SDL_GL_GetProcAddress("glDebugMessageControlARB");
         if (glDebugMessageCallbackARB && glDebugMessageControlARB) {
-            glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
+            context->functions.fn.glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
             glDebugMessageControlARB(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION_ARB, 0, 0, GL_FALSE);
             glDebugMessageControlARB(GL_DONT_CARE, GL_DEBUG_TYPE_OTHER, GL_DEBUG_SEVERITY_LOW_ARB, 0, 0, GL_FALSE);
             glDebugMessageCallbackARB(OpenglDebugCallback, 0);
@@ -203,21 +271,194 @@ void SDLInit(SDLContext* context, const PlatformState* platform, i32 glMajorVers
     auto windowFlags = SDL_WINDOW_RESIZABLE | SDL_WINDOW_OPENGL;
     context->window = SDL_CreateWindow("Ping pong", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, platform->windowWidth, platform->windowHeight, windowFlags);
     if (!context->window) {
-        panic("[SDL] Failed to create window: %s", SDL_GetError());
+        // NOTE(swarzzy): No GL capable visual. The window still works for the software renderer
+        log_print("[SDL] Warning! Failed to create OpenGL window: %s\n", SDL_GetError());
+        context->window = SDL_CreateWindow("Ping pong", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, platform->windowWidth, platform->windowHeight, SDL_WINDOW_RESIZABLE);
+        if (!context->window) {
+            panic("[SDL] Failed to create window: %s", SDL_GetError());
+        }
+        return;
     }
 
     context->glContext = SDL_GL_CreateContext(context->window);
     if (!context->glContext) {
-        panic("[SDL] Failed to initialize OpenGL context-> %s", SDL_GetError());
+        // NOTE(swarzzy): Callers check glContext and fall back to the software renderer
+        log_print("[SDL] Warning! Failed to initialize OpenGL context: %s\n", SDL_GetError());
+        return;
     }
 
     if (SDL_GL_SetSwapInterval(1) != 0) {
         log_print("[SDL] Warning! V-sync is not supported\n");
     }
+
+    // NOTE(swarzzy): Creating a context makes it current, so the main one is restored afterwards
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+    context->glWorkerWindow = SDL_CreateWindow("GL worker", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 1, 1, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+    if (context->glWorkerWindow) {
+        context->glWorkerContext = SDL_GL_CreateContext(context->glWorkerWindow);
+    }
+    if (!context->glWorkerContext) {
+        log_print("[SDL] Warning! Failed to create shared OpenGL context: %s\n", SDL_GetError());
+    }
+    SDL_GL_MakeCurrent(context->window, context->glContext);
 }
 
 void SDLSwapBuffers(SDLContext* context) {
     SDL_GL_SwapWindow(context->window);
+    GLCaptureEndFrame();
+    GLStatsEndFrame();
+}
+
+void SDLPresentSoftwareFrame(SDLContext* context, const u32* pixels, u32 width, u32 height) {
+    // NOTE(swarzzy): The surface is recreated by SDL when the window is resized, so it is queried every frame
+    context->surface = SDL_GetWindowSurface(context->window);
+    SDL_Surface* surface = context->surface;
+    if (!surface) {
+        log_print("[SDL] Failed to get window surface: %s\n", SDL_GetError());
+        return;
+    }
+
+    if (SDL_MUSTLOCK(surface)) {
+        SDL_LockSurface(surface);
+    }
+
+    u32 copyWidth = Min(width, (u32)surface->w);
+    u32 copyHeight = Min(height, (u32)surface->h);
+    // NOTE(swarzzy): Rows of the frame go from the bottom of the window and the surface ones go from the top
+    for (u32 y = 0; y < copyHeight; y++) {
+        const u32* sourceRow = pixels + (uptr)(height - 1 - y) * width;
+        u8* destRow = (u8*)surface->pixels + (uptr)y * surface->pitch;
+        SDL_ConvertPixels(copyWidth, 1, SDL_PIXELFORMAT_RGBA32, sourceRow, width * sizeof(u32), surface->format->format, destRow, surface->pitch);
+    }
+
+    if (SDL_MUSTLOCK(surface)) {
+        SDL_UnlockSurface(surface);
+    }
+
+    SDL_UpdateWindowSurface(context->window);
+}
+
+// Returns true if there is nothing to do and the thread can go to sleep
+b32 SDLDoNextWorkEntry(SDLWorkQueue* queue, u32 threadIndex) {
+    b32 shouldSleep = false;
+    i32 entryToRead = SDL_AtomicGet(&queue->nextEntryToRead);
+    i32 newEntryToRead = (entryToRead + 1) % SDLWorkQueue::Capacity;
+    if (entryToRead != SDL_AtomicGet(&queue->nextEntryToWrite)) {
+        if (SDL_AtomicCAS(&queue->nextEntryToRead, entryToRead, newEntryToRead)) {
+            SDLWorkEntry entry = queue->entries[entryToRead];
+            entry.fn(entry.data, threadIndex);
+            SDL_AtomicIncRef(&queue->completionCount);
+        }
+    } else {
+        shouldSleep = true;
+    }
+    return shouldSleep;
+}
+
+int SDLWorkerThreadProc(void* data) {
+    auto info = (SDLWorkerInfo*)data;
+    while (true) {
+        if (SDLDoNextWorkEntry(info->queue, info->threadIndex)) {
+            SDL_SemWait(info->queue->semaphore);
+        }
+    }
+    return 0;
+}
+
+int SDLGLWorkerThreadProc(void* data) {
+    auto context = (SDLContext*)data;
+    if (SDL_GL_MakeCurrent(context->glWorkerWindow, context->glWorkerContext) != 0) {
+        panic("[SDL] Failed to make shared OpenGL context current: %s", SDL_GetError());
+    }
+    while (true) {
+        if (SDLDoNextWorkEntry(&context->glWorkQueue, context->glWorkerThreadIndex)) {
+            SDL_SemWait(context->glWorkQueue.semaphore);
+        }
+    }
+    return 0;
+}
+
+b32 SDLInitGLWorker(SDLContext* context) {
+    // NOTE(swarzzy): Jobs of the main work queue may be running while the GL worker runs its job
+    context->glWorkerThreadIndex = context->workQueue.threadCount;
+    if (!context->glWorkerContext) {
+        return false;
+    }
+
+    SDLWorkQueue* queue = &context->glWorkQueue;
+    queue->threadCount = 1;
+    // NOTE(swarzzy): GL jobs need the shared context which is current only on the worker
+    queue->workersOnly = true;
+    queue->semaphore = SDL_CreateSemaphore(0);
+    if (!queue->semaphore) {
+        panic("[SDL] Failed to create semaphore: %s", SDL_GetError());
+    }
+
+    SDL_Thread* thread = SDL_CreateThread(SDLGLWorkerThreadProc, "GL worker", context);
+    if (!thread) {
+        panic("[SDL] Failed to create GL worker thread: %s", SDL_GetError());
+    }
+    SDL_DetachThread(thread);
+    return true;
+}
+
+u32 SDLInitWorkQueue(SDLContext* context) {
+    SDLWorkQueue* queue = &context->workQueue;
+
+    i32 cpuCount = SDL_GetCPUCount();
+    queue->threadCount = (u32)Clamp(cpuCount, 1, (i32)SDLWorkQueue::MaxThreadCount);
+    queue->semaphore = SDL_CreateSemaphore(0);
+    if (!queue->semaphore) {
+        panic("[SDL] Failed to create semaphore: %s", SDL_GetError());
+    }
+
+    // NOTE(swarzzy): Thread 0 is the main thread
+    for (u32 i = 1; i < queue->threadCount; i++) {
+        SDLWorkerInfo* info = context->workers + i;
+        info->queue = queue;
+        info->threadIndex = i;
+        SDL_Thread* thread = SDL_CreateThread(SDLWorkerThreadProc, "Worker", info);
+        if (!thread) {
+            panic("[SDL] Failed to create worker thread: %s", SDL_GetError());
+        }
+        SDL_DetachThread(thread);
+    }
+
+    log_print("[Platform] Work queue threads: %d\n", (int)queue->threadCount);
+    return queue->threadCount;
+}
+
+void SDLPushWork(SDLWorkQueue* queue, WorkFn* fn, void* data) {
+    i32 entryToWrite = SDL_AtomicGet(&queue->nextEntryToWrite);
+    i32 newEntryToWrite = (entryToWrite + 1) % SDLWorkQueue::Capacity;
+    // NOTE(swarzzy): Queue is full. Help the workers instead of overwriting entries
+    while (newEntryToWrite == SDL_AtomicGet(&queue->nextEntryToRead)) {
+        if (queue->workersOnly) {
+            SDL_Delay(0);
+        } else {
+            SDLDoNextWorkEntry(queue, 0);
+        }
+    }
+    queue->entries[entryToWrite].fn = fn;
+    queue->entries[entryToWrite].data = data;
+    SDL_AtomicIncRef(&queue->completionGoal);
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&queue->nextEntryToWrite, newEntryToWrite);
+    SDL_SemPost(queue->semaphore);
+}
+
+void SDLCompleteAllWork(SDLWorkQueue* queue) {
+    while (SDL_AtomicGet(&queue->completionGoal) != SDL_AtomicGet(&queue->completionCount)) {
+        SDLDoNextWorkEntry(queue, 0);
+    }
+    SDL_AtomicSet(&queue->completionGoal, 0);
+    SDL_AtomicSet(&queue->completionCount, 0);
+}
+
+void SDLWaitForAllWork(SDLWorkQueue* queue) {
+    while (SDL_AtomicGet(&queue->completionGoal) != SDL_AtomicGet(&queue->completionCount)) {
+        SDL_Delay(1);
+    }
 }
 
 Key SDLKeycodeConvert(i32 sdlKeycode) {
@@ -7,10 +7,40 @@
 #include <SDL.h>
 
 #include "OpenGL.h"
+#include "OpenGLUsed.h"
 
 #include <SDL_opengl.h>
 #include <SDL_keycode.h>
 
+#include "GLCapture.h"
+#include "GLStats.h"
+
+struct SDLWorkEntry {
+    WorkFn* fn;
+    void* data;
+};
+
+// NOTE: Single producer (main thread) multiple consumer job queue
+struct SDLWorkQueue {
+    static const u32 Capacity = 256;
+    static const u32 MaxThreadCount = 16;
+
+    SDL_atomic_t completionGoal;
+    SDL_atomic_t completionCount;
+    SDL_atomic_t nextEntryToWrite;
+    SDL_atomic_t nextEntryToRead;
+    SDL_sem* semaphore;
+    u32 threadCount;
+    // Jobs can be executed only by the queue threads, so threads which push or wait do not help them
+    b32 workersOnly;
+    SDLWorkEntry entries[Capacity];
+};
+
+struct SDLWorkerInfo {
+    SDLWorkQueue* queue;
+    u32 threadIndex;
+};
+
 struct SDLContext {
     b32 running;
 
@@ -18,6 +48,16 @@ struct SDLContext {
     SDL_Surface* surface;
     SDL_GLContext glContext;
 
+    SDLWorkQueue workQueue;
+    SDLWorkerInfo workers[SDLWorkQueue::MaxThreadCount];
+
+    // NOTE: Hidden window with a context sharing objects with the main one. Current on the GL worker thread
+    SDL_Window* glWorkerWindow;
+    SDL_GLContext glWorkerContext;
+    SDLWorkQueue glWorkQueue;
+    // Goes after the indices of the work queue threads
+    u32 glWorkerThreadIndex;
+
     // Internal. Should not be used. Use values from PlatformState.input
     i32 mousePosX;
     i32 mousePosY;
@@ -33,8 +73,20 @@ MouseButton SDLMouseButtonConvert(u8 button);
 
 OpenGLLoadResult SDLLoadOpenGL();
 
+// Leaves glContext null if OpenGL is not available
 void SDLInit(SDLContext* context, const PlatformState* platform, i32 glMajorVersion, i32 glMinorVersion);
 
 void SDLPollEvents(SDLContext* context, PlatformState* platform);
 
 void SDLSwapBuffers(SDLContext* context);
+// Copies RGBA8 pixels with the bottom left origin to the window surface. Used when there is no OpenGL context
+void SDLPresentSoftwareFrame(SDLContext* context, const u32* pixels, u32 width, u32 height);
+
+// Spawns worker threads. Returns number of threads which execute jobs (including the main thread)
+u32 SDLInitWorkQueue(SDLContext* context);
+// Starts the GL worker thread. Returns false if the shared context is not available
+b32 SDLInitGLWorker(SDLContext* context);
+void SDLPushWork(SDLWorkQueue* queue, WorkFn* fn, void* data);
+void SDLCompleteAllWork(SDLWorkQueue* queue);
+// Waits until the queue threads finish all pushed jobs without executing any of them on the calling thread
+void SDLWaitForAllWork(SDLWorkQueue* queue);
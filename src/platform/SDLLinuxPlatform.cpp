@@ -38,6 +38,14 @@ void* GlobalAssertHandlerData = nullptr;
 
 static Win32Context GlobalContext;
 static void* GlobalGameData;
+static SDL_atomic_t GlobalAllocationCount;
+
+#if defined(GAME_STATIC_LINK)
+// NOTE: Game is a part of the executable, so it is called directly and never reloaded
+#define CallGame(invoke) GameUpdateAndRender(&GlobalContext.state, invoke, &GlobalGameData)
+#else
+#define CallGame(invoke) GlobalContext.gameLib.GameUpdateAndRender(&GlobalContext.state, invoke, &GlobalGameData)
+#endif
 
 // TODO: Check is clock_gettime precise enough and is there more preciese alternatives
 f64 GetTimeStamp() {
@@ -50,6 +58,7 @@ f64 GetTimeStamp() {
 }
 
 void* Allocate(uptr size, uptr alignment, void* data) {
+    SDL_AtomicIncRef(&GlobalAllocationCount);
     if (alignment == 0) {
         alignment = 16;
     }
@@ -63,22 +72,53 @@ void Deallocate(void* ptr, void* data) {
 }
 
 void* Reallocate(void* ptr, uptr newSize, void* allocatorData) {
+    SDL_AtomicIncRef(&GlobalAllocationCount);
     return realloc(ptr, newSize);
 }
 
+u64 DebugGetFileWriteTime(const char* filename) {
+    u64 time = 0;
+    struct stat fileAttribs;
+    if (stat(filename, &fileAttribs) == 0) {
+        time = (u64)fileAttribs.st_mtim.tv_sec * 1000000000ull + (u64)fileAttribs.st_mtim.tv_nsec;
+    }
+    return time;
+}
+
+void PushGLWork(WorkFn* fn, void* data) {
+    if (GlobalContext.sdl.glWorkerContext) {
+        SDLPushWork(&GlobalContext.sdl.glWorkQueue, fn, data);
+    } else {
+        // NOTE(swarzzy): No shared context, so the job runs right away on the calling thread
+        fn(data, GlobalContext.sdl.glWorkerThreadIndex);
+    }
+}
+
+void PushWork(WorkFn* fn, void* data) {
+    SDLPushWork(&GlobalContext.sdl.workQueue, fn, data);
+}
+
+void CompleteAllWork() {
+    SDLCompleteAllWork(&GlobalContext.sdl.workQueue);
+}
+
+void PresentSoftwareFrame(const u32* pixels, u32 width, u32 height) {
+    SDLPresentSoftwareFrame(&GlobalContext.sdl, pixels, width, height);
+}
+
 u32 DebugGetFileSize(const char* filename) {
     u32 size = 0;
     struct stat fileAttribs;
-    if (stat(LibraryData::LibName, &fileAttribs) == 0) {
+    if (stat(filename, &fileAttribs) == 0) {
         size = fileAttribs.st_size;
     }
     return size;
 }
 
-u32 DebugReadFileToBuffer(void* buffer, u32 bufferSize, const char* filename) {
+u32 DebugReadFile(void* buffer, u32 bufferSize, const char* filename) {
     u32 written = 0;
     int fileHandle = open(filename, O_RDONLY);
-    if (fileHandle) {
+    if (fileHandle != -1) {
         off_t fileEnd = lseek(fileHandle, 0, SEEK_END);
         if (fileEnd) {
             lseek(fileHandle, 0, SEEK_SET);
@@ -93,14 +133,15 @@ u32 DebugReadFileToBuffer(void* buffer, u32 bufferSize, const char* filename) {
                 }
             }
         }
+        close(fileHandle);
     }
     return written;
 }
 
-u32 DebugReadTextFileToBuffer(void* buffer, u32 bufferSize, const char* filename) {
+u32 DebugReadTextFile(void* buffer, u32 bufferSize, const char* filename) {
     u32 written = 0;
     int fileHandle = open(filename, O_RDONLY);
-    if (fileHandle) {
+    if (fileHandle != -1) {
         off_t fileEnd = lseek(fileHandle, 0, SEEK_END);
         if (fileEnd) {
             lseek(fileHandle, 0, SEEK_SET);
@@ -116,6 +157,7 @@ u32 DebugReadTextFileToBuffer(void* buffer, u32 bufferSize, const char* filename
                 }
             }
         }
+        close(fileHandle);
     }
     return written;
 }
@@ -123,7 +165,7 @@ u32 DebugReadTextFileToBuffer(void* buffer, u32 bufferSize, const char* filename
 b32 DebugWriteFile(const char* filename, void* data, u32 dataSize) {
     b32 result = false;
     int fileHandle = open(filename, O_WRONLY | O_CREAT | O_TRUNC, S_IROTH | S_IRWXU | S_IRGRP);
-    if (fileHandle) {
+    if (fileHandle != -1) {
         ssize_t written = write(fileHandle, data, dataSize);
         if (written == dataSize) {
             result = true;
@@ -160,7 +202,7 @@ b32 DebugCopyFile(const char* source, const char* dest, b32 overwrite) {
     if (fileSize) {
         void* data = Allocate(fileSize, 0, nullptr);
         if (data) {
-            auto bytesRead = DebugReadFileToBuffer(data, fileSize, source);
+            auto bytesRead = DebugReadFile(data, fileSize, source);
             if (bytesRead == fileSize) {
                 if (DebugWriteFile(dest, data, fileSize)) {
                     result = true;
@@ -172,6 +214,8 @@ b32 DebugCopyFile(const char* source, const char* dest, b32 overwrite) {
     return result;
 }
 
+// NOTE: Tools built on top of the platform layer provide their own entry point
+#if !defined(PLATFORM_TOOL)
 int main() {
     auto context = &GlobalContext;
 
@@ -181,44 +225,75 @@ int main() {
     SDLInit(&context->sdl, &context->state, OPENGL_MAJOR_VERSION, OPENGL_MINOR_VERSION);
 
     // Loading OpenGL
-    OpenGLLoadResult glResult = SDLLoadOpenGL();
-    if (!glResult.success) {
-        panic("Failed to load OpenGL functions");
+    // NOTE(swarzzy): Without OpenGL the game gets null gl and draws through the software renderer
+    if (context->sdl.glContext) {
+        OpenGLLoadResult glResult = SDLLoadOpenGL();
+        if (glResult.success) {
+            context->state.gl = glResult.context;
+        } else {
+            log_print("[Platform] Failed to load OpenGL functions\n");
+        }
+    }
+    if (context->state.gl) {
+        // NOTE(swarzzy): Statistics go first, so the capture records calls, not the counting thunks
+        context->state.glStats = GLStatsInitFromEnvironment(context->state.gl);
+        GLCaptureInitFromEnvironment(context->state.gl);
+    } else {
+        log_print("[Platform] OpenGL is not available, falling back to the software renderer\n");
     }
-    context->state.gl = glResult.context;
+
+    context->state.threadCount = SDLInitWorkQueue(&context->sdl);
+    SDLInitGLWorker(&context->sdl);
 
     // Setting function pointers to platform routines a for game
     context->state.functions.DebugGetFileSize = DebugGetFileSize;
-    context->state.functions.DebugReadFile = DebugReadFileToBuffer;
-    context->state.functions.DebugReadTextFile = DebugReadTextFileToBuffer;
+    context->state.functions.DebugReadFile = DebugReadFile;
+    context->state.functions.DebugReadTextFile = DebugReadTextFile;
     context->state.functions.DebugWriteFile = DebugWriteFile;
     context->state.functions.DebugOpenFile = DebugOpenFile;
     context->state.functions.DebugCloseFile = DebugCloseFile;
     context->state.functions.DebugCopyFile = DebugCopyFile;
     context->state.functions.DebugWriteToOpenedFile = DebugWriteToOpenedFile;
+    context->state.functions.DebugGetFileWriteTime = DebugGetFileWriteTime;
+
+    context->state.functions.PushWork = PushWork;
+    context->state.functions.CompleteAllWork = CompleteAllWork;
+    context->state.functions.PushGLWork = PushGLWork;
+    context->state.functions.PresentSoftwareFrame = PresentSoftwareFrame;
+
+    context->state.functions.GetTimeStamp = GetTimeStamp;
 
     context->state.functions.Allocate = Allocate;
     context->state.functions.Deallocate = Deallocate;
     context->state.functions.Reallocate = Reallocate;
 
-    // Init the game
+#if !defined(GAME_STATIC_LINK)
     if (!UpdateGameCode(&context->gameLib)) {
         panic("[Platform] Failed to load game library");
     }
+#endif
 
     // Init the game
-    context->gameLib.GameUpdateAndRender(&context->state, GameInvoke::Init, &GlobalGameData);
+    CallGame(GameInvoke::Init);
 
     while (context->sdl.running) {
         auto frameStartTime = GetTimeStamp();
         context->state.tickCount++;
 
+#if !defined(GAME_STATIC_LINK)
         // Reload game lib if it was updated
-        bool codeReloaded = UpdateGameCode(&context->gameLib);
+        bool codeReloaded = false;
+        if (GameCodeChanged(&context->gameLib)) {
+            // NOTE(swarzzy): GL jobs run game code, so they have to be done before the library is unloaded
+            SDLWaitForAllWork(&context->sdl.glWorkQueue);
+            codeReloaded = UpdateGameCode(&context->gameLib);
+        }
         if (codeReloaded) {
             log_print("[Platform] Game was hot-reloaded\n");
-            context->gameLib.GameUpdateAndRender(&context->state, GameInvoke::Reload, &GlobalGameData);
+            context->state.hotReloadCount++;
+            CallGame(GameInvoke::Reload);
         }
+#endif
 
         // TODO(swarzzy): For now we do ONE update per frame with variable delta time.
         // This is not a good solution. We probably need to do updates with fixed timestep
@@ -226,7 +301,7 @@ int main() {
 
         SDLPollEvents(&context->sdl, &context->state);
 
-        context->gameLib.GameUpdateAndRender(&context->state, GameInvoke::Update, &GlobalGameData);
+        CallGame(GameInvoke::Update);
 
         for (u32 keyIndex = 0; keyIndex < InputState::KeyCount; keyIndex ++) {
             context->state.input.keys[keyIndex].wasPressed = context->state.input.keys[keyIndex].pressedNow;
@@ -236,23 +311,36 @@ int main() {
             context->state.input.mouseButtons[mbIndex].wasPressed = context->state.input.mouseButtons[mbIndex].pressedNow;
         }
 
-        context->gameLib.GameUpdateAndRender(&context->state, GameInvoke::Render, &GlobalGameData);
+        CallGame(GameInvoke::Render);
 
-        SDLSwapBuffers(&context->sdl);
+        // NOTE(swarzzy): The software renderer presents the frame by itself
+        if (context->state.gl) {
+            SDLSwapBuffers(&context->sdl);
+        }
 
         auto frameEndTime = GetTimeStamp();
         auto frameTime = frameEndTime - frameStartTime;
 
         // If framerate lower than 15 fps just clamping delta time
-        context->state.deltaTime = (f32)Clamp(1.0 / frameTime, 0.0, 0.066);
-        context->state.fps = (i32)(1.0f / context->state.deltaTime);
+        context->state.frameTime = (f32)frameTime;
+        context->state.deltaTime = (f32)Clamp(frameTime, 0.0, 0.066);
+        context->state.fps = frameTime > 0.0 ? (i32)(1.0 / frameTime) : 0;
         context->state.ups = context->state.fps;
+        context->state.allocationCount += (u32)SDL_AtomicSet(&GlobalAllocationCount, 0);
     }
 
+    GLCaptureEnd();
+    GLStatsEnd();
+
     // TODO(swarzzy): Is that necessary?
     SDL_Quit();
     return 0;
 }
+#endif
 
 #include "SDL.cpp"
+#include "GLCapture.cpp"
+#include "GLStats.cpp"
+#if !defined(GAME_STATIC_LINK)
 #include "LinuxCodeLoader.cpp"
+#endif
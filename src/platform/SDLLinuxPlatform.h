@@ -22,10 +22,11 @@ struct Win32Context {
 
 f64 GetTimeStamp();
 u32 DebugGetFileSize(const wchar_t* filename);
-u32 DebugReadFileToBuffer(void* buffer, u32 bufferSize, const wchar_t* filename);
-u32 DebugReadTextFileToBuffer(void* buffer, u32 bufferSize, const wchar_t* filename);
+u32 DebugReadFile(void* buffer, u32 bufferSize, const char* filename);
+u32 DebugReadTextFile(void* buffer, u32 bufferSize, const char* filename);
 b32 DebugWriteFile(const wchar_t* filename, void* data, u32 dataSize);
 FileHandle DebugOpenFile(const wchar_t* filename);
 b32 DebugCloseFile(FileHandle handle);
 u32 DebugWriteToOpenedFile(FileHandle handle, void* data, u32 size);
 b32 DebugCopyFile(const wchar_t* source, const wchar_t* dest, bool overwrite);
+u64 DebugGetFileWriteTime(const char* filename);
@@ -0,0 +1,6 @@
+// NOTE: Release build with the game compiled into the platform executable. Platform and OpenGL
+// calls of the game don't go through PlatformState and the game can't be hot-reloaded
+#define GAME_STATIC_LINK
+
+#include "SDLLinuxPlatform.cpp"
+#include "../GameEntry.cpp"
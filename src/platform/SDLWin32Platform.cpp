@@ -34,6 +34,7 @@ void* GlobalAssertHandlerData = nullptr;
 
 static Win32Context GlobalContext;
 static void* GlobalGameData;
+static SDL_atomic_t GlobalAllocationCount;
 
 f64 GetTimeStamp() {
     f64 time = 0.0;
@@ -44,6 +45,36 @@ f64 GetTimeStamp() {
     return time;
 }
 
+u64 DebugGetFileWriteTime(const char* filename) {
+    u64 time = 0;
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (GetFileAttributesExA(filename, GetFileExInfoStandard, &attributes)) {
+        time = ((u64)attributes.ftLastWriteTime.dwHighDateTime << 32) | (u64)attributes.ftLastWriteTime.dwLowDateTime;
+    }
+    return time;
+}
+
+void PushGLWork(WorkFn* fn, void* data) {
+    if (GlobalContext.sdl.glWorkerContext) {
+        SDLPushWork(&GlobalContext.sdl.glWorkQueue, fn, data);
+    } else {
+        // NOTE(swarzzy): No shared context, so the job runs right away on the calling thread
+        fn(data, GlobalContext.sdl.glWorkerThreadIndex);
+    }
+}
+
+void PushWork(WorkFn* fn, void* data) {
+    SDLPushWork(&GlobalContext.sdl.workQueue, fn, data);
+}
+
+void CompleteAllWork() {
+    SDLCompleteAllWork(&GlobalContext.sdl.workQueue);
+}
+
+void PresentSoftwareFrame(const u32* pixels, u32 width, u32 height) {
+    SDLPresentSoftwareFrame(&GlobalContext.sdl, pixels, width, height);
+}
+
 u32 DebugGetFileSize(const char* filename) {
     u32 fileSize = 0;
     HANDLE handle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, 0,
@@ -168,6 +199,7 @@ b32 DebugCopyFile(const char* source, const char* dest, b32 overwrite) {
 __declspec(restrict)
 #endif
 void* Allocate(uptr size, uptr alignment, void* data) {
+    SDL_AtomicIncRef(&GlobalAllocationCount);
     if (alignment == 0) {
         alignment = 16;
     }
@@ -186,6 +218,7 @@ void Deallocate(void* ptr, void* data) {
 __declspec(restrict)
 #endif
 void* Reallocate(void* ptr, uptr newSize, void* allocatorData) {
+    SDL_AtomicIncRef(&GlobalAllocationCount);
     return realloc(ptr, newSize);
 }
 
@@ -211,11 +244,25 @@ int WINAPI WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine, in
     SDLInit(&context->sdl, &context->state, OPENGL_MAJOR_VERSION, OPENGL_MINOR_VERSION);
 
     // Loading OpenGL
-    OpenGLLoadResult glResult = SDLLoadOpenGL();
-    if (!glResult.success) {
-        panic("Failed to load OpenGL functions");
+    // NOTE(swarzzy): Without OpenGL the game gets null gl and draws through the software renderer
+    if (context->sdl.glContext) {
+        OpenGLLoadResult glResult = SDLLoadOpenGL();
+        if (glResult.success) {
+            context->state.gl = glResult.context;
+        } else {
+            log_print("[Platform] Failed to load OpenGL functions\n");
+        }
     }
-    context->state.gl = glResult.context;
+    if (context->state.gl) {
+        // NOTE(swarzzy): Statistics go first, so the capture records calls, not the counting thunks
+        context->state.glStats = GLStatsInitFromEnvironment(context->state.gl);
+        GLCaptureInitFromEnvironment(context->state.gl);
+    } else {
+        log_print("[Platform] OpenGL is not available, falling back to the software renderer\n");
+    }
+
+    context->state.threadCount = SDLInitWorkQueue(&context->sdl);
+    SDLInitGLWorker(&context->sdl);
 
     // Setting function pointers to platform routines a for game
     context->state.functions.DebugGetFileSize = DebugGetFileSize;
@@ -226,6 +273,14 @@ int WINAPI WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine, in
     context->state.functions.DebugCloseFile = DebugCloseFile;
     context->state.functions.DebugCopyFile = DebugCopyFile;
     context->state.functions.DebugWriteToOpenedFile = DebugWriteToOpenedFile;
+    context->state.functions.DebugGetFileWriteTime = DebugGetFileWriteTime;
+
+    context->state.functions.PushWork = PushWork;
+    context->state.functions.CompleteAllWork = CompleteAllWork;
+    context->state.functions.PushGLWork = PushGLWork;
+    context->state.functions.PresentSoftwareFrame = PresentSoftwareFrame;
+
+    context->state.functions.GetTimeStamp = GetTimeStamp;
 
     context->state.functions.Allocate = Allocate;
     context->state.functions.Deallocate = Deallocate;
@@ -243,9 +298,15 @@ int WINAPI WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine, in
         context->state.tickCount++;
 
         // Reload game lib if it was updated
-        bool codeReloaded = UpdateGameCode(&context->gameLib);
+        bool codeReloaded = false;
+        if (GameCodeChanged(&context->gameLib)) {
+            // NOTE(swarzzy): GL jobs run game code, so they have to be done before the library is unloaded
+            SDLWaitForAllWork(&context->sdl.glWorkQueue);
+            codeReloaded = UpdateGameCode(&context->gameLib);
+        }
         if (codeReloaded) {
             log_print("[Platform] Game was hot-reloaded\n");
+            context->state.hotReloadCount++;
             context->gameLib.GameUpdateAndRender(&context->state, GameInvoke::Reload, &GlobalGameData);
         }
 
@@ -267,21 +328,31 @@ int WINAPI WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine, in
 
         context->gameLib.GameUpdateAndRender(&context->state, GameInvoke::Render, &GlobalGameData);
 
-        SDLSwapBuffers(&context->sdl);
+        // NOTE(swarzzy): The software renderer presents the frame by itself
+        if (context->state.gl) {
+            SDLSwapBuffers(&context->sdl);
+        }
 
         auto frameEndTime = GetTimeStamp();
         auto frameTime = frameEndTime - frameStartTime;
 
         // If framerate lower than 15 fps just clamping delta time
-        context->state.deltaTime = (f32)Clamp(1.0 / frameTime, 0.0, 0.066);
-        context->state.fps = (i32)(1.0f / context->state.deltaTime);
+        context->state.frameTime = (f32)frameTime;
+        context->state.deltaTime = (f32)Clamp(frameTime, 0.0, 0.066);
+        context->state.fps = frameTime > 0.0 ? (i32)(1.0 / frameTime) : 0;
         context->state.ups = context->state.fps;
+        context->state.allocationCount += (u32)SDL_AtomicSet(&GlobalAllocationCount, 0);
     }
 
+    GLCaptureEnd();
+    GLStatsEnd();
+
     // TODO(swarzzy): Is that necessary?
     SDL_Quit();
     return 0;
 }
 
 #include "SDL.cpp"
+#include "GLCapture.cpp"
+#include "GLStats.cpp"
 #include "Win32CodeLoader.cpp"
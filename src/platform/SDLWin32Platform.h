@@ -41,3 +41,4 @@ FileHandle DebugOpenFile(const char* filename);
 b32 DebugCloseFile(FileHandle handle);
 u32 DebugWriteToOpenedFile(FileHandle handle, void* data, u32 size);
 b32 DebugCopyFile(const char* source, const char* dest, b32 overwrite);
+u64 DebugGetFileWriteTime(const char* filename);
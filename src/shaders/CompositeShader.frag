@@ -0,0 +1,15 @@
+#version 330 core
+
+out vec4 FragmentColor;
+
+in vec2 UV;
+
+uniform sampler2D Layer;
+
+void main() {
+    vec4 color = texture(Layer, UV);
+    if (color.a == 0.0f) {
+        discard;
+    }
+    FragmentColor = color;
+}
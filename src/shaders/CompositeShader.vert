@@ -0,0 +1,19 @@
+#version 330 core
+
+// NOTE: Draws a layer texture as a fullscreen triangle at the given depth. Pixels which
+// were not covered by anything in the layer are discarded
+
+out vec2 UV;
+
+uniform float Depth;
+
+void main() {
+    vec2 position = vec2(float((gl_VertexID & 1) << 2), float((gl_VertexID & 2) << 1)) - 1.0f;
+    UV = position * 0.5f + 0.5f;
+    gl_Position = vec4(position, Depth * 2.0f - 1.0f, 1.0f);
+    // View clip planes are enabled for all programs
+    gl_ClipDistance[0] = 1.0f;
+    gl_ClipDistance[1] = 1.0f;
+    gl_ClipDistance[2] = 1.0f;
+    gl_ClipDistance[3] = 1.0f;
+}
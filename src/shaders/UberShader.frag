@@ -0,0 +1,31 @@
+#version 330 core
+
+out vec4 FragmentColor;
+
+in vec4 VertexColor;
+in vec3 TexCoord;
+in vec2 LocalPosition;
+flat in vec2 HalfSize;
+flat in float Radius;
+
+uniform sampler2DArray Atlas;
+
+void main() {
+    // Signed distance to the rounded rect. Coverage is computed over one pixel around the edge
+    vec2 q = abs(LocalPosition) - HalfSize + Radius;
+    float dist = length(max(q, 0.0f)) + min(max(q.x, q.y), 0.0f) - Radius;
+    float width = max(fwidth(dist), 1e-5f);
+    float coverage = clamp(0.5f - dist / width, 0.0f, 1.0f);
+    if (coverage <= 0.0f) {
+        discard;
+    }
+    vec4 color = vec4(VertexColor.rgb, VertexColor.a * coverage);
+    if (TexCoord.z >= 0.0f) {
+        color *= texture(Atlas, TexCoord);
+        // NOTE: Transparent texels must not write depth
+        if (color.a <= 0.0f) {
+            discard;
+        }
+    }
+    FragmentColor = color;
+}
@@ -0,0 +1,371 @@
+// NOTE: Replays a trace written by GLCapture against a fresh context and measures how long every frame takes.
+// Usage: gl_replay [trace file]
+#include "../platform/SDL.h"
+
+#include <stdlib.h>
+
+void Logger(void* data, const char* fmt, va_list* args) {
+    vprintf(fmt, *args);
+}
+
+inline void AssertHandler(void* data, const char* file, const char* func, u32 line, const char* assertStr, const char* fmt, va_list* args) {
+    log_print("[Assertion failed] Expression (%s) result is false\nFile: %s, function: %s, line: %d.\n", assertStr, file, func, (int)line);
+    if (args) {
+        GlobalLogger(GlobalLoggerData, fmt, args);
+    }
+    debug_break();
+}
+
+LoggerFn* GlobalLogger = Logger;
+void* GlobalLoggerData = nullptr;
+AssertHandlerFn* GlobalAssertHandler = AssertHandler;
+void* GlobalAssertHandlerData = nullptr;
+
+struct GLReplay {
+    static const u32 ScratchSize = 16 * 1024 * 1024;
+    static const u32 MaxSyncs = 256;
+    static const u32 MaxMappings = 4;
+    static const u32 MaxStrings = 64;
+
+    struct Sync {
+        u64 recorded;
+        GLsync sync;
+    };
+
+    struct Mapping {
+        GLenum target;
+        void* pointer;
+    };
+
+    const u8* at;
+    const u8* end;
+    OpenGL* gl;
+    // Output parameters are written here
+    u8* scratch;
+    const GLchar* strings[MaxStrings];
+
+    u32 syncCount;
+    Sync syncs[MaxSyncs];
+    Mapping mappings[MaxMappings];
+
+    // Objects which got different names than during capture
+    u32 nameMismatches;
+};
+
+template<typename T>
+T GLReplayRead(GLReplay* replay) {
+    if ((uptr)(replay->end - replay->at) < sizeof(T)) {
+        panic("[GLReplay] Trace is truncated");
+    }
+    T value;
+    memcpy(&value, replay->at, sizeof(T));
+    replay->at += sizeof(T);
+    return value;
+}
+
+// Data pointers point right into the trace
+template<typename T>
+T GLReplayData(GLReplay* replay, const u8* data, u32 size) {
+    return (T)data;
+}
+
+template<>
+const GLchar* const* GLReplayData<const GLchar* const*>(GLReplay* replay, const u8* data, u32 size) {
+    u32 count = 0;
+    for (u32 offset = 0; offset < size; offset += (u32)strlen((const char*)data + offset) + 1) {
+        assert(count < GLReplay::MaxStrings);
+        replay->strings[count++] = (const GLchar*)data + offset;
+    }
+    return replay->strings;
+}
+
+template<typename T>
+T GLReplayHandle(GLReplay* replay, u64 value) {
+    return (T)replay->scratch;
+}
+
+template<>
+GLsync GLReplayHandle<GLsync>(GLReplay* replay, u64 value) {
+    for (u32 i = 0; i < replay->syncCount; i++) {
+        if (replay->syncs[i].recorded == value) {
+            return replay->syncs[i].sync;
+        }
+    }
+    return nullptr;
+}
+
+template<>
+GLDEBUGPROC GLReplayHandle<GLDEBUGPROC>(GLReplay* replay, u64 value) {
+    return nullptr;
+}
+
+template<typename T>
+T GLReplayReadArg(GLReplay* replay) {
+    if constexpr (GLTraceArg<T>::IsPointer) {
+        u64 value = GLReplayRead<u64>(replay);
+        u32 size = GLReplayRead<u32>(replay);
+        if ((u32)(replay->end - replay->at) < size) {
+            panic("[GLReplay] Trace is truncated");
+        }
+        const u8* data = replay->at;
+        replay->at += size;
+        if constexpr (GLTraceArg<T>::IsData) {
+            // NOTE(swarzzy): Pointers without data are offsets in bound buffers
+            return size ? GLReplayData<T>(replay, data, size) : (T)(uptr)value;
+        } else {
+            return GLReplayHandle<T>(replay, value);
+        }
+    } else {
+        return GLReplayRead<T>(replay);
+    }
+}
+
+template<typename T>
+void GLReplayResult(GLReplay* replay, u64 recorded, T result) {}
+
+void GLReplayResult(GLReplay* replay, u64 recorded, GLsync result) {
+    // NOTE(swarzzy): Deleted syncs are removed, so the table fills up only if captured frames leak them. Then old ones are overwritten
+    GLReplay::Sync* sync = replay->syncs + (replay->syncCount < GLReplay::MaxSyncs ? replay->syncCount++ : recorded % GLReplay::MaxSyncs);
+    *sync = { recorded, result };
+}
+
+void GLReplayCheckName(GLReplay* replay, u64 recorded, u64 result) {
+    if (recorded != result) {
+        replay->nameMismatches++;
+    }
+}
+
+// NOTE: Called after the call is replayed. Functions without a result have their own hook
+template<u32 Index>
+struct GLReplayHook {
+    template<typename R, typename... Args>
+    static void After(GLReplay* replay, u64 recorded, R result, Args... args) {}
+    template<typename... Args>
+    static void AfterVoid(GLReplay* replay, Args... args) {}
+};
+
+template<>
+struct GLReplayHook<OPENGL_FUNCTION_INDEX(glMapBufferRange)> {
+    static void After(GLReplay* replay, u64 recorded, void* result, GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+        for (u32 i = 0; i < GLReplay::MaxMappings; i++) {
+            if (!replay->mappings[i].pointer) {
+                replay->mappings[i] = { target, result };
+                break;
+            }
+        }
+    }
+};
+
+template<>
+struct GLReplayHook<OPENGL_FUNCTION_INDEX(glMapBuffer)> {
+    static void After(GLReplay* replay, u64 recorded, void* result, GLenum target, GLenum access) {
+        GLReplayHook<OPENGL_FUNCTION_INDEX(glMapBufferRange)>::After(replay, recorded, result, target, 0, 0, 0);
+    }
+};
+
+template<>
+struct GLReplayHook<OPENGL_FUNCTION_INDEX(glUnmapBuffer)> {
+    static void After(GLReplay* replay, u64 recorded, GLboolean result, GLenum target) {
+        for (u32 i = 0; i < GLReplay::MaxMappings; i++) {
+            if (replay->mappings[i].pointer && replay->mappings[i].target == target) {
+                replay->mappings[i] = {};
+                break;
+            }
+        }
+    }
+};
+
+template<>
+struct GLReplayHook<OPENGL_FUNCTION_INDEX(glCreateProgram)> {
+    static void After(GLReplay* replay, u64 recorded, GLuint result) {
+        GLReplayCheckName(replay, recorded, result);
+    }
+};
+
+template<>
+struct GLReplayHook<OPENGL_FUNCTION_INDEX(glCreateShader)> {
+    static void After(GLReplay* replay, u64 recorded, GLuint result, GLenum type) {
+        GLReplayCheckName(replay, recorded, result);
+    }
+};
+
+template<>
+struct GLReplayHook<OPENGL_FUNCTION_INDEX(glDeleteSync)> {
+    static void AfterVoid(GLReplay* replay, GLsync sync) {
+        // NOTE(swarzzy): Driver may give the same address to a later sync, so the deleted one must not be found by it
+        for (u32 i = 0; i < replay->syncCount; i++) {
+            if (replay->syncs[i].sync == sync) {
+                replay->syncs[i] = replay->syncs[--replay->syncCount];
+                break;
+            }
+        }
+    }
+};
+
+// NOTE: Arguments are read inside of a braced initializer, so they are read in order
+template<u32 Index, typename R, typename... Args>
+struct GLReplayInvoke {
+    GLReplayInvoke(GLReplay* replay, R (APIENTRYP function)(Args...), Args... args) {
+        R result = function(args...);
+        u64 recorded = GLReplayRead<u64>(replay);
+        GLReplayResult(replay, recorded, result);
+        GLReplayHook<Index>::After(replay, recorded, result, args...);
+    }
+};
+
+template<u32 Index, typename... Args>
+struct GLReplayInvoke<Index, void, Args...> {
+    GLReplayInvoke(GLReplay* replay, void (APIENTRYP function)(Args...), Args... args) {
+        function(args...);
+        GLReplayHook<Index>::AfterVoid(replay, args...);
+    }
+};
+
+template<u32 Index, typename Fn>
+struct GLReplayCall;
+
+template<u32 Index, typename R, typename... Args>
+struct GLReplayCall<Index, R (APIENTRYP)(Args...)> {
+    static void Replay(GLReplay* replay) {
+        auto function = (R (APIENTRYP)(Args...))replay->gl->functions.raw[Index];
+        if (!function) {
+            panic("[GLReplay] Function %s is not available", OpenGL::FunctionNames[Index]);
+        }
+        GLReplayInvoke<Index, R, Args...> { replay, function, GLReplayReadArg<Args>(replay)... };
+    }
+};
+
+typedef void(GLReplayFn)(GLReplay* replay);
+
+#define GLREPLAY_FUNCTION(type, name) GLReplayCall<OPENGL_FUNCTION_INDEX(name), type>::Replay,
+static GLReplayFn* GLReplayFunctions[] = {
+    OPENGL_FUNCTIONS(GLREPLAY_FUNCTION)
+    OPENGL_OPTIONAL_FUNCTIONS(GLREPLAY_FUNCTION)
+};
+#undef GLREPLAY_FUNCTION
+
+void GLReplayMappedData(GLReplay* replay) {
+    GLenum target = GLReplayRead<u32>(replay);
+    u32 size = GLReplayRead<u32>(replay);
+    if ((u32)(replay->end - replay->at) < size) {
+        panic("[GLReplay] Trace is truncated");
+    }
+    for (u32 i = 0; i < GLReplay::MaxMappings; i++) {
+        if (replay->mappings[i].pointer && replay->mappings[i].target == target) {
+            memcpy(replay->mappings[i].pointer, replay->at, size);
+            break;
+        }
+    }
+    replay->at += size;
+}
+
+f64 GLReplayTime() {
+    return (f64)SDL_GetPerformanceCounter() / (f64)SDL_GetPerformanceFrequency();
+}
+
+int main(int argc, char** argv) {
+    const char* filename = argc > 1 ? argv[1] : GLCapture::DefaultFilename;
+
+    SDL_RWops* file = SDL_RWFromFile(filename, "rb");
+    if (!file) {
+        log_print("[GLReplay] Failed to open %s: %s\n", filename, SDL_GetError());
+        return 1;
+    }
+    i64 fileSize = SDL_RWsize(file);
+    u8* trace = (u8*)malloc((uptr)fileSize);
+    if (!trace || fileSize < (i64)sizeof(GLTraceHeader) || SDL_RWread(file, trace, (uptr)fileSize, 1) != 1) {
+        log_print("[GLReplay] Failed to read %s\n", filename);
+        return 1;
+    }
+    SDL_RWclose(file);
+
+    GLTraceHeader* header = (GLTraceHeader*)trace;
+    if (header->magic != GLTraceHeader::Magic || header->version != GLTraceHeader::Version || header->functionCount != OpenGL::FunctionCount) {
+        log_print("[GLReplay] %s is not a trace or it was captured with a different function table\n", filename);
+        return 1;
+    }
+
+    static PlatformState platform;
+    static SDLContext sdl;
+    platform.windowWidth = 1280;
+    platform.windowHeight = 720;
+    SDLInit(&sdl, &platform, 3, 3);
+    if (!sdl.glContext) {
+        panic("OpenGL context is required to replay a trace");
+    }
+    OpenGLLoadResult glResult = SDLLoadOpenGL();
+    if (!glResult.success) {
+        panic("Failed to load OpenGL functions");
+    }
+    // NOTE(swarzzy): Frames should not wait for v-sync
+    SDL_GL_SetSwapInterval(0);
+
+    static GLReplay replay;
+    replay.at = trace + sizeof(GLTraceHeader);
+    replay.end = trace + fileSize;
+    replay.gl = glResult.context;
+    replay.scratch = (u8*)calloc(GLReplay::ScratchSize, 1);
+    assert(replay.scratch);
+
+    log_print("[GLReplay] Replaying %u frames from %s\n", header->frameCount, filename);
+
+    u32 frameCount = 0;
+    u64 callCount = 0;
+    u64 frameCallCount = 0;
+    f64 firstFrameTime = 0.0;
+    f64 totalTime = 0.0;
+    f64 minTime = DBL_MAX;
+    f64 maxTime = 0.0;
+    f64 totalSubmitTime = 0.0;
+    f64 frameStartTime = GLReplayTime();
+
+    while (replay.at < replay.end) {
+        u16 index = GLReplayRead<u16>(&replay);
+        if (index == (u16)GLTraceMarker::EndFrame) {
+            f64 submitTime = GLReplayTime() - frameStartTime;
+            SDL_GL_SwapWindow(sdl.window);
+            // NOTE(swarzzy): Waiting for the GPU, so the frame time includes the work the driver deferred
+            replay.gl->functions.fn.glFinish();
+            f64 frameTime = GLReplayTime() - frameStartTime;
+            SDL_PumpEvents();
+
+            // NOTE(swarzzy): The first frame includes all the loading, so it is reported on its own
+            if (frameCount == 0) {
+                firstFrameTime = frameTime;
+            } else {
+                totalTime += frameTime;
+                totalSubmitTime += submitTime;
+                minTime = Min(minTime, frameTime);
+                maxTime = Max(maxTime, frameTime);
+                frameCallCount += callCount;
+            }
+            frameCount++;
+            callCount = 0;
+            frameStartTime = GLReplayTime();
+        } else if (index == (u16)GLTraceMarker::MappedData) {
+            GLReplayMappedData(&replay);
+        } else if (index < OpenGL::FunctionCount) {
+            GLReplayFunctions[index](&replay);
+            callCount++;
+        } else {
+            panic("[GLReplay] Trace is corrupted");
+        }
+    }
+
+    log_print("[GLReplay] First frame: %.3f ms\n", firstFrameTime * 1000.0);
+    if (frameCount > 1) {
+        u32 count = frameCount - 1;
+        log_print("[GLReplay] Other %u frames: avg %.3f ms (submit %.3f ms), min %.3f ms, max %.3f ms, %u calls per frame\n",
+                  count, totalTime / count * 1000.0, totalSubmitTime / count * 1000.0, minTime * 1000.0, maxTime * 1000.0, (u32)(frameCallCount / count));
+    }
+    if (replay.nameMismatches) {
+        log_print("[GLReplay] Warning! %u objects got different names than during capture, replay is not faithful\n", replay.nameMismatches);
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+#include "../platform/SDL.cpp"
+#include "../platform/GLCapture.cpp"
+#include "../platform/GLStats.cpp"
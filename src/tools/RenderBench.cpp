@@ -0,0 +1,387 @@
+// NOTE: Loads frames dumped by RenderCapture and draws them through the renderer in a loop without running
+// the game. Reports CPU time of every phase of RendererDraw and GPU time of the whole frame, so renderer versions
+// can be compared on identical input. Usage: render_bench [-software] [-golden file.tga] [-backend gl|null|counting] [file] [iterations]
+// Null and counting backends show the CPU cost of the frame without drawing it
+// With -software frames go through SoftwareRenderer instead. It needs no window or GPU, reports binning and
+// rasterization time and writes the last frame to render_bench_software.tga
+// -golden file.tga compares the last software frame with a reference image written by an earlier run and fails
+// if too many pixels differ. Use it to check that rasterizer changes do not change the picture
+// Only the queue goes through the benchmark. Batches, layers and atlas contents are not captured, so sprites
+// sample an empty atlas
+#define GAME_STATIC_LINK
+#define PLATFORM_TOOL
+
+#include "../platform/SDLLinuxPlatform.cpp"
+#include "../GameEntry.cpp"
+
+struct RenderBenchFrame {
+    Canvas canvas;
+    RenderQueue queue;
+};
+
+// NOTE: Seconds spent in a phase over all measured frames
+struct RenderBenchPhase {
+    const char* name;
+    f64 total;
+    f64 min;
+    f64 max;
+};
+
+enum struct RenderBenchPhaseId : u32 {
+    Begin = 0, Cull, Flush, End, Bin, Raster, Cpu, Gpu, Count
+};
+
+struct RenderBench {
+    static const u32 DefaultIterations = 10;
+    static constexpr const char* SoftwareImageFilename = "render_bench_software.tga";
+    // NOTE(swarzzy): Edges are anti-aliased with float math, so a few pixels may change slightly between builds
+    static const u32 GoldenChannelTolerance = 8;
+    static constexpr f64 GoldenMaxMismatch = 0.001;
+    // GPU times are read this number of frames later, so reading them does not stall the pipeline
+    static const u32 QueryCount = 4;
+
+    RenderBenchPhase phases[(u32)RenderBenchPhaseId::Count];
+    u32 framesMeasured;
+    u64 drawCalls;
+    u64 bytesUploaded;
+    u64 primitives;
+    u64 tileRejects;
+    GLuint queries[QueryCount];
+};
+
+void RenderBenchRecord(RenderBench* bench, RenderBenchPhaseId phase, f64 time) {
+    RenderBenchPhase* p = bench->phases + (u32)phase;
+    p->total += time;
+    p->min = Min(p->min, time);
+    p->max = Max(p->max, time);
+}
+
+// Prints phases which were measured
+void RenderBenchReport(const RenderBench* bench) {
+    u32 count = Max(bench->framesMeasured, 1u);
+    for (u32 i = 0; i < (u32)RenderBenchPhaseId::Count; i++) {
+        const RenderBenchPhase* phase = bench->phases + i;
+        if (phase->min != DBL_MAX) {
+            log_print("[RenderBench] %-16s avg %8.3f ms  min %8.3f ms  max %8.3f ms\n", phase->name,
+                      phase->total / count * 1000.0, phase->min * 1000.0, phase->max * 1000.0);
+        }
+    }
+}
+
+// Reads the GPU time of the frame which used the query. The first iteration is a warm-up and it is not recorded
+void RenderBenchReadQuery(RenderBench* bench, u32 frameIndex, u32 warmupFrames) {
+    GLuint64 nanoseconds = 0;
+    glGetQueryObjectui64v(bench->queries[frameIndex % RenderBench::QueryCount], GL_QUERY_RESULT, &nanoseconds);
+    if (frameIndex >= warmupFrames) {
+        RenderBenchRecord(bench, RenderBenchPhaseId::Gpu, (f64)nanoseconds / 1000000000.0);
+    }
+}
+
+// Writes the color buffer of the software renderer as an uncompressed 32 bit TGA
+b32 RenderBenchWriteImage(const SoftwareRenderer* renderer, const char* filename) {
+    const u32 headerSize = 18;
+    u32 size = headerSize + renderer->width * renderer->height * 4;
+    u8* image = (u8*)Allocate(size, 0, nullptr);
+    memset(image, 0, headerSize);
+    image[2] = 2; // Uncompressed true color
+    image[12] = (u8)(renderer->width & 0xff);
+    image[13] = (u8)(renderer->width >> 8);
+    image[14] = (u8)(renderer->height & 0xff);
+    image[15] = (u8)(renderer->height >> 8);
+    image[16] = 32;
+    // NOTE(swarzzy): 8 alpha bits, origin is at the bottom left like in the color buffer
+    image[17] = 8;
+    u8* pixels = image + headerSize;
+    for (u32 i = 0; i < renderer->width * renderer->height; i++) {
+        u32 color = renderer->color[i];
+        pixels[i * 4 + 0] = (u8)(color >> 16);
+        pixels[i * 4 + 1] = (u8)(color >> 8);
+        pixels[i * 4 + 2] = (u8)color;
+        pixels[i * 4 + 3] = (u8)(color >> 24);
+    }
+    b32 result = DebugWriteFile(filename, image, size);
+    Deallocate(image, nullptr);
+    return result;
+}
+
+// Reads an image written by RenderBenchWriteImage. Returns pixels in the color buffer layout or null
+u32* RenderBenchReadImage(const char* filename, u32* width, u32* height) {
+    const u32 headerSize = 18;
+    u32 size = DebugGetFileSize(filename);
+    if (size < headerSize) {
+        return nullptr;
+    }
+    u8* image = (u8*)Allocate(size, 0, nullptr);
+    u32* result = nullptr;
+    if (DebugReadFile(image, size, filename) == size && image[0] == 0 && image[2] == 2 && image[16] == 32 && image[17] == 8) {
+        u32 w = image[12] | ((u32)image[13] << 8);
+        u32 h = image[14] | ((u32)image[15] << 8);
+        if (size >= headerSize + w * h * 4) {
+            result = (u32*)Allocate(sizeof(u32) * w * h, 0, nullptr);
+            u8* pixels = image + headerSize;
+            for (u32 i = 0; i < w * h; i++) {
+                result[i] = ((u32)pixels[i * 4 + 0] << 16) | ((u32)pixels[i * 4 + 1] << 8) | pixels[i * 4 + 2] | ((u32)pixels[i * 4 + 3] << 24);
+            }
+            *width = w;
+            *height = h;
+        }
+    }
+    Deallocate(image, nullptr);
+    return result;
+}
+
+// Returns true if the color buffer matches the reference image within the tolerance
+b32 RenderBenchCompareImage(const SoftwareRenderer* renderer, const char* filename) {
+    u32 width = 0;
+    u32 height = 0;
+    u32* golden = RenderBenchReadImage(filename, &width, &height);
+    if (!golden) {
+        log_print("[RenderBench] Failed to read golden image %s\n", filename);
+        return false;
+    }
+    if (width != renderer->width || height != renderer->height) {
+        log_print("[RenderBench] Golden image is %ux%u, frame is %ux%u\n", width, height, renderer->width, renderer->height);
+        Deallocate(golden, nullptr);
+        return false;
+    }
+
+    u32 mismatched = 0;
+    u32 maxDifference = 0;
+    for (u32 i = 0; i < width * height; i++) {
+        u32 a = renderer->color[i];
+        u32 b = golden[i];
+        b32 mismatch = false;
+        for (u32 shift = 0; shift < 32; shift += 8) {
+            i32 difference = Abs((i32)((a >> shift) & 0xff) - (i32)((b >> shift) & 0xff));
+            maxDifference = Max(maxDifference, (u32)difference);
+            if ((u32)difference > RenderBench::GoldenChannelTolerance) {
+                mismatch = true;
+            }
+        }
+        if (mismatch) {
+            mismatched++;
+        }
+    }
+    Deallocate(golden, nullptr);
+
+    f64 fraction = (f64)mismatched / (width * height);
+    b32 result = fraction <= RenderBench::GoldenMaxMismatch;
+    log_print("[RenderBench] Golden image %s: %u pixels differ (%.3f%%), max channel difference %u, %s\n", filename,
+              mismatched, fraction * 100.0, maxDifference, result ? "passed" : "FAILED");
+    return result;
+}
+
+int main(int argc, char** argv) {
+    b32 software = false;
+    const char* golden = nullptr;
+    RenderBackendKind backend = RenderBackendKind::GL;
+    const char* filename = RenderCapture::DefaultFilename;
+    u32 iterations = RenderBench::DefaultIterations;
+    u32 positional = 0;
+    for (i32 i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-software") == 0) {
+            software = true;
+        } else if (strcmp(argv[i], "-golden") == 0 && i + 1 < argc) {
+            golden = argv[++i];
+        } else if (strcmp(argv[i], "-backend") == 0 && i + 1 < argc) {
+            if (!RenderBackendFind(argv[++i], &backend)) {
+                log_print("[RenderBench] Unknown backend %s\n", argv[i]);
+                return 1;
+            }
+        } else if (positional == 0) {
+            filename = argv[i];
+            positional++;
+        } else if (positional == 1) {
+            iterations = (u32)Max(SDL_atoi(argv[i]), 1);
+            positional++;
+        }
+    }
+
+    if (golden && !software) {
+        log_print("[RenderBench] -golden needs -software. GL output depends on the driver\n");
+        return 1;
+    }
+
+    u32 fileSize = DebugGetFileSize(filename);
+    u8* data = fileSize ? (u8*)Allocate(fileSize, 0, nullptr) : nullptr;
+    if (!data || DebugReadFile(data, fileSize, filename) != fileSize || fileSize < sizeof(RenderFrameFileHeader)) {
+        log_print("[RenderBench] Failed to read %s\n", filename);
+        return 1;
+    }
+
+    RenderFrameFileHeader* header = (RenderFrameFileHeader*)data;
+    if (header->magic != RenderFrameFileHeader::Magic || header->version != RenderFrameFileHeader::Version ||
+        header->commandSize != sizeof(RenderCommand) || !header->frameCount) {
+        log_print("[RenderBench] %s is not a frame capture or it was written by a different build\n", filename);
+        return 1;
+    }
+
+    // NOTE(swarzzy): Commands are copied to regular queues, so the renderer gets the same memory it gets in the game
+    u32 frameCount = header->frameCount;
+    RenderBenchFrame* frames = (RenderBenchFrame*)Allocate(sizeof(RenderBenchFrame) * frameCount, 0, nullptr);
+    u8* at = data + sizeof(RenderFrameFileHeader);
+    u8* end = data + fileSize;
+    u64 commandCount = 0;
+    for (u32 i = 0; i < frameCount; i++) {
+        if (at + sizeof(RenderFrameHeader) > end) {
+            log_print("[RenderBench] %s is truncated\n", filename);
+            return 1;
+        }
+        RenderFrameHeader* frameHeader = (RenderFrameHeader*)at;
+        at += sizeof(RenderFrameHeader);
+        u32 size = Max(Max(frameHeader->rectCount, frameHeader->lineCount), Max(frameHeader->shapeCount, 1u));
+        if (at + sizeof(RenderCommand) * ((uptr)frameHeader->rectCount + frameHeader->lineCount + frameHeader->shapeCount) > end) {
+            log_print("[RenderBench] %s is truncated\n", filename);
+            return 1;
+        }
+
+        RenderBenchFrame* frame = frames + i;
+        frame->canvas = frameHeader->canvas;
+        RenderQueue* queue = &frame->queue;
+        RenderQueueInit(queue, size);
+        queue->rectBufferAt = frameHeader->rectCount;
+        queue->lineBufferAt = frameHeader->lineCount;
+        queue->shapeBufferAt = frameHeader->shapeCount;
+        memcpy(queue->rectBuffer, at, sizeof(RenderCommand) * queue->rectBufferAt);
+        at += sizeof(RenderCommand) * queue->rectBufferAt;
+        memcpy(queue->lineBuffer, at, sizeof(RenderCommand) * queue->lineBufferAt);
+        at += sizeof(RenderCommand) * queue->lineBufferAt;
+        memcpy(queue->shapeBuffer, at, sizeof(RenderCommand) * queue->shapeBufferAt);
+        at += sizeof(RenderCommand) * queue->shapeBufferAt;
+        commandCount += queue->rectBufferAt + queue->lineBufferAt + queue->shapeBufferAt;
+    }
+
+    auto context = &GlobalContext;
+    context->state.windowWidth = header->windowWidth;
+    context->state.windowHeight = header->windowHeight;
+
+    static RenderBench bench;
+    const char* phaseNames[(u32)RenderBenchPhaseId::Count] = { "begin frame", "cull", "upload and draw", "end frame", "bin", "raster", "cpu total", "gpu" };
+    for (u32 i = 0; i < (u32)RenderBenchPhaseId::Count; i++) {
+        bench.phases[i].name = phaseNames[i];
+        bench.phases[i].min = DBL_MAX;
+    }
+
+    log_print("[RenderBench] %u frames from %s, %.1f commands per frame, %u iterations, %ux%u%s\n", frameCount, filename,
+              (f64)commandCount / frameCount, iterations, header->windowWidth, header->windowHeight, software ? ", software" : "");
+
+    // NOTE(swarzzy): The first iteration warms up the driver, caches and instance buffers, so it is not measured
+    u32 warmupFrames = frameCount;
+    u32 totalFrames = frameCount * (iterations + 1);
+
+    if (software) {
+        context->state.threadCount = SDLInitWorkQueue(&context->sdl);
+        _GlobalPlatformState = &context->state;
+
+        static SoftwareRenderer renderer;
+        SoftwareRendererInit(&renderer, header->windowWidth, header->windowHeight);
+        for (u32 frameIndex = 0; frameIndex < totalFrames; frameIndex++) {
+            RenderBenchFrame* frame = frames + frameIndex % frameCount;
+            f64 t0 = GetTimeStamp();
+            SoftwareRendererBin(&renderer, &frame->canvas, &frame->queue);
+            f64 t1 = GetTimeStamp();
+            SoftwareRendererRaster(&renderer);
+            f64 t2 = GetTimeStamp();
+
+            if (frameIndex >= warmupFrames) {
+                RenderBenchRecord(&bench, RenderBenchPhaseId::Bin, t1 - t0);
+                RenderBenchRecord(&bench, RenderBenchPhaseId::Raster, t2 - t1);
+                RenderBenchRecord(&bench, RenderBenchPhaseId::Cpu, t2 - t0);
+                bench.framesMeasured++;
+                bench.primitives += renderer.stats.primitives;
+                bench.tileRejects += renderer.stats.tileRejects;
+            }
+        }
+
+        u32 count = Max(bench.framesMeasured, 1u);
+        log_print("[RenderBench] %u frames measured, %.1f primitives and %.1f tile rejects per frame, %u sprites skipped in the last frame\n",
+                  bench.framesMeasured, (f64)bench.primitives / count, (f64)bench.tileRejects / count, renderer.stats.spritesSkipped);
+        RenderBenchReport(&bench);
+        if (RenderBenchWriteImage(&renderer, RenderBench::SoftwareImageFilename)) {
+            log_print("[RenderBench] Last frame is written to %s\n", RenderBench::SoftwareImageFilename);
+        }
+        b32 matches = !golden || RenderBenchCompareImage(&renderer, golden);
+        SoftwareRendererFree(&renderer);
+        SDL_Quit();
+        return matches ? 0 : 1;
+    }
+
+    SDLInit(&context->sdl, &context->state, OPENGL_MAJOR_VERSION, OPENGL_MINOR_VERSION);
+    if (!context->sdl.glContext) {
+        panic("OpenGL context is required. Use -software to run without it");
+    }
+    OpenGLLoadResult glResult = SDLLoadOpenGL();
+    if (!glResult.success) {
+        panic("Failed to load OpenGL functions");
+    }
+    context->state.gl = glResult.context;
+    context->state.glStats = GLStatsInitFromEnvironment(context->state.gl);
+    context->state.threadCount = SDLInitWorkQueue(&context->sdl);
+    SDLInitGLWorker(&context->sdl);
+    // NOTE(swarzzy): Frames should not wait for v-sync
+    SDL_GL_SetSwapInterval(0);
+
+    _GlobalPlatformState = &context->state;
+
+    static Renderer renderer;
+    RendererInit(&renderer);
+    RendererSetBackend(&renderer, backend);
+
+    glGenQueries(RenderBench::QueryCount, bench.queries);
+
+    u32 framesDone = 0;
+    for (u32 frameIndex = 0; frameIndex < totalFrames && context->sdl.running; frameIndex++) {
+        RenderBenchFrame* frame = frames + frameIndex % frameCount;
+        renderer.canvas = frame->canvas;
+
+        if (frameIndex >= RenderBench::QueryCount) {
+            RenderBenchReadQuery(&bench, frameIndex - RenderBench::QueryCount, warmupFrames);
+        }
+        glBeginQuery(GL_TIME_ELAPSED, bench.queries[frameIndex % RenderBench::QueryCount]);
+
+        // NOTE(swarzzy): Same steps as RendererDraw, timed separately
+        f64 t0 = GetTimeStamp();
+        RendererBeginFrame(&renderer);
+        f64 t1 = GetTimeStamp();
+        RendererCullQueue(&renderer, &frame->queue);
+        f64 t2 = GetTimeStamp();
+        RendererFlushInstances(&renderer);
+        f64 t3 = GetTimeStamp();
+        RendererEndFrame(&renderer);
+        f64 t4 = GetTimeStamp();
+
+        glEndQuery(GL_TIME_ELAPSED);
+        SDLSwapBuffers(&context->sdl);
+        SDLPollEvents(&context->sdl, &context->state);
+        framesDone++;
+
+        if (frameIndex >= warmupFrames) {
+            RenderBenchRecord(&bench, RenderBenchPhaseId::Begin, t1 - t0);
+            RenderBenchRecord(&bench, RenderBenchPhaseId::Cull, t2 - t1);
+            RenderBenchRecord(&bench, RenderBenchPhaseId::Flush, t3 - t2);
+            RenderBenchRecord(&bench, RenderBenchPhaseId::End, t4 - t3);
+            RenderBenchRecord(&bench, RenderBenchPhaseId::Cpu, t4 - t0);
+            bench.framesMeasured++;
+            bench.drawCalls += renderer.stats.drawCalls;
+            bench.bytesUploaded += renderer.stats.bytesUploaded;
+        }
+    }
+
+    for (u32 frameIndex = framesDone > RenderBench::QueryCount ? framesDone - RenderBench::QueryCount : 0; frameIndex < framesDone; frameIndex++) {
+        RenderBenchReadQuery(&bench, frameIndex, warmupFrames);
+    }
+
+    if (bench.framesMeasured) {
+        u32 count = bench.framesMeasured;
+        log_print("[RenderBench] %u frames measured, %.1f draw calls and %.1f KB uploaded per frame\n", count,
+                  (f64)bench.drawCalls / count, (f64)bench.bytesUploaded / count / 1024.0);
+        RenderBenchReport(&bench);
+    } else {
+        log_print("[RenderBench] Window was closed before any frames were measured\n");
+    }
+
+    glDeleteQueries(RenderBench::QueryCount, bench.queries);
+    GLStatsEnd();
+    SDL_Quit();
+    return 0;
+}